@@ -29,6 +29,7 @@
 #include "StRhoParameter.h"
 #include "StRho.h"
 #include "StJetMakerTask.h"
+#include "StPicoEventHeaderMaker.h"
 #include "StFemtoTrack.h"
 
 // new includes
@@ -45,6 +46,10 @@
 // old file kept
 #include "StPicoConstants.h"
 
+// BEMC tower geometry
+#include "StEmcPositionCache.h"
+#include "StCorrectedTowerTable.h"
+
 // centrality includes
 #include "StRoot/StRefMultCorr/StRefMultCorr.h"
 #include "StRoot/StRefMultCorr/CentralityMaker.h"
@@ -98,6 +103,8 @@ StAnMaker::StAnMaker(const char* name, StPicoDstMaker *picoMaker, const char* ou
   fJetMakerName = jetMakerName;
   fRhoMakerName = rhoMakerName;
   for(int i=0; i<8; i++) { fEmcTriggerArr[i] = 0; }
+  mHadronicCorrFrac = 1.0;
+  fTowerTable = 0x0;
 
 }
 
@@ -105,6 +112,7 @@ StAnMaker::StAnMaker(const char* name, StPicoDstMaker *picoMaker, const char* ou
 StAnMaker::~StAnMaker()
 { /*  */
   // destructor
+  if(fTowerTable) delete fTowerTable;
 }
 
 //-----------------------------------------------------------------------------
@@ -222,6 +230,11 @@ Int_t StAnMaker::Make() {
     return kStWarn;
   }
 
+  // shared event header (if set): event rejected for the whole chain,
+  // 80-100% centrality events go on to the cent16 cut below (kStWarn)
+  if(!InitEventHeader()) return kStWarn;
+  if(fEventHeader && (fEventHeader->GetRejection() & ~StPicoEventHeaderMaker::kRejectCentrality)) return kStOk;
+
   // get event B (magnetic) field
   Bfield = mPicoEvent->bField(); 
 
@@ -231,38 +244,33 @@ Int_t StAnMaker::Make() {
   
   // Z-vertex cut 
   // the Aj analysis cut on (-40, 40) for reference
-  if((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut)) return kStOk; //kStWarn;
+  // (done once per event by the shared event header when set)
+  if(!fEventHeader && ((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut))) return kStOk; //kStWarn;
 
   // get the Run #, fill, and event ID
   Int_t RunId = mPicoEvent->runId();
   fRunNumber = mPicoEvent->runId();
   Int_t fillId = mPicoEvent->fillId();
   Int_t eventId = mPicoEvent->eventId();
-  Double_t fBBCCoincidenceRate = mPicoEvent->BBCx();
-  Double_t fZDCCoincidenceRate = mPicoEvent->ZDCx();
+  //Double_t fBBCCoincidenceRate = mPicoEvent->BBCx();
+  //Double_t fZDCCoincidenceRate = mPicoEvent->ZDCx();
 
   // ============================ CENTRALITY ============================== //
   // for only 14.5 GeV collisions from 2014 and earlier runs: refMult, for AuAu run14 200 GeV: grefMult 
   // https://github.com/star-bnl/star-phys/blob/master/StRefMultCorr/Centrality_def_refmult.txt
   // https://github.com/star-bnl/star-phys/blob/master/StRefMultCorr/Centrality_def_grefmult.txt
-  int grefMult = mPicoEvent->grefMult();
-  int refMult = mPicoEvent->refMult();
-  grefmultCorr->init(RunId);
-  grefmultCorr->initEvent(grefMult, zVtx, fBBCCoincidenceRate);
+  // centrality correction done once per event by the shared event header when set
 //  if(grefmultCorr->isBadRun(RunId)) cout << "Run is bad" << endl; 
-//  if(grefmultCorr->isIndexOk()) cout << "Index Ok" << endl;
-//  if(grefmultCorr->isZvertexOk()) cout << "Zvertex Ok" << endl;
-//  if(grefmultCorr->isRefMultOk()) cout << "RefMult Ok" << endl;
   // 10 14 21 29 40 54 71 92 116 145 179 218 263 315 373 441  // RUN 14 AuAu binning
-  Int_t cent16 = grefmultCorr->getCentralityBin16();
-  Int_t cent9 = grefmultCorr->getCentralityBin9();
+  Int_t cent16, cent9;
+  Double_t refCorr2, eventWeight;
+  GetEventCentrality(zVtx, cent16, cent9, refCorr2, eventWeight);
   if(cent16 == -1) return kStWarn; // maybe kStOk; - this is for lowest multiplicity events 80%+ centrality, cut on them
 
   // centrality / multiplicity
   ref9 = GetCentBin(cent9, 9);
   ref16 = GetCentBin(cent16, 16);  
   Int_t centbin = GetCentBin(cent16, 16);
-  Double_t refCorr2 = grefmultCorr->getRefMultCorr(grefMult, zVtx, fBBCCoincidenceRate, 2);
   fCentralityScaled = centbin*5.0;
 
   // cut on centrality for analysis before doing anything
@@ -305,7 +313,7 @@ Int_t StAnMaker::Make() {
 
   // ============== RhoMaker =============== //
   // get RhoMaker from event: old names "StRho_JetsBG"
-  RhoMaker = static_cast<StRho*>(GetMaker(fRhoMakerName));
+  RhoMaker = static_cast<StRhoBase*>(GetMaker(fRhoMakerName));
   const char *fRhoMakerNameCh = fRhoMakerName;
   if(!RhoMaker) {
     LOG_WARN << Form(" No %s! Skip! ", fRhoMakerNameCh) << endm;
@@ -462,60 +470,89 @@ void StAnMaker::RunTracks()
 }  // track function
 
 //
+// local corrected tower table: only used when the jet maker has no tower table (charged jets)
 //________________________________________________________________________
-void StAnMaker::RunTowers()
+void StAnMaker::FillTowerTable()
 {
   // assume neutral pion mass
-  double pi = 1.0*TMath::Pi();
   double pi0mass = Pico::mMass[0]; // GeV
+  StEmcPositionCache *mPosition = StEmcPositionCache::Instance();
 
-  // looping over clusters - STAR: matching already done
-  // get # of clusters and set variables
-  unsigned int nBEmcPidTraits = mPicoDst->numberOfBEmcPidTraits();
-  StEmcPosition *mPosition = new StEmcPosition();
+  // start new event
+  if(!fTowerTable) fTowerTable = new StCorrectedTowerTable();
+  fTowerTable->Reset();
+
+  // fired towers
+  int nTowers = mPicoDst->numberOfBTOWHits();
+  for(int itow = 0; itow < nTowers; itow++) {
+    StPicoBTowHit *tower = static_cast<StPicoBTowHit*>(mPicoDst->btowHit(itow));
+    if(!tower) { cout<<"No tower pointer... iTow = "<<itow<<endl; continue; }
+
+    // tower ID
+    int towerID = tower->id();
+    if(towerID < 0) continue; // double check these aren't still in the event list
+
+    // tower was not fired
+    double towerE = tower->energy();
+    if(towerE <= 0) continue;
+
+    // tower position - from vertex and ID
+    double towerEta, towerPhi, towerCoshEta;
+    if(!mPosition->GetEtaPhiFromVertex(mVertex, towerID, towerEta, towerPhi, towerCoshEta)) continue;
+    fTowerTable->AddTower(itow, towerID, towerE, towerEta, towerPhi, towerCoshEta);
+  }
 
-  // loop over ALL clusters in PicoDst and add to jet //TODO
+  // loop over ALL clusters in PicoDst - STAR: matching already done
+  unsigned int nBEmcPidTraits = mPicoDst->numberOfBEmcPidTraits();
   for(unsigned short iClus = 0; iClus < nBEmcPidTraits; iClus++){
     StPicoBEmcPidTraits* cluster = static_cast<StPicoBEmcPidTraits*>(mPicoDst->bemcPidTraits(iClus));
     if(!cluster){ cout<<"Cluster pointer does not exist.. iClus = "<<iClus<<endl; continue; }
 
-    // cluster and tower ID
-    int clusID = cluster->bemcId();  // index in bemc point array
-    int towID = cluster->btowId();   // projected tower Id: 1 - 4800
-    int towID2 = cluster->btowId2(); // emc 2nd and 3rd closest tower local id  ( 2nd X 10 + 3rd), each id 0-8
-    int towID3 = cluster->btowId3(); // emc 2nd and 3rd closest tower local id  ( 2nd X 10 + 3rd), each id 0-8
+    // projected tower Id: 1 - 4800
+    int towID = cluster->btowId();
     if(towID < 0) continue;
 
-    // cluster and tower position - from vertex and ID
-    StThreeVectorF  towPosition;
-    towPosition = mPosition->getPosFromVertex(mVertex, towID);
-    double towPhi = towPosition.phi();
-    double towEta = towPosition.pseudoRapidity();
-
     // matched track index
     int trackIndex = cluster->trackIndex();
     StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(trackIndex));
     if(!trk) { cout<<"No trk pointer...."<<endl; continue; }
     if(!AcceptTrack(trk, Bfield, mVertex)) { continue; }
 
+    // track energy
+    StThreeVectorF mTrkMom = (doUsePrimTracks) ? trk->pMom() : trk->gMom(mVertex, Bfield);
+    double p = mTrkMom.mag();
+    double E = 1.0*TMath::Sqrt(p*p + pi0mass*pi0mass);
+    fTowerTable->AddMatchedTrack(towID, trackIndex, E);
   } // BEmc loop
 
-  // loop over towers
-  int nTowers = mPicoDst->numberOfBTOWHits();
-  for(int itow = 0; itow < nTowers; itow++) {
-    StPicoBTowHit *tower = static_cast<StPicoBTowHit*>(mPicoDst->btowHit(itow));
-    if(!tower) { cout<<"No tower pointer... iTow = "<<itow<<endl; continue; }
+  // apply hadronic correction to towers
+  fTowerTable->ApplyHadronicCorrection(mHadronicCorrFrac);
+}
 
-    // tower ID
-    int towerID = tower->id();
-    if(towerID < 0) continue; // double check these aren't still in the event list
+//
+//________________________________________________________________________
+void StAnMaker::RunTowers()
+{
+  // corrected tower table of the jet maker: track matching and hadronic correction done once per event there
+  const StCorrectedTowerTable *table = JetMaker->GetTowerTable();
+  if(!table) {
+    FillTowerTable();
+    table = fTowerTable;
+  }
 
-    // cluster and tower position - from vertex and ID: shouldn't need additional eta correction
-    StThreeVectorF towerPosition = mPosition->getPosFromVertex(mVertex, towerID);
-    double towerPhi = towerPosition.phi();
-    double towerEta = towerPosition.pseudoRapidity();
-    int towerADC = tower->adc();
-    double towerE = tower->energy();
+  // loop over fired towers
+  for(int row = 0; row < table->GetNumberOfTowers(); row++) {
+    // bad and dead towers
+    if(table->TestStatusBit(row, StCorrectedTowerTable::kBad) || table->TestStatusBit(row, StCorrectedTowerTable::kDead)) continue;
+
+    // tower variables: position from vertex and ID, energy with hadronic correction
+    int towerID = table->GetTowerID(row);
+    double towerPhi = table->GetPhi(row);
+    double towerEta = table->GetEta(row);
+    double towerEunCorr = table->GetRawE(row);
+    double towerE = table->GetE(row);
+    double towerEt = table->GetEt(row);
+    int nMatchedTracks = table->GetNumberOfMatchedTracks(row);
 
   } // tower loop
 
@@ -602,49 +639,3 @@ void StAnMaker::FillEmcTriggers() {
     if(emcTrig->isJP2()) { fEmcTriggerArr[StJetFrameworkPicoBase::kIsJP2] = 1; }
   }
 }
-
-//_____________________________________________________________________________
-// this function is not used in this class, but kept to keep track of the USEFUL triggers from various Runs 
-void StAnMaker::FillEventTriggerQA() {
-  // Run14 AuAu 200 GeV
-  if(fRunFlag == StJetFrameworkPicoBase::Run14_AuAu200) {
-    int arrBHT1[] = {450201, 450211, 460201};
-    int arrBHT2[] = {450202, 450212, 460202, 460212};
-    int arrBHT3[] = {460203, 450213, 460203};
-    int arrMB[] = {450014};
-    int arrMB30[] = {450010, 450020};
-    int arrCentral5[] = {450010, 450020};
-    int arrCentral[] = {460101, 460111};
-    int arrMB5[] = {450005, 450008, 450009, 450014, 450015, 450018, 450024, 450025, 450050, 450060};
-  }
-
-  // Run16 AuAu
-  if(fRunFlag == StJetFrameworkPicoBase::Run16_AuAu200) {
-    // hard-coded trigger Ids for run16
-    int arrBHT0[] = {520606, 520616, 520626, 520636, 520646, 520656};
-    int arrBHT1[] = {520201, 520211, 520221, 520231, 520241, 520251, 520261, 520605, 520615, 520625, 520635, 520645, 520655, 550201, 560201, 560202, 530201, 540201};
-    int arrBHT2[] = {530202, 540203};
-    int arrBHT3[] = {520203, 530213};
-    int arrMB[] = {520021};
-    int arrMB5[] = {520001, 520002, 520003, 520011, 520012, 520013, 520021, 520022, 520023, 520031, 520033, 520041, 520042, 520043, 520051, 520822, 520832, 520842, 570702};
-    int arrMB10[] = {520007, 520017, 520027, 520037, 520201, 520211, 520221, 520231, 520241, 520251, 520261, 520601, 520611, 520621, 520631, 520641};
-    int arrCentral[] = {520101, 520111, 520121, 520131, 520141, 520103, 520113, 520123};
-  }
-
-}
-
-// elems: sizeof(myarr)/sizeof(*myarr) prior to passing to function
-// upon passing the array collapses to a pointer and can not get size anymore
-//________________________________________________________________________
-Bool_t StAnMaker::DoComparison(int myarr[], int elems) {
-  //std::cout << "Length of array = " << (sizeof(myarr)/sizeof(*myarr)) << std::endl;
-  bool match = kFALSE;
-
-  // loop over specific physics selection array and compare to specific event trigger
-  for(int i=0; i<elems; i++) {
-    if(mPicoEvent->isTrigger(myarr[i])) match = kTRUE;
-    if(match) break;
-  }
-
-  return match;
-}
@@ -30,6 +30,7 @@ class StJetMakerTask;
 class StJet;
 class StRho;
 class StRhoParameter;
+class StCorrectedTowerTable;
 
 //class StAnMaker : public StMaker {
 class StAnMaker : public StJetFrameworkPicoBase {
@@ -80,6 +81,8 @@ class StAnMaker : public StJetFrameworkPicoBase {
     virtual void            SetTowerERange(Double_t enmi, Double_t enmx) { fTowerEMinCut = enmi; fTowerEMaxCut = enmx; }
     virtual void            SetTowerEtaRange(Double_t temi, Double_t temx) { fTowerEtaMinCut = temi; fTowerEtaMaxCut = temx; }
     virtual void            SetTowerPhiRange(Double_t tpmi, Double_t tpmx) { fTowerPhiMinCut = tpmi; fTowerPhiMaxCut = tpmx; }
+    // hadronic correction fraction of the local tower table (only used when the jet maker has no tower table)
+    virtual void            SetHadronicCorrFrac(Float_t frac)  { mHadronicCorrFrac = frac; }
 
     // event selection - setters
     virtual void            SetEmcTriggerEventType(UInt_t te)    { fEmcTriggerEventType = te;  }
@@ -94,14 +97,13 @@ class StAnMaker : public StJetFrameworkPicoBase {
   protected:
     void                    RunTracks();
     void                    RunTowers();
+    void                    FillTowerTable();                                     // fill local corrected tower table
     void                    RunJets();
     Int_t                   GetCentBin(Int_t cent, Int_t nBin) const;             // centrality bin
     Double_t                RelativePhi(Double_t mphi, Double_t vphi) const;      // relative jet track angle
     Double_t                RelativeEPJET(Double_t jetAng, Double_t EPAng) const; // relative jet event plane angle
     void                    FillEmcTriggers();                          // EmcTrigger counter histo
-    void                    FillEventTriggerQA();                           // filled event trigger QA plots
     Bool_t                  AcceptJet(StJet *jet);           // jets accept cuts function
-    Bool_t                  DoComparison(int myarr[], int elems);
     void                    SetSumw2(); // set errors weights 
     //Double_t                EffCorrection(Double_t trkETA, Double_t trkPT, Int_t effswitch) const; // efficiency correction function
 
@@ -114,6 +116,10 @@ class StAnMaker : public StJetFrameworkPicoBase {
     UInt_t                  fMBEventType;                // Physics selection of event used for MB
     Int_t                   fEmcTriggerArr[8];           // EMCal triggers array: used to select signal and do QA
 
+    // towers
+    Float_t                 mHadronicCorrFrac;           // hadronic correction fraction of local tower table
+    StCorrectedTowerTable  *fTowerTable;                 //!local corrected tower table (jet maker without tower table)
+
   private:
     Int_t                   fRunNumber;
 
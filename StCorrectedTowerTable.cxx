@@ -0,0 +1,120 @@
+// ################################################################
+// Author:  Joel Mazer for the STAR Collaboration
+// Affiliation: Rutgers University
+//
+// per-event corrected BEMC tower table
+//      - one dense row per fired tower
+//      - corrected E, Et, eta, phi, status and matched track list
+//      - hadronic correction done once per event (last or summed matched tracks)
+//
+// ################################################################
+// $Id$
+
+#include "StCorrectedTowerTable.h"
+
+ClassImp(StCorrectedTowerTable)
+
+//________________________________________________________________________
+StCorrectedTowerTable::StCorrectedTowerTable() :
+  fNRows(0),
+  fMatchTrackIndex(),
+  fMatchTrackE(),
+  fMatchNext()
+{
+  // Constructor
+  for(Int_t i = 0; i < kNTowers; i++) fRowOfHit[i] = -1;
+  for(Int_t i = 0; i <= kNTowers; i++) fRowOfTower[i] = -1;
+
+  // reserve some space for central Au+Au events
+  fMatchTrackIndex.reserve(1000);
+  fMatchTrackE.reserve(1000);
+  fMatchNext.reserve(1000);
+}
+
+//________________________________________________________________________
+StCorrectedTowerTable::~StCorrectedTowerTable()
+{
+  // Destructor
+}
+
+//________________________________________________________________________
+void StCorrectedTowerTable::Reset()
+{
+  // only reset lookup entries of towers fired in previous event
+  for(Int_t row = 0; row < fNRows; row++) {
+    fRowOfTower[fTowerID[row]] = -1;
+    fRowOfHit[fHitIndex[row]] = -1;
+  }
+  fNRows = 0;
+
+  // keep capacity
+  fMatchTrackIndex.clear();
+  fMatchTrackE.clear();
+  fMatchNext.clear();
+}
+
+//________________________________________________________________________
+Int_t StCorrectedTowerTable::AddTower(Int_t hitIndex, Int_t towerID, Double_t rawE, Double_t eta, Double_t phi, Double_t coshEta)
+{
+  // add fired tower: returns row, -1 if not added
+  if((towerID < 1) || (towerID > kNTowers)) return -1;
+  if((hitIndex < 0) || (hitIndex >= kNTowers)) return -1;
+  if(fRowOfTower[towerID] >= 0) return fRowOfTower[towerID];
+
+  Int_t row = fNRows++;
+  fTowerID[row] = towerID;
+  fHitIndex[row] = hitIndex;
+  fRawE[row] = rawE;
+  fE[row] = rawE;
+  fEt[row] = (coshEta > 0) ? rawE / coshEta : 0.;
+  if(fEt[row] < 0) fEt[row] = 0.;
+  fEta[row] = eta;
+  fPhi[row] = phi;
+  fCoshEta[row] = coshEta;
+  fStatus[row] = 0;
+  fNMatched[row] = 0;
+  fMatchedSumE[row] = 0.;
+  fFirstMatch[row] = -1;
+
+  fRowOfTower[towerID] = row;
+  fRowOfHit[hitIndex] = row;
+
+  return row;
+}
+
+//________________________________________________________________________
+Bool_t StCorrectedTowerTable::AddMatchedTrack(Int_t towerID, Int_t trackIndex, Double_t trackE)
+{
+  // add accepted track matched to tower: kFALSE if tower was not fired
+  Int_t row = GetRowOfTower(towerID);
+  if(row < 0) return kFALSE;
+
+  // prepend to list of row: first match is the most recently added one
+  Int_t m = (Int_t)fMatchTrackIndex.size();
+  fMatchTrackIndex.push_back(trackIndex);
+  fMatchTrackE.push_back(trackE);
+  fMatchNext.push_back(fFirstMatch[row]);
+  fFirstMatch[row] = m;
+
+  fNMatched[row]++;
+  fMatchedSumE[row] += trackE;
+  fStatus[row] |= kMatched;
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void StCorrectedTowerTable::ApplyHadronicCorrection(Double_t frac, Bool_t sumMatchedTracks)
+{
+  // subtract (fraction of) matched track energy from tower energy:
+  // sum of all matched tracks, or only the last matched track (as done before by the jet maker)
+  for(Int_t row = 0; row < fNRows; row++) {
+    if(fNMatched[row] < 1) continue;
+
+    Double_t trackE = (sumMatchedTracks) ? fMatchedSumE[row] : fMatchTrackE[fFirstMatch[row]];
+    fE[row] = fRawE[row] - frac * trackE;
+    fEt[row] = (fCoshEta[row] > 0) ? fE[row] / fCoshEta[row] : 0.;
+    if(fEt[row] < 0) fEt[row] = 0.;
+    fStatus[row] |= kCorrected;
+  }
+}
@@ -0,0 +1,105 @@
+#ifndef STCORRECTEDTOWERTABLE_H
+#define STCORRECTEDTOWERTABLE_H
+
+// $Id$
+//
+// Per-event table of fired BEMC towers with hadronic correction applied.
+//
+// One dense row per fired tower: raw and corrected energy, corrected Et,
+// vertex corrected eta/phi, status bits and the list of matched tracks.
+// The hadronic correction is computed once when the table is built and
+// then read back by the jet builder (jet input and jet constituents),
+// the QA makers and the analysis makers.
+//
+// usage (once per event):
+//   table.Reset();
+//   table.AddTower(hitIndex, towerID, rawE, eta, phi, coshEta);           // all fired towers
+//   table.AddMatchedTrack(towerID, trackIndex, trackE);                  // accepted matched tracks
+//   table.ApplyHadronicCorrection(frac, sumMatchedTracks);
+//   for(Int_t i = 0; i < table.GetNumberOfTowers(); i++) table.GetEt(i) ...
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class StCorrectedTowerTable {
+ public:
+  // number of BEMC towers: ID's run from 1 - 4800
+  enum { kNTowers = 4800 };
+
+  // tower status bits
+  enum ETowerStatus {
+    kMatched   = 1<<0,   // at least one accepted track is matched to tower
+    kCorrected = 1<<1,   // hadronic correction was applied
+    kBad       = 1<<2,   // tower on bad tower list
+    kDead      = 1<<3,   // tower on dead tower list
+    kAccepted  = 1<<4    // tower passes cuts (set by user: e.g. used as jet input)
+  };
+
+  StCorrectedTowerTable();
+  virtual ~StCorrectedTowerTable();
+
+  // build table
+  void                   Reset();                      // start new event: only touched entries are reset
+  Int_t                  AddTower(Int_t hitIndex, Int_t towerID, Double_t rawE, Double_t eta, Double_t phi, Double_t coshEta);
+  Bool_t                 AddMatchedTrack(Int_t towerID, Int_t trackIndex, Double_t trackE);
+  void                   ApplyHadronicCorrection(Double_t frac, Bool_t sumMatchedTracks = kFALSE);
+  void                   SetStatusBit(Int_t row, UShort_t bit)  { fStatus[row] |= bit; }
+
+  // lookup: -1 if tower was not fired
+  Int_t                  GetNumberOfTowers() const     { return fNRows; }
+  Int_t                  GetRowOfTower(Int_t towerID) const { return ((towerID > 0) && (towerID <= kNTowers)) ? fRowOfTower[towerID] : -1; }
+  Int_t                  GetRowOfHit(Int_t hitIndex) const  { return ((hitIndex >= 0) && (hitIndex < kNTowers)) ? fRowOfHit[hitIndex] : -1; }
+
+  // per-tower access (index = row)
+  Int_t                  GetTowerID(Int_t row) const   { return fTowerID[row]; }
+  Int_t                  GetHitIndex(Int_t row) const  { return fHitIndex[row]; }
+  Float_t                GetRawE(Int_t row) const      { return fRawE[row]; }
+  Float_t                GetE(Int_t row) const         { return fE[row]; }         // hadronically corrected
+  Float_t                GetEt(Int_t row) const        { return fEt[row]; }        // corrected, >= 0
+  Float_t                GetEta(Int_t row) const       { return fEta[row]; }
+  Float_t                GetPhi(Int_t row) const       { return fPhi[row]; }       // (0, 2pi)
+  Float_t                GetCoshEta(Int_t row) const   { return fCoshEta[row]; }
+  UShort_t               GetStatus(Int_t row) const    { return fStatus[row]; }
+  Bool_t                 TestStatusBit(Int_t row, UShort_t bit) const { return (fStatus[row] & bit) != 0; }
+
+  // matched tracks of tower: for(Int_t m = GetFirstMatch(row); m >= 0; m = GetNextMatch(m))
+  Int_t                  GetNumberOfMatchedTracks(Int_t row) const { return fNMatched[row]; }
+  Float_t                GetMatchedTrackSumE(Int_t row) const      { return fMatchedSumE[row]; }
+  Int_t                  GetFirstMatch(Int_t row) const            { return fFirstMatch[row]; }
+  Int_t                  GetNextMatch(Int_t m) const               { return fMatchNext[m]; }
+  Int_t                  GetMatchTrackIndex(Int_t m) const         { return fMatchTrackIndex[m]; }
+  Float_t                GetMatchTrackE(Int_t m) const             { return fMatchTrackE[m]; }
+
+ protected:
+  // rows: fired towers
+  Int_t                  fNRows;                       // number of fired towers
+  Int_t                  fTowerID[kNTowers];           // tower ID
+  Int_t                  fHitIndex[kNTowers];          // index in PicoDst tower hit array
+  Float_t                fRawE[kNTowers];              // uncorrected energy
+  Float_t                fE[kNTowers];                 // corrected energy
+  Float_t                fEt[kNTowers];                // corrected transverse energy
+  Float_t                fEta[kNTowers];               // vertex corrected eta
+  Float_t                fPhi[kNTowers];               // vertex corrected phi (0, 2pi)
+  Float_t                fCoshEta[kNTowers];           // cosh(eta)
+  UShort_t               fStatus[kNTowers];            // status bits, see ETowerStatus
+  Short_t                fNMatched[kNTowers];          // number of matched tracks
+  Float_t                fMatchedSumE[kNTowers];       // summed energy of matched tracks
+  Int_t                  fFirstMatch[kNTowers];        // first (most recently added) matched track, -1 if none
+
+  // lookup tables: row of tower ID and of hit index (-1 = not fired)
+  Int_t                  fRowOfTower[kNTowers+1];      // index = towerID
+  Int_t                  fRowOfHit[kNTowers];          // index = hit index
+
+  // matched tracks: linked list per row
+  std::vector<Int_t>     fMatchTrackIndex;             // track index
+  std::vector<Float_t>   fMatchTrackE;                 // track energy (pion mass)
+  std::vector<Int_t>     fMatchNext;                   // next matched track of same row, -1 = end
+
+ private:
+  StCorrectedTowerTable(const StCorrectedTowerTable&);            // not implemented
+  StCorrectedTowerTable &operator=(const StCorrectedTowerTable&); // not implemented
+
+  ClassDef(StCorrectedTowerTable, 0) // per-event corrected BEMC tower table
+};
+#endif
@@ -0,0 +1,144 @@
+// ################################################################
+// Author:  Joel Mazer for the STAR Collaboration
+// Affiliation: Rutgers University
+//
+// BEMC tower geometry cache
+//      - tower (x,y,z) table built once per process from StEmcGeom
+//      - analytic vertex correction of tower eta/phi/cosh(eta)
+//      - replaces per-event 'new StEmcPosition()' + getPosFromVertex()
+//
+// ################################################################
+// $Id$
+
+#include "StEmcPositionCache.h"
+
+// root classes
+#include "TMath.h"
+
+// STAR classes
+#include "StEmcUtil/geometry/StEmcGeom.h"
+
+#include "StJetPicoDefinitions.h"
+
+StEmcPositionCache *StEmcPositionCache::fgInstance = 0x0;
+
+ClassImp(StEmcPositionCache)
+
+//________________________________________________________________________
+StEmcPositionCache::StEmcPositionCache()
+{
+  // Constructor: use StEmcPositionCache::Instance()
+  for(Int_t i = 0; i <= kNTowers; i++) {
+    fTowerX[i] = 0.; fTowerY[i] = 0.; fTowerZ[i] = 0.;
+  }
+
+  BuildTable();
+}
+
+//________________________________________________________________________
+StEmcPositionCache::~StEmcPositionCache()
+{
+  // Destructor
+}
+
+//________________________________________________________________________
+StEmcPositionCache* StEmcPositionCache::Instance()
+{
+  // get shared instance - build tower table on first call
+  // NOTE: call once from Init() before any threads are started
+  if(!fgInstance) fgInstance = new StEmcPositionCache();
+
+  return fgInstance;
+}
+
+//________________________________________________________________________
+void StEmcPositionCache::BuildTable()
+{
+  // fill tower position table from BEMC geometry
+  StEmcGeom *mGeom = StEmcGeom::instance("bemc");
+  if(!mGeom) {
+    __ERROR_FUNCTION("StEmcPositionCache: no BEMC geometry found!");
+    return;
+  }
+
+  for(Int_t towerID = 1; towerID <= kNTowers; towerID++) {
+    Float_t x = 0., y = 0., z = 0.;
+    mGeom->getXYZ(towerID, x, y, z);
+    fTowerX[towerID] = x;
+    fTowerY[towerID] = y;
+    fTowerZ[towerID] = z;
+  }
+}
+
+//________________________________________________________________________
+StThreeVectorF StEmcPositionCache::GetPosFromVertex(const StThreeVectorF& vertex, Int_t towerID) const
+{
+  // tower position with respect to vertex
+  if(!IsValidTowerID(towerID)) return StThreeVectorF(0., 0., 0.);
+
+  return StThreeVectorF(fTowerX[towerID] - vertex.x(), fTowerY[towerID] - vertex.y(), fTowerZ[towerID] - vertex.z());
+}
+
+//________________________________________________________________________
+Bool_t StEmcPositionCache::GetEtaPhiFromVertex(const StThreeVectorF& vertex, Int_t towerID,
+    Double_t &eta, Double_t &phi, Double_t &coshEta) const
+{
+  // vertex corrected tower eta, phi and cosh(eta)
+  eta = 0.; phi = 0.; coshEta = 1.;
+  if(!IsValidTowerID(towerID)) return kFALSE;
+
+  // position of tower with respect to vertex
+  Double_t dx = fTowerX[towerID] - vertex.x();
+  Double_t dy = fTowerY[towerID] - vertex.y();
+  Double_t dz = fTowerZ[towerID] - vertex.z();
+  Double_t rho = TMath::Sqrt(dx*dx + dy*dy);
+  if(rho < 1e-12) return kFALSE;
+
+  // eta = asinh(z/rho), cosh(eta) = r/rho
+  Double_t sinhEta = dz / rho;
+  coshEta = TMath::Sqrt(1.0 + sinhEta*sinhEta);
+  eta = TMath::Log(sinhEta + coshEta);
+
+  // phi: (0, 2pi)
+  phi = TMath::ATan2(dy, dx);
+  if(phi < 0.) phi += 2.0*TMath::Pi();
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Int_t StEmcPositionCache::GetEtaPhiFromVertex(const StThreeVectorF& vertex, Int_t n, const Int_t *towerID,
+    Float_t *eta, Float_t *phi, Float_t *coshEta) const
+{
+  // batch version of vertex corrected tower eta, phi and cosh(eta)
+  const Double_t twoPi = 2.0*TMath::Pi();
+  const Double_t vx = vertex.x();
+  const Double_t vy = vertex.y();
+  const Double_t vz = vertex.z();
+
+  Int_t nValid = 0;
+  for(Int_t i = 0; i < n; i++) {
+    Int_t id = towerID[i];
+    if(!IsValidTowerID(id)) {
+      eta[i] = 0.; phi[i] = 0.; coshEta[i] = 1.;
+      continue;
+    }
+
+    // position of tower with respect to vertex
+    Double_t dx = fTowerX[id] - vx;
+    Double_t dy = fTowerY[id] - vy;
+    Double_t dz = fTowerZ[id] - vz;
+    Double_t rho = TMath::Sqrt(dx*dx + dy*dy);
+    Double_t sinhEta = (rho > 1e-12) ? dz / rho : 0.;
+    Double_t ch = TMath::Sqrt(1.0 + sinhEta*sinhEta);
+    Double_t ph = TMath::ATan2(dy, dx);
+    if(ph < 0.) ph += twoPi;
+
+    eta[i] = TMath::Log(sinhEta + ch);
+    phi[i] = ph;
+    coshEta[i] = ch;
+    nValid++;
+  }
+
+  return nValid;
+}
@@ -0,0 +1,68 @@
+#ifndef STEMCPOSITIONCACHE_H
+#define STEMCPOSITIONCACHE_H
+
+// $Id$
+//
+// Process-wide BEMC tower geometry cache.
+//
+// The (x,y,z) position of all 4800 BEMC towers is read once from StEmcGeom
+// and kept in a flat table. Vertex corrected tower eta/phi are then obtained
+// analytically from the table, instead of creating a StEmcPosition object
+// and calling getPosFromVertex() for every tower in every event.
+//
+// usage:
+//   StEmcPositionCache *mPosition = StEmcPositionCache::Instance();
+//   StThreeVectorF pos = mPosition->GetPosFromVertex(mVertex, towerID);  // same as StEmcPosition
+//   mPosition->GetEtaPhiFromVertex(mVertex, nTow, towerIDs, eta, phi, coshEta); // batch
+
+#include "Rtypes.h"
+#include "StThreeVectorF.hh"
+
+class StEmcGeom;
+
+class StEmcPositionCache {
+ public:
+  // number of BEMC towers: ID's run from 1 - 4800
+  enum { kNTowers = 4800 };
+
+  // access to the single shared instance - table is built on first call
+  static StEmcPositionCache* Instance();
+
+  Bool_t                 IsValidTowerID(Int_t towerID) const { return ((towerID > 0) && (towerID <= kNTowers)); }
+
+  // tower position with respect to the detector origin
+  Float_t                GetTowerX(Int_t towerID) const      { return fTowerX[towerID]; }
+  Float_t                GetTowerY(Int_t towerID) const      { return fTowerY[towerID]; }
+  Float_t                GetTowerZ(Int_t towerID) const      { return fTowerZ[towerID]; }
+
+  // drop-in replacement of StEmcPosition::getPosFromVertex(): (0,0,0) for invalid ID
+  StThreeVectorF         GetPosFromVertex(const StThreeVectorF& vertex, Int_t towerID) const;
+
+  // vertex corrected eta, phi (0, 2pi) and cosh(eta) of a single tower
+  Bool_t                 GetEtaPhiFromVertex(const StThreeVectorF& vertex, Int_t towerID,
+                            Double_t &eta, Double_t &phi, Double_t &coshEta) const;
+
+  // vertex corrected eta, phi (0, 2pi) and cosh(eta) for a list of n towers:
+  // invalid tower ID's get eta = phi = 0, cosh(eta) = 1; returns number of valid towers
+  Int_t                  GetEtaPhiFromVertex(const StThreeVectorF& vertex, Int_t n, const Int_t *towerID,
+                            Float_t *eta, Float_t *phi, Float_t *coshEta) const;
+
+ protected:
+  StEmcPositionCache();
+  virtual ~StEmcPositionCache();
+
+  void                   BuildTable();                 // fill table from StEmcGeom
+
+  Float_t                fTowerX[kNTowers+1];          // tower x position (index = towerID)
+  Float_t                fTowerY[kNTowers+1];          // tower y position (index = towerID)
+  Float_t                fTowerZ[kNTowers+1];          // tower z position (index = towerID)
+
+  static StEmcPositionCache *fgInstance;               //!shared instance
+
+ private:
+  StEmcPositionCache(const StEmcPositionCache&);            // not implemented
+  StEmcPositionCache &operator=(const StEmcPositionCache&); // not implemented
+
+  ClassDef(StEmcPositionCache, 0) // BEMC tower geometry cache
+};
+#endif
@@ -41,6 +41,8 @@
 #include "StRhoParameter.h"
 #include "StRho.h"
 #include "StJetMakerTask.h"
+#include "StPicoEventHeaderMaker.h"
+#include "StPicoTriggerDecoder.h"
 #include "StPicoTrk.h"
 #include "StFemtoTrack.h"
 #include "StEPFlattener.h"
@@ -793,23 +795,32 @@ Int_t StEventPlaneMaker::Make() {
     return kStWarn;
   }
 
+  // shared event header (if set): event rejected for the whole chain,
+  // 80-100% centrality events go on to the cent16 cut below (kStWarn)
+  if(!InitEventHeader(fTriggerToUse, fMBEventType, fEmcTriggerEventType)) return kStWarn;
+  if(fEventHeader && (fEventHeader->GetRejection() & ~StPicoEventHeaderMaker::kRejectCentrality)) return kStOk;
+
   // get event B (magnetic) field
   Bfield = mPicoEvent->bField(); 
 
   // get vertex 3-vector and z-vertex component
   mVertex = mPicoEvent->primaryVertex();
   zVtx = mVertex.z();
+
+  // get shared track table (if set) and register track cuts
+  if(!InitTrackTable()) return kStWarn;
   
   // Z-vertex cut 
-  if((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut)) return kStOk;
+  // (done once per event by the shared event header when set)
+  if(!fEventHeader && ((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut))) return kStOk;
 
   // let me know the Run #, fill, and event ID
   Int_t RunId = mPicoEvent->runId();
   fRunNumber = mPicoEvent->runId();
   Int_t fillId = mPicoEvent->fillId();
   Int_t eventId = mPicoEvent->eventId();
-  Double_t fBBCCoincidenceRate = mPicoEvent->BBCx();
-  Double_t fZDCCoincidenceRate = mPicoEvent->ZDCx();
+  //Double_t fBBCCoincidenceRate = mPicoEvent->BBCx();
+  //Double_t fZDCCoincidenceRate = mPicoEvent->ZDCx();
   if(fDebugLevel == kDebugGeneralEvt) cout<<"RunID = "<<RunId<<"  fillID = "<<fillId<<"  eventID = "<<eventId<<endl; // what is eventID?
 
   // ================= Event Plane flattening container ==============
@@ -826,19 +837,14 @@ Int_t StEventPlaneMaker::Make() {
   // for only 14.5 GeV collisions from 2014 and earlier runs: refMult, for AuAu run14 200 GeV: grefMult 
   // https://github.com/star-bnl/star-phys/blob/master/StRefMultCorr/Centrality_def_refmult.txt
   // https://github.com/star-bnl/star-phys/blob/master/StRefMultCorr/Centrality_def_grefmult.txt
-  int grefMult = mPicoEvent->grefMult();
-  //int refMult = mPicoEvent->refMult();
-  grefmultCorr->init(RunId);
-  if(doUseBBCCoincidenceRate) { grefmultCorr->initEvent(grefMult, zVtx, fBBCCoincidenceRate); } // default
-  else{ grefmultCorr->initEvent(grefMult, zVtx, fZDCCoincidenceRate); } 
-
+  // centrality correction done once per event by the shared event header when set
   // 10 14 21 29 40 54 71 92 116 145 179 218 263 315 373 441  // RUN 14 AuAu binning
-  Int_t cent16 = grefmultCorr->getCentralityBin16();
-  Int_t cent9 = grefmultCorr->getCentralityBin9();
+  Int_t cent16, cent9;
+  Double_t refCorr2, eventWeight;
+  GetEventCentrality(zVtx, cent16, cent9, refCorr2, eventWeight);
   ref9 = GetCentBin(cent9, 9);
   ref16 = GetCentBin(cent16, 16);  
   Int_t centbin = GetCentBin(cent16, 16);
-  Double_t refCorr2 = grefmultCorr->getRefMultCorr(grefMult, zVtx, fBBCCoincidenceRate, 2);
 
   // centrality / multiplicity histograms
   if(fDebugLevel == kDebugCentrality) { if(centbin > 15) cout<<"centbin = "<<centbin<<"  mult = "<<refCorr2<<"  Centbin*5.0 = "<<centbin*5.0<<"  cent16 = "<<cent16<<endl; }
@@ -904,7 +910,7 @@ Int_t StEventPlaneMaker::Make() {
 
   // ============== RhoMaker =============== //
   // get RhoMaker from event: old names "StRho_JetsBG", "OutRho", "StMaker#0"
-  RhoMaker = static_cast<StRho*>(GetMaker(fRhoMakerName));
+  RhoMaker = static_cast<StRhoBase*>(GetMaker(fRhoMakerName));
   const char *fRhoMakerNameCh = fRhoMakerName;
   if(!RhoMaker) {
     LOG_WARN << Form(" No %s! Skip! ", fRhoMakerNameCh) << endm;
@@ -1051,88 +1057,11 @@ TH1* StEventPlaneMaker::FillEmcTriggersHist(TH1* h) {
 //_____________________________________________________________________________
 // Trigger QA histogram, label bins 
 TH1* StEventPlaneMaker::FillEventTriggerQA(TH1* h) {
-  // check and fill a Event Selection QA histogram for different trigger selections after cuts
-
-  // Run14 AuAu 200 GeV
-  if(fRunFlag == StJetFrameworkPicoBase::Run14_AuAu200) {
-    int arrHT1[] = {450201, 450211, 460201};
-    int arrHT2[] = {450202, 450212, 460202, 460212};
-    int arrHT3[] = {460203, 450213, 460203};
-    int arrMB[] = {450014};
-    int arrMB30[] = {450010, 450020};
-    int arrCentral5[] = {450010, 450020};
-    int arrCentral[] = {460101, 460111};
-    int arrMB5[] = {450005, 450008, 450009, 450014, 450015, 450018, 450024, 450025, 450050, 450060};
-
-    int bin = 0;
-    if(DoComparison(arrHT1, sizeof(arrHT1)/sizeof(*arrHT1))) { bin = 2; h->Fill(bin); } // HT1
-    if(DoComparison(arrHT2, sizeof(arrHT2)/sizeof(*arrHT2))) { bin = 3; h->Fill(bin); } // HT2
-    if(DoComparison(arrHT3, sizeof(arrHT3)/sizeof(*arrHT3))) { bin = 4; h->Fill(bin); } // HT3 
-    if(DoComparison(arrMB, sizeof(arrMB)/sizeof(*arrMB))) { bin = 5; h->Fill(bin); } // MB 
-    //if() { bin = 6; h->Fill(bin); } 
-    if(DoComparison(arrCentral5, sizeof(arrCentral5)/sizeof(*arrCentral5))) { bin = 7; h->Fill(bin); }// Central-5
-    if(DoComparison(arrCentral, sizeof(arrCentral)/sizeof(*arrCentral))) { bin = 8; h->Fill(bin); } // Central & Central-mon
-    if(DoComparison(arrMB5, sizeof(arrMB5)/sizeof(*arrMB5))) { bin = 10; h->Fill(bin); }// VPDMB-5 
-    if(DoComparison(arrMB30, sizeof(arrMB30)/sizeof(*arrMB30))) { bin = 11; h->Fill(bin); } // VPDMB-30
- 
-    // label bins of the analysis trigger selection summary
-    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
-    h->GetXaxis()->SetBinLabel(2, "BHT1*VPDMB-30");
-    h->GetXaxis()->SetBinLabel(3, "BHT2*VPDMB-30");
-    h->GetXaxis()->SetBinLabel(4, "BHT3");
-    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-nobsmd");
-    h->GetXaxis()->SetBinLabel(6, "");
-    h->GetXaxis()->SetBinLabel(7, "Central-5");
-    h->GetXaxis()->SetBinLabel(8, "Central or Central-mon");
-    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
-    h->GetXaxis()->SetBinLabel(11, "VPDMB-30");
-  }
+  // check and fill a Event Selection QA histogram for different trigger selections:
+  // trigger bits of the event, decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, fRunFlag);
+  StPicoTriggerDecoder::FillEventTriggerQA(h, mask, fRunFlag);
 
-  // Run16 AuAu
-  if(fRunFlag == StJetFrameworkPicoBase::Run16_AuAu200) {
-    int bin = 0;
-
-    // hard-coded trigger Ids for run16
-    //int arrHT0[] = {520606, 520616, 520626, 520636, 520646, 520656};
-    int arrHT1[] = {520201, 520211, 520221, 520231, 520241, 520251, 520261, 520605, 520615, 520625, 520635, 520645, 520655, 550201, 560201, 560202, 530201, 540201};
-    int arrHT2[] = {530202, 540203};
-    int arrHT3[] = {520203, 530213};
-    int arrMB[] = {520021};
-    int arrMB5[] = {520001, 520002, 520003, 520011, 520012, 520013, 520021, 520022, 520023, 520031, 520033, 520041, 520042, 520043, 520051, 520822, 520832, 520842, 570702};
-    int arrMB10[] = {520007, 520017, 520027, 520037, 520201, 520211, 520221, 520231, 520241, 520251, 520261, 520601, 520611, 520621, 520631, 520641};
-    int arrCentral[] = {520101, 520111, 520121, 520131, 520141, 520103, 520113, 520123};
-
-    // fill for kAny
-    bin = 1; h->Fill(bin);
-
-    // check if event triggers meet certain criteria and fill histos
-    if(DoComparison(arrHT1, sizeof(arrHT1)/sizeof(*arrHT1))) { bin = 2; h->Fill(bin); } // HT1
-    if(DoComparison(arrHT2, sizeof(arrHT2)/sizeof(*arrHT2))) { bin = 3; h->Fill(bin); } // HT2
-    if(DoComparison(arrHT3, sizeof(arrHT3)/sizeof(*arrHT3))) { bin = 4; h->Fill(bin); } // HT3
-    if(DoComparison(arrMB, sizeof(arrMB)/sizeof(*arrMB))) { bin = 5; h->Fill(bin); }  // MB
-    //if(mytriggers[i] == 999999) { bin = 6; h->Fill(bin); }
-    if(DoComparison(arrCentral, sizeof(arrCentral)/sizeof(*arrCentral))) { bin = 7; h->Fill(bin); }// Central-5 & Central-novtx
-    //if(mytriggers[i] == 999999) { bin = 8; h->Fill(bin); } 
-    if(DoComparison(arrMB5, sizeof(arrMB5)/sizeof(*arrMB5))) { bin = 10; h->Fill(bin); } // VPDMB-5 
-    if(DoComparison(arrMB10, sizeof(arrMB10)/sizeof(*arrMB10))) { bin = 11; h->Fill(bin); }// VPDMB-10
-
-    // label bins of the analysis trigger selection summary
-    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
-    h->GetXaxis()->SetBinLabel(2, "BHT1");
-    h->GetXaxis()->SetBinLabel(3, "BHT2");
-    h->GetXaxis()->SetBinLabel(4, "BHT3");
-    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-p-sst");
-    h->GetXaxis()->SetBinLabel(6, "");
-    h->GetXaxis()->SetBinLabel(7, "Central");
-    h->GetXaxis()->SetBinLabel(8, "");
-    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
-    h->GetXaxis()->SetBinLabel(11, "VPDMB-10");
-  }
-
-  // set x-axis labels vertically
-  h->LabelsOption("v");
-  //h->LabelsDeflate("X");
-  
   return h;
 }
 
@@ -1336,23 +1265,10 @@ void StEventPlaneMaker::GetEventPlane(Bool_t flattenEP, Int_t n, Int_t method, D
   int nTOT = 0, nA = 0, nB = 0;
   int nTrack = mPicoDst->numberOfTracks();
   for(int i=0; i<nTrack; i++) {
-    // get tracks
-    StPicoTrack* track = static_cast<StPicoTrack*>(mPicoDst->track(i));
-    if(!track) { continue; }
-
     // apply standard track cuts - (can apply more restrictive cuts below)
-    if(!(AcceptTrack(track, Bfield, mVertex))) { continue; }
-
-    // primary track switch
-    // get momentum vector of track - global or primary track
+    // get momentum vector of track - global or primary track (from track table when available)
     StThreeVectorF mTrkMom;
-    if(doUsePrimTracks) {
-      // get primary track vector
-      mTrkMom = track->pMom();
-    } else {
-      // get global track vector
-      mTrkMom = track->gMom(mVertex, Bfield);
-    }
+    if(!GetAcceptedTrack(i, mTrkMom)) { continue; }
 
     // track variables
     double pt = mTrkMom.perp();
@@ -2614,22 +2530,10 @@ void StEventPlaneMaker::QvectorCal(int ref9, int region_vz, int n, int ptbin) {
   // loop over tracks
   int Qtrack = mPicoDst->numberOfTracks();
   for(int i = 0; i < Qtrack; i++){
-    StPicoTrack* track = static_cast<StPicoTrack*>(mPicoDst->track(i));
-    if(!track) { continue; }
-
     // apply standard track cuts - (can apply more restrictive cuts below)
-    if(!(AcceptTrack(track, Bfield, mVertex))) { continue; }
-
-    // primary track switch
-    // get momentum vector of track - global or primary track
+    // get momentum vector of track - global or primary track (from track table when available)
     StThreeVectorF mTrkMom;
-    if(doUsePrimTracks) {
-      // get primary track vector
-      mTrkMom = track->pMom();
-    } else {
-      // get global track vector
-      mTrkMom = track->gMom(mVertex, Bfield);
-    }
+    if(!GetAcceptedTrack(i, mTrkMom)) { continue; }
 
     // track variables
     double pt = mTrkMom.perp();
@@ -1,15 +1,110 @@
 #include "StEventPoolManager.h"
+#include "StFemtoTrack.h"
+#include "TClonesArray.h"
 #include "TList.h"
+#include "TMath.h"
 #include "TRandom.h"
+#include <algorithm>
 #include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using std::cout;
 using std::endl;
+
+namespace {
+  // Pool snapshot file layout (native byte order), every section starts on
+  // a 64 byte boundary:
+  //   StPoolSnapshotHeader
+  //   Double_t  bin edges: mult, zvtx, psi, pt
+  //   StPoolSnapshotEntry per stored pool
+  //   Int_t     event table: offset, ntracks, event index (all stored events, per pool oldest first)
+  //   Float_t   pt, eta, phi (all stored tracks), Char_t charge
+  const UInt_t kSnapshotMagic   = 0x4c4f4f50; // "POOL"
+  const UInt_t kSnapshotVersion = 1;
+  const UInt_t kSnapshotAlign   = 64;
+
+  struct StPoolSnapshotHeader {
+    UInt_t   fMagic;           // kSnapshotMagic, also checks the byte order
+    UInt_t   fVersion;         // kSnapshotVersion
+    Int_t    fNMultBins;       // binning of the writing manager
+    Int_t    fNZvtxBins;
+    Int_t    fNPsiBins;
+    Int_t    fNPtBins;
+    Int_t    fNPools;          // stored pools
+    Int_t    fTargetTrackDepth;
+    Long64_t fNEvents;         // stored events
+    Long64_t fNTracks;         // stored tracks
+    Long64_t fEdgesOffset;     // section offsets in bytes
+    Long64_t fPoolsOffset;
+    Long64_t fEventsOffset;
+    Long64_t fPtOffset;
+    Long64_t fEtaOffset;
+    Long64_t fPhiOffset;
+    Long64_t fChargeOffset;
+    Long64_t fFileSize;
+  };
+
+  struct StPoolSnapshotEntry {
+    Int_t    fIndex;           // flat pool index (StEventPoolManager::GetBinIndex)
+    Int_t    fNEvents;         // events of this pool
+    Long64_t fFirstEvent;      // first entry in the event table
+    Long64_t fFirstTrack;      // first track, event offsets are relative to it
+  };
+
+  Long64_t SnapshotAlign(Long64_t pos) { return (pos + kSnapshotAlign - 1) / kSnapshotAlign * kSnapshotAlign; }
+
+  Bool_t SnapshotPad(FILE *f, Long64_t &pos)
+  {
+    // zero padding up to the next section boundary
+    static const char zero[kSnapshotAlign] = {0};
+    Long64_t n = SnapshotAlign(pos) - pos;
+    pos += n;
+    return (n == 0 || fwrite(zero, 1, n, f) == (size_t)n);
+  }
+
+  Bool_t SnapshotWrite(FILE *f, Long64_t &pos, const void *data, Long64_t size)
+  {
+    pos += size;
+    return (size == 0 || fwrite(data, 1, size, f) == (size_t)size);
+  }
+}
 ClassImp(StEventPool)
 
+// quantized storage: [min, max) of pt (0.5 MeV/c steps), eta, phi (wrapped)
+const Double_t StEventPool::fgQuantRange[6] = {0., 32.768, -2.048, 2.048, 0., 2.*TMath::Pi()};
+
+UShort_t StEventPool::QuantEncode(Float_t x, Int_t var)
+{
+  // 16 bit fixed point code of pt (var 0), eta (1) or phi (2), nearest
+  // step; pt and eta saturate at the range limits, phi is wrapped
+
+  const Double_t min = fgQuantRange[2*var], max = fgQuantRange[2*var+1];
+  Double_t y = x;
+  if (var == 2) y -= TMath::Floor((y - min)/(max - min))*(max - min);
+  Int_t q = (Int_t)TMath::Floor((y - min)*65536./(max - min) + 0.5);
+  if (var == 2) return (UShort_t)(q & 0xffff);
+  return (UShort_t)TMath::Max(0, TMath::Min(q, 65535));
+}
+
+StEventPool::~StEventPool()
+{
+  delete fRingEventView;
+}
+
 void StEventPool::PrintInfo() const
 {
   cout << Form("%20s: %d events", "Pool capacity", fMixDepth) << endl;
+  if (fUseRingBuffer)
+    cout << Form("%20s: %d events, %d tracks", "Ring buffer", fRingEventCapacity, fRingTrackCapacity) << endl;
+  if (fMapPt)
+    cout << Form("%20s: %d events, %d tracks (read-only)", "Pool snapshot", fRingNEvents, fRingNTracksTotal) << endl;
+  if (fQuantized || fRingMaxTracks > 0)
+    cout << Form("%20s: %s, limit %d tracks, %.1f kB", "Track storage", (fQuantized) ? "16 bit" : "float", fRingMaxTracks, GetMemoryUsage()/1024.) << endl;
   cout << Form("%20s: %d events, %d tracks", "Current size", 
 	       GetCurrentNEvents(), NTracksInPool()) << endl;
   cout << Form("%20s: %.1f to %.1f", "Sub-event mult.", fMultMin, fMultMax) << endl;
@@ -42,6 +137,9 @@ Int_t StEventPool::NTracksInPool() const
   // Number of tracks for this cent, zvtx bin; possibly includes many
   // events.
 
+  if (fUseRingBuffer)
+    return fRingNTracksTotal;
+
   Int_t ntrk=0;
   for (Int_t i=0; i<(Int_t)fEvents.size(); ++i) {
     ntrk += fNTracksInEvent.at(i);
@@ -88,6 +186,15 @@ Int_t StEventPool::GlobalEventIndex(Int_t j) const
 {
   // Index returned from passing local pool event index.
 
+  if (fUseRingBuffer) {
+    if (j < 0 || j >= fRingNEvents) {
+      cout << "ERROR in StEventPool::GlobalEventIndex(): "
+	   << " Invalid index " << j << endl;
+      return -99;
+    }
+    return fRingEventIndex[RingSlot(j)];
+  }
+
   if (j < 0 || j >= (Int_t)fEventIndex.size()) {
     cout << "ERROR in StEventPool::GlobalEventIndex(): "
 	 << " Invalid index " << j << endl;
@@ -101,12 +208,22 @@ Int_t StEventPool::UpdatePool(TObjArray *trk)
   // A rolling buffer (a double-ended queue) is updated by removing
   // the oldest event, and appending the newest.
   //
-  // the ownership of <trk> is delegated to this class
+  // the ownership of <trk> is delegated to this class, for both backends:
+  // the TObjArray backend keeps the array, the ring buffer copies the tracks
+  // and deletes it, a locked pool deletes it
 
   if(fLockFlag)
   {
     Form("Tried to fill a locked StEventPool.");
-    return fEvents.size();
+    delete trk;
+    return GetCurrentNEvents();
+  }
+
+  if (fUseRingBuffer) {
+    // copy to the ring buffer, the array is not kept
+    Int_t nEvents = RingFillFromArray(trk);
+    delete trk;
+    return nEvents;
   }
 
   static Int_t iEvent = -1; 
@@ -162,6 +279,422 @@ Int_t StEventPool::UpdatePool(TObjArray *trk)
   return fEvents.size();
 }
 
+Int_t StEventPool::UpdatePool(Int_t ntrk, const Float_t *pt, const Float_t *eta, const Float_t *phi, const Char_t *charge)
+{
+  // Ring buffer version of UpdatePool(TObjArray*): the <ntrk> tracks are
+  // copied into the contiguous track arrays, the oldest event is dropped
+  // with the same track depth rule.
+
+  if(fLockFlag)
+  {
+    Form("Tried to fill a locked StEventPool.");
+    return GetCurrentNEvents();
+  }
+
+  // unlocked snapshot: copy to own storage before the first change
+  if (fMapPt) DetachSnapshot(kTRUE);
+  fNUpdates++;
+
+  if (!fUseRingBuffer) {
+    if (!fEvents.empty()) {
+      cout << "ERROR in StEventPool::UpdatePool(): "
+           << " pool holds TObjArray events, call SetUseRingBuffer() before filling" << endl;
+      return fEvents.size();
+    }
+    fUseRingBuffer = kTRUE;
+  }
+
+  static Int_t iEvent = -1;
+  iEvent++;
+
+  Int_t mult = (ntrk > 0) ? ntrk : 0;
+  Int_t nTrk = fRingNTracksTotal;
+
+  if (!IsReady() && IsReady(nTrk + mult, fRingNEvents + 1))
+    fNTimes++;
+
+  // remove oldest event before appending this event
+  if (nTrk>fTargetTrackDepth && fRingNEvents > 0) {
+    Int_t nTrksFirstEvent = fRingNTracks[fRingHead];
+    Int_t diff = nTrk - nTrksFirstEvent + mult;
+    if (diff>fTargetTrackDepth)
+      RingRemoveFirstEvent();
+  }
+
+  // free event slot and contiguous space for the tracks
+  if (fRingEventCapacity > 0 && fRingNEvents >= fRingEventCapacity)
+    RingResize(fRingTrackCapacity, 2*fRingEventCapacity);
+  Int_t pos = RingFindSpace(mult);
+
+  if (mult > 0 && fQuantized) {
+    for (Int_t i=0; i<mult; i++) {
+      fRingQPt[pos + i]  = QuantEncode(pt[i],  0);
+      fRingQEta[pos + i] = QuantEncode(eta[i], 1);
+      fRingQPhi[pos + i] = QuantEncode(phi[i], 2);
+    }
+    std::copy(charge, charge + mult, fRingCharge.begin() + pos);
+  } else if (mult > 0) {
+    std::copy(pt,     pt     + mult, fRingPt.begin()     + pos);
+    std::copy(eta,    eta    + mult, fRingEta.begin()    + pos);
+    std::copy(phi,    phi    + mult, fRingPhi.begin()    + pos);
+    std::copy(charge, charge + mult, fRingCharge.begin() + pos);
+  }
+
+  Int_t slot = RingSlot(fRingNEvents);
+  fRingOffset[slot]     = pos;
+  fRingNTracks[slot]    = mult;
+  fRingEventIndex[slot] = iEvent;
+  fRingTail = pos + mult;
+  fRingNEvents++;
+  fRingNTracksTotal += mult;
+
+  if (fNTimes==1) {
+    fFirstFilled = kTRUE;
+    if (StEventPool::fDebug) {
+      cout << "\nPool " << MultBinIndex() << ", " << ZvtxBinIndex()
+           << " ready at event "<< iEvent;
+      PrintInfo();
+      cout << endl;
+    }
+    fNTimes++; // See this message exactly once/pool
+  } else {
+    fFirstFilled = kFALSE;
+  }
+
+  fWasUpdated = true;
+
+  if (StEventPool::fDebug) {
+    cout << " Event " << iEvent;
+    cout << " PoolDepth = " << GetCurrentNEvents();
+    cout << " NTracksInCurrentEvent = " << NTracksInCurrentEvent();
+  }
+
+  // memory budget of the manager, may limit this pool
+  if (fManager) fManager->PoolUpdated();
+
+  return fRingNEvents;
+}
+
+void StEventPool::SetUseRingBuffer(Bool_t b, Int_t trackCapacity)
+{
+  // Switch between TObjArray and ring buffer storage, the pool is cleared.
+  // <trackCapacity> is the number of track slots allocated at the first
+  // update, default (0) is twice the target track depth.
+
+  Clear();
+  fUseRingBuffer = b;
+  if (!b) fQuantized = kFALSE;
+  fRingTrackCapacity = (b) ? TMath::Max(trackCapacity, 0) : 0;
+  fRingEventCapacity = 0;
+  fRingPt.clear();    fRingEta.clear();     fRingPhi.clear();        fRingCharge.clear();
+  fRingQPt.clear();   fRingQEta.clear();    fRingQPhi.clear();
+  fRingOffset.clear(); fRingNTracks.clear(); fRingEventIndex.clear();
+}
+
+void StEventPool::SetQuantized(Bool_t b)
+{
+  // 16 bit fixed point storage of pt / eta / phi (see fgQuantRange), the
+  // pool is cleared and uses the ring buffer.
+
+  Int_t capacity = (fUseRingBuffer) ? fRingTrackCapacity : 0;
+  SetUseRingBuffer(kTRUE, capacity);
+  fQuantized = b;
+}
+
+void StEventPool::SetMaxTrackCapacity(Int_t n)
+{
+  // Track capacity limit of the memory budget (0: none). A larger buffer
+  // is shrunk, dropping the oldest events that do not fit.
+
+  fRingMaxTracks = TMath::Max(n, 0);
+  if (fRingMaxTracks == 0 || fMapPt || fRingTrackCapacity <= fRingMaxTracks) return;
+  if (fRingCharge.empty()) {
+    fRingTrackCapacity = fRingMaxTracks; // not allocated yet
+    return;
+  }
+
+  while (fRingNEvents > 1 && fRingNTracksTotal > fRingMaxTracks)
+    RingRemoveFirstEvent();
+  RingResize(fRingMaxTracks, fRingEventCapacity);
+}
+
+Long64_t StEventPool::GetMemoryUsage() const
+{
+  // Allocated bytes of the track storage (snapshot: not owned, not counted)
+
+  if (!fUseRingBuffer)
+    return NTracksInPool()*(Long64_t)sizeof(StFemtoTrack) + fEvents.size()*(Long64_t)sizeof(TObjArray);
+
+  Long64_t bytes = (fRingPt.capacity() + fRingEta.capacity() + fRingPhi.capacity())*sizeof(Float_t);
+  bytes += (fRingQPt.capacity() + fRingQEta.capacity() + fRingQPhi.capacity())*sizeof(UShort_t);
+  bytes += fRingCharge.capacity()*sizeof(Char_t);
+  bytes += (fRingOffset.capacity() + fRingNTracks.capacity() + fRingEventIndex.capacity())*sizeof(Int_t);
+  return bytes;
+}
+
+Int_t StEventPool::GetEventTracks(Int_t i, const Float_t *&pt, const Float_t *&eta, const Float_t *&phi, const Char_t *&charge) const
+{
+  // Contiguous track arrays of the i'th event (0 = oldest) of the ring
+  // buffer, returns the number of tracks.
+
+  pt = eta = phi = 0; charge = 0;
+  if (!fUseRingBuffer || i<0 || i>=fRingNEvents) {
+    cout << "StEventPool::GetEventTracks("
+	 << i << "): Invalid index" << endl;
+    return 0;
+  }
+
+  Int_t slot = RingSlot(i);
+  Int_t n = fRingNTracks[slot];
+  if (n == 0) return 0;
+
+  Int_t first = fRingOffset[slot];
+  if (fMapPt) {
+    pt     = fMapPt     + first;
+    eta    = fMapEta    + first;
+    phi    = fMapPhi    + first;
+    charge = fMapCharge + first;
+    return n;
+  }
+  if (fQuantized) {
+    // decoded copy, valid until the next call
+    fRingBufPt.resize(n); fRingBufEta.resize(n); fRingBufPhi.resize(n);
+    for (Int_t itrk=0; itrk<n; itrk++) {
+      fRingBufPt[itrk]  = QuantDecode(fRingQPt[first + itrk],  0);
+      fRingBufEta[itrk] = QuantDecode(fRingQEta[first + itrk], 1);
+      fRingBufPhi[itrk] = QuantDecode(fRingQPhi[first + itrk], 2);
+    }
+    pt     = &fRingBufPt[0];
+    eta    = &fRingBufEta[0];
+    phi    = &fRingBufPhi[0];
+    charge = &fRingCharge[first];
+    return n;
+  }
+  pt     = &fRingPt[first];
+  eta    = &fRingEta[first];
+  phi    = &fRingPhi[first];
+  charge = &fRingCharge[first];
+  return n;
+}
+
+Int_t StEventPool::GetEventTracks(Int_t i, const UShort_t *&pt, const UShort_t *&eta, const UShort_t *&phi, const Char_t *&charge) const
+{
+  // Quantized track arrays of the i'th event (0 = oldest), see
+  // QuantDecode(), returns the number of tracks.
+
+  pt = eta = phi = 0; charge = 0;
+  if (!IsQuantized() || i<0 || i>=fRingNEvents) {
+    cout << "StEventPool::GetEventTracks("
+	 << i << "): Invalid index or pool not quantized" << endl;
+    return 0;
+  }
+
+  Int_t slot = RingSlot(i);
+  Int_t n = fRingNTracks[slot];
+  if (n == 0) return 0;
+
+  Int_t first = fRingOffset[slot];
+  pt     = &fRingQPt[first];
+  eta    = &fRingQEta[first];
+  phi    = &fRingQPhi[first];
+  charge = &fRingCharge[first];
+  return n;
+}
+
+void StEventPool::AttachSnapshot(Int_t nEvents, const Int_t *offset, const Int_t *ntracks, const Int_t *eventIndex,
+                                 const Float_t *pt, const Float_t *eta, const Float_t *phi, const Char_t *charge)
+{
+  // Fill the pool with <nEvents> events of a snapshot (oldest first). The
+  // track arrays are not copied and have to stay valid until the pool is
+  // cleared or detached, only the event table is copied.
+
+  Clear();
+  fUseRingBuffer = kTRUE;
+  fRingPt.clear();    fRingEta.clear();     fRingPhi.clear();        fRingCharge.clear();
+  fRingQPt.clear();   fRingQEta.clear();    fRingQPhi.clear();
+  fRingOffset.assign(offset, offset + nEvents);
+  fRingNTracks.assign(ntracks, ntracks + nEvents);
+  fRingEventIndex.assign(eventIndex, eventIndex + nEvents);
+
+  Int_t ntrk = 0;
+  for (Int_t i=0; i<nEvents; i++)
+    ntrk = TMath::Max(ntrk, offset[i] + ntracks[i]);
+
+  fRingEventCapacity = nEvents;
+  fRingTrackCapacity = ntrk;
+  fRingNEvents = nEvents;
+  fRingTail = ntrk;
+  for (Int_t i=0; i<nEvents; i++)
+    fRingNTracksTotal += ntracks[i];
+
+  fMapPt = pt; fMapEta = eta; fMapPhi = phi; fMapCharge = charge;
+  fNTimes = (IsReady()) ? 2 : 0; // ready from the start, no 'first ready' signal
+}
+
+void StEventPool::DetachSnapshot(Bool_t copy)
+{
+  // Release the snapshot arrays: <copy> the events to the pool's own ring
+  // buffer storage, else the pool is cleared.
+
+  if (!fMapPt) return;
+  if (!copy) {
+    Clear();
+    return;
+  }
+
+  if (fQuantized) {
+    fRingQPt.resize(fRingTrackCapacity); fRingQEta.resize(fRingTrackCapacity); fRingQPhi.resize(fRingTrackCapacity);
+    for (Int_t i=0; i<fRingTrackCapacity; i++) {
+      fRingQPt[i]  = QuantEncode(fMapPt[i],  0);
+      fRingQEta[i] = QuantEncode(fMapEta[i], 1);
+      fRingQPhi[i] = QuantEncode(fMapPhi[i], 2);
+    }
+  } else {
+    fRingPt.assign(fMapPt, fMapPt + fRingTrackCapacity);
+    fRingEta.assign(fMapEta, fMapEta + fRingTrackCapacity);
+    fRingPhi.assign(fMapPhi, fMapPhi + fRingTrackCapacity);
+  }
+  fRingCharge.assign(fMapCharge, fMapCharge + fRingTrackCapacity);
+  fMapPt = fMapEta = fMapPhi = 0;
+  fMapCharge = 0;
+}
+
+Int_t StEventPool::RingFindSpace(Int_t ntrk)
+{
+  // First track slot of a contiguous free block of <ntrk> slots, the
+  // buffer is enlarged if the free space does not suffice. The live tracks
+  // are [head, tail) or, once wrapped, [head, end of last event before the
+  // wrap) + [0, tail).
+
+  if (fRingTrackCapacity == 0) {
+    fRingTrackCapacity = TMath::Max(2*fTargetTrackDepth, 1024);
+    if (fRingMaxTracks > 0) fRingTrackCapacity = TMath::Max(TMath::Min(fRingTrackCapacity, fRingMaxTracks), ntrk);
+  }
+  if ((Int_t)fRingCharge.size() < fRingTrackCapacity || fRingEventCapacity == 0)
+    RingResize(fRingTrackCapacity, TMath::Max(fRingEventCapacity, TMath::Max(fMixDepth, 16)));
+
+  while (kTRUE) {
+    if (fRingNEvents == 0) {
+      fRingTail = 0;
+      fRingWrapped = kFALSE;
+    }
+
+    Int_t head = (fRingNEvents > 0) ? fRingOffset[fRingHead] : 0;
+    if (!fRingWrapped) {
+      if (fRingTrackCapacity - fRingTail >= ntrk) return fRingTail;
+      if (fRingNEvents > 0 && head >= ntrk) {
+        fRingWrapped = kTRUE;
+        return 0;
+      }
+    } else if (head - fRingTail >= ntrk) return fRingTail;
+
+    // not enough space: enlarge and linearize, at the limit of the memory
+    // budget drop the oldest event instead
+    Int_t capacity = TMath::Max(2*fRingTrackCapacity, fRingNTracksTotal + 2*ntrk);
+    if (fRingMaxTracks > 0) {
+      capacity = TMath::Min(capacity, TMath::Max(fRingMaxTracks, ntrk));
+      if (fRingNEvents > 0 && (capacity <= fRingTrackCapacity || capacity - fRingNTracksTotal < ntrk)) {
+        RingRemoveFirstEvent();
+        continue;
+      }
+    }
+    RingResize(capacity, fRingEventCapacity);
+    return fRingTail;
+  }
+}
+
+void StEventPool::RingRemoveFirstEvent()
+{
+  // Drop the oldest event of the ring buffer, its track slots are reused.
+
+  if (fRingNEvents == 0) return;
+
+  Int_t oldOffset = fRingOffset[fRingHead];
+  fRingNTracksTotal -= fRingNTracks[fRingHead];
+  fRingHead = (fRingHead + 1) % fRingEventCapacity;
+  fRingNEvents--;
+
+  if (fRingNEvents == 0) {
+    fRingHead = 0;
+    fRingTail = 0;
+    fRingWrapped = kFALSE;
+  } else if (fRingOffset[fRingHead] < oldOffset) fRingWrapped = kFALSE;
+}
+
+void StEventPool::RingResize(Int_t trackCapacity, Int_t eventCapacity)
+{
+  // (Re)allocate the ring buffer and copy the live events in order to the
+  // front. Only called at the first update and when an event does not fit.
+
+  trackCapacity = TMath::Max(trackCapacity, fRingNTracksTotal);
+  eventCapacity = TMath::Max(eventCapacity, fRingNEvents);
+
+  const Int_t nFloat = (fQuantized) ? 0 : trackCapacity, nQuant = (fQuantized) ? trackCapacity : 0;
+  std::vector<Float_t>  pt(nFloat), eta(nFloat), phi(nFloat);
+  std::vector<UShort_t> qpt(nQuant), qeta(nQuant), qphi(nQuant);
+  std::vector<Char_t>   charge(trackCapacity);
+  std::vector<Int_t>   offset(eventCapacity), ntracks(eventCapacity), index(eventCapacity);
+
+  Int_t pos = 0;
+  for (Int_t i=0; i<fRingNEvents; i++) {
+    Int_t slot = RingSlot(i);
+    Int_t first = fRingOffset[slot];
+    Int_t n = fRingNTracks[slot];
+    if (fQuantized) {
+      std::copy(fRingQPt.begin()  + first, fRingQPt.begin()  + first + n, qpt.begin()  + pos);
+      std::copy(fRingQEta.begin() + first, fRingQEta.begin() + first + n, qeta.begin() + pos);
+      std::copy(fRingQPhi.begin() + first, fRingQPhi.begin() + first + n, qphi.begin() + pos);
+    } else {
+      std::copy(fRingPt.begin()   + first, fRingPt.begin()   + first + n, pt.begin()   + pos);
+      std::copy(fRingEta.begin()  + first, fRingEta.begin()  + first + n, eta.begin()  + pos);
+      std::copy(fRingPhi.begin()  + first, fRingPhi.begin()  + first + n, phi.begin()  + pos);
+    }
+    std::copy(fRingCharge.begin() + first, fRingCharge.begin() + first + n, charge.begin() + pos);
+    offset[i]  = pos;
+    ntracks[i] = n;
+    index[i]   = fRingEventIndex[slot];
+    pos += n;
+  }
+
+  fRingPt.swap(pt);
+  fRingEta.swap(eta);
+  fRingPhi.swap(phi);
+  fRingQPt.swap(qpt);
+  fRingQEta.swap(qeta);
+  fRingQPhi.swap(qphi);
+  fRingCharge.swap(charge);
+  fRingOffset.swap(offset);
+  fRingNTracks.swap(ntracks);
+  fRingEventIndex.swap(index);
+
+  fRingTrackCapacity = trackCapacity;
+  fRingEventCapacity = eventCapacity;
+  fRingHead = 0;
+  fRingTail = pos;
+  fRingWrapped = kFALSE;
+}
+
+Int_t StEventPool::RingFillFromArray(TObjArray *trk)
+{
+  // Copy an array of StFemtoTrack's to the ring buffer, the array is not
+  // modified.
+
+  Int_t n = (trk) ? trk->GetEntriesFast() : 0;
+  fRingBufPt.clear(); fRingBufEta.clear(); fRingBufPhi.clear(); fRingBufCharge.clear();
+  for (Int_t i=0; i<n; i++) {
+    StFemtoTrack *t = static_cast<StFemtoTrack*>(trk->At(i));
+    if (!t) continue;
+    fRingBufPt.push_back(t->Pt());
+    fRingBufEta.push_back(t->Eta());
+    fRingBufPhi.push_back(t->Phi());
+    fRingBufCharge.push_back((Char_t)t->Charge());
+  }
+
+  Int_t ntrk = fRingBufPt.size();
+  if (ntrk == 0) return UpdatePool(0, 0, 0, 0, 0);
+  return UpdatePool(ntrk, &fRingBufPt[0], &fRingBufEta[0], &fRingBufPhi[0], &fRingBufCharge[0]);
+}
+
 Long64_t StEventPool::Merge(TCollection* hlist)
 {
   if (!hlist)
@@ -175,8 +708,19 @@ Long64_t StEventPool::Merge(TCollection* hlist)
   while ( (tmpObj = static_cast<StEventPool*>(objIter())) )
   {
     // Update this pool (it won't get fuller than demanded)
-    for(Int_t i=0; i<(Int_t)tmpObj->fEvents.size(); i++)
-      UpdatePool(tmpObj->fEvents.at(i));
+    if (tmpObj->fUseRingBuffer) {
+      const Float_t *pt, *eta, *phi; const Char_t *charge;
+      for(Int_t i=0; i<tmpObj->fRingNEvents; i++) {
+        Int_t ntrk = tmpObj->GetEventTracks(i, pt, eta, phi, charge);
+        UpdatePool(ntrk, pt, eta, phi, charge);
+      }
+    } else if (fUseRingBuffer) {
+      for(Int_t i=0; i<(Int_t)tmpObj->fEvents.size(); i++)
+        RingFillFromArray(tmpObj->fEvents.at(i));
+    } else {
+      for(Int_t i=0; i<(Int_t)tmpObj->fEvents.size(); i++)
+        UpdatePool(tmpObj->fEvents.at(i));
+    }
   }
   fLockFlag = origLock;
   return hlist->GetEntries() + 1;
@@ -190,6 +734,14 @@ void StEventPool::Clear(Option_t *opt)
   fEvents.clear();
   fNTracksInEvent.clear();
   fEventIndex.clear();
+  // ring buffer: storage is kept for reuse
+  fRingHead = 0;
+  fRingNEvents = 0;
+  fRingTail = 0;
+  fRingNTracksTotal = 0;
+  fRingWrapped = 0;
+  fMapPt = fMapEta = fMapPhi = 0; // snapshot: storage belongs to the manager
+  fMapCharge = 0;
   fWasUpdated = 0;
   fFirstFilled = 0;
   fWasUpdated = 0;
@@ -200,6 +752,21 @@ void StEventPool::Clear(Option_t *opt)
 TObject* StEventPool::GetRandomTrack() const
 {
   // Get any random track from the pool, sampled with uniform probability.
+  // Ring buffer: transient StFemtoTrack, valid until the next call.
+
+  if (fUseRingBuffer) {
+    if (fRingNTracksTotal == 0) return 0x0;
+    const Float_t *pt, *eta, *phi; const Char_t *charge;
+    Int_t ntrk = 0, ranEvt = 0;
+    while (ntrk == 0) {
+      ranEvt = gRandom->Integer(fRingNEvents);
+      ntrk = GetEventTracks(ranEvt, pt, eta, phi, charge);
+    }
+    UInt_t ranTrk = gRandom->Integer(ntrk);
+    if (!fRingEventView) fRingEventView = new TClonesArray("StFemtoTrack");
+    fRingEventView->Clear();
+    return new ((*fRingEventView)[0]) StFemtoTrack(pt[ranTrk], eta[ranTrk], phi[ranTrk], charge[ranTrk]);
+  }
 
   UInt_t ranEvt = gRandom->Integer(fEvents.size());
   TObjArray *tca = fEvents.at(ranEvt);
@@ -210,6 +777,24 @@ TObject* StEventPool::GetRandomTrack() const
 
 TObjArray* StEventPool::GetEvent(Int_t i) const
 {
+  // Ring buffer: transient array of StFemtoTrack's, valid until the next
+  // call, use GetEventTracks() in loops.
+
+  if (fUseRingBuffer) {
+    const Float_t *pt, *eta, *phi; const Char_t *charge;
+    if (i<0 || i>=fRingNEvents) {
+      cout << "StEventPool::GetEvent("
+	   << i << "): Invalid index" << endl;
+      return 0x0;
+    }
+    Int_t ntrk = GetEventTracks(i, pt, eta, phi, charge);
+    if (!fRingEventView) fRingEventView = new TClonesArray("StFemtoTrack");
+    fRingEventView->Clear();
+    for (Int_t itrk=0; itrk<ntrk; itrk++)
+      new ((*fRingEventView)[itrk]) StFemtoTrack(pt[itrk], eta[itrk], phi[itrk], charge[itrk]);
+    return fRingEventView;
+  }
+
   if (i<0 || i>=(Int_t)fEvents.size()) {
     cout << "StEventPool::GetEvent(" 
 	 << i << "): Invalid index" << endl;
@@ -222,15 +807,59 @@ TObjArray* StEventPool::GetEvent(Int_t i) const
 
 TObjArray* StEventPool::GetRandomEvent() const
 {
+  if (fUseRingBuffer)
+    return GetEvent(gRandom->Integer(fRingNEvents));
+
   UInt_t ranEvt = gRandom->Integer(fEvents.size());
   TObjArray *tca = fEvents.at(ranEvt);
   return tca;
 }
 
+Int_t StEventPool::GetRandomEvents(std::vector<Int_t> &events, Int_t nEvents, Int_t maxTracks, TRandom *rnd) const
+{
+  // Draw up to nEvents distinct events (local indices) with uniform
+  // probability, without replacement, for sampled mixing. With maxTracks > 0
+  // drawing stops as soon as the drawn events hold maxTracks tracks (at
+  // least one event is drawn). nEvents <= 0: no limit on the number of
+  // events, both limits <= 0: all events in pool order. rnd: random
+  // stream, gRandom if not set. Returns the number of events drawn.
+
+  events.clear();
+  const Int_t n = GetCurrentNEvents();
+  if (n <= 0) return 0;
+  if (nEvents <= 0 || nEvents > n) nEvents = n;
+  events.resize(n);
+  for (Int_t i=0; i<n; i++) events[i] = i;
+  if (nEvents == n && maxTracks <= 0) return n;
+  if (!rnd) rnd = gRandom;
+
+  // partial Fisher-Yates shuffle: events[0, ndrawn) is the sample
+  Int_t ndrawn = 0, ntrk = 0;
+  while (ndrawn < nEvents && (maxTracks <= 0 || ntrk < maxTracks)) {
+    Int_t j = ndrawn + rnd->Integer(n - ndrawn);
+    std::swap(events[ndrawn], events[j]);
+    ntrk += (fUseRingBuffer) ? fRingNTracks[RingSlot(events[ndrawn])] : fNTracksInEvent.at(events[ndrawn]);
+    ndrawn++;
+  }
+  events.resize(ndrawn);
+  return ndrawn;
+}
+
 Int_t StEventPool::NTracksInEvent(Int_t iEvent) const
 {
   // Return number of tracks in iEvent, which is the local pool index.
 
+  if (fUseRingBuffer) {
+    if (fRingNEvents == 0 || iEvent < 0) return 0;
+    Int_t offset = fRingEventIndex[RingSlot(fRingNEvents-1)] - iEvent;
+    if (offset < 0) return 0;
+    if (offset >= fRingNEvents) {
+      cout << "Event info no longer in memory" << endl;
+      return -1;
+    }
+    return fRingNTracks[RingSlot(fRingNEvents - 1 - offset)];
+  }
+
   Int_t n = -1;
   Int_t curEvent = fEventIndex.back();
   Int_t offset = curEvent - iEvent;
@@ -254,7 +883,7 @@ ClassImp(StEventPoolManager)
 StEventPoolManager::StEventPoolManager(Int_t depth,     Int_t minNTracks,
 					 Int_t nMultBins, Double_t *multbins,
 					 Int_t nZvtxBins, Double_t *zvtxbins) :
-fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(), fZvtxBins(), fPsiBins(), fPtBins(), fEvPool(0), fTargetTrackDepth(minNTracks) 
+fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(), fZvtxBins(), fPsiBins(), fPtBins(), fEvPool(0), fTargetTrackDepth(minNTracks), fMultUniform(0), fZvtxUniform(0), fPsiUniform(0), fMultInvWidth(0), fZvtxInvWidth(0), fPsiInvWidth(0), fSnapshotMap(0), fSnapshotSize(0), fMemoryBudget(0), fBalanceInterval(0), fQuantized(0), fNUpdates(0) 
 {
   // Constructor.
   // without Event plane bins or pt bins
@@ -271,7 +900,7 @@ StEventPoolManager::StEventPoolManager(Int_t depth,     Int_t minNTracks,
 					 Int_t nMultBins, Double_t *multbins,
 					 Int_t nZvtxBins, Double_t *zvtxbins,
 					 Int_t nPsiBins, Double_t *psibins) :
-fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(), fZvtxBins(), fPsiBins(), fPtBins(), fEvPool(0), fTargetTrackDepth(minNTracks) 
+fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(), fZvtxBins(), fPsiBins(), fPtBins(), fEvPool(0), fTargetTrackDepth(minNTracks), fMultUniform(0), fZvtxUniform(0), fPsiUniform(0), fMultInvWidth(0), fZvtxInvWidth(0), fPsiInvWidth(0), fSnapshotMap(0), fSnapshotSize(0), fMemoryBudget(0), fBalanceInterval(0), fQuantized(0), fNUpdates(0) 
 {
   // Constructor.
   // without pt bins
@@ -287,7 +916,7 @@ StEventPoolManager::StEventPoolManager(Int_t depth,     Int_t minNTracks,
 					 Int_t nZvtxBins, Double_t *zvtxbins,
 					 Int_t nPsiBins, Double_t *psibins,
            Int_t nPtBins, Double_t *ptbins) :
-fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(), fZvtxBins(), fPsiBins(), fPtBins(), fEvPool(0), fTargetTrackDepth(minNTracks) 
+fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(), fZvtxBins(), fPsiBins(), fPtBins(), fEvPool(0), fTargetTrackDepth(minNTracks), fMultUniform(0), fZvtxUniform(0), fPsiUniform(0), fMultInvWidth(0), fZvtxInvWidth(0), fPsiInvWidth(0), fSnapshotMap(0), fSnapshotSize(0), fMemoryBudget(0), fBalanceInterval(0), fQuantized(0), fNUpdates(0) 
 {
   // Constructor.
 
@@ -296,7 +925,7 @@ fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(),
 }
 
 StEventPoolManager::StEventPoolManager(Int_t depth,     Int_t minNTracks, const char* binning) :
-fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(), fZvtxBins(), fPsiBins(), fPtBins(), fEvPool(0), fTargetTrackDepth(minNTracks) 
+fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(), fZvtxBins(), fPsiBins(), fPtBins(), fEvPool(0), fTargetTrackDepth(minNTracks), fMultUniform(0), fZvtxUniform(0), fPsiUniform(0), fMultInvWidth(0), fZvtxInvWidth(0), fPsiInvWidth(0), fSnapshotMap(0), fSnapshotSize(0), fMemoryBudget(0), fBalanceInterval(0), fQuantized(0), fNUpdates(0) 
 {
   Double_t psidummy[2] = {-999.,999.};
   Double_t ptdummy[2] = {-9999.,9999.};
@@ -322,6 +951,13 @@ fDebug(0), fNMultBins(0), fNZvtxBins(0), fNPsiBins(0), fNPtBins(0), fMultBins(),
   cout << "StEventPoolManager initialized." << endl;
 }
 
+StEventPoolManager::~StEventPoolManager()
+{
+  // the pools are owned by the user (see ClearPools()), snapshot pools are
+  // cleared before the mapping is released
+  DetachSnapshot(kFALSE);
+}
+
 Int_t StEventPoolManager::InitEventPools(Int_t depth, 
 					  Int_t nMultBins, Double_t *multbin, 
 					  Int_t nZvtxBins, Double_t *zvtxbin, 
@@ -339,6 +975,11 @@ Int_t StEventPoolManager::InitEventPools(Int_t depth,
   fZvtxBins.assign(zvtxbin, zvtxbin+nZvtxBins+1);
   fPsiBins.assign(psibin, psibin+nPsiBins+1);
   fPtBins.assign(ptbin, ptbin+nPtBins+1);
+
+  // precompute fast path of the bin lookup
+  fMultUniform = IsUniformBinning(fMultBins, fMultInvWidth);
+  fZvtxUniform = IsUniformBinning(fZvtxBins, fZvtxInvWidth);
+  fPsiUniform  = IsUniformBinning(fPsiBins,  fPsiInvWidth);
   
   for (Int_t iM=0; iM<nMultBins; iM++) {
     for (Int_t iZ=0; iZ<nZvtxBins; iZ++) {
@@ -365,6 +1006,7 @@ Int_t StEventPoolManager::InitEventPools(Int_t depth,
           fEvPool.at(GetBinIndex(iM, iZ, iP, iPt))->SetPsiBinIndex(iP);
           fEvPool.at(GetBinIndex(iM, iZ, iP, iPt))->SetPtBinIndex(iPt);
           fEvPool.at(GetBinIndex(iM, iZ, iP, iPt))->SetTargetTrackDepth(fTargetTrackDepth);
+          fEvPool.at(GetBinIndex(iM, iZ, iP, iPt))->SetManager(this);
         }
       }
     }
@@ -438,6 +1080,111 @@ void StEventPoolManager::SetTargetValues(Int_t trackDepth, Float_t fraction, Int
   }
 }
 
+void StEventPoolManager::SetUseRingBuffer(Bool_t b, Int_t trackCapacity)
+{
+  // Select ring buffer (float structure-of-arrays) track storage in all
+  // event pools, see StEventPool::SetUseRingBuffer()
+
+  for (Int_t i=0; i<(Int_t)fEvPool.size(); i++)
+    if (fEvPool[i]) fEvPool[i]->SetUseRingBuffer(b, trackCapacity);
+}
+
+void StEventPoolManager::SetQuantizedStorage(Bool_t b)
+{
+  // 16 bit fixed point pt / eta / phi in all event pools (cleared), see
+  // StEventPool::SetQuantized()
+
+  fQuantized = b;
+  for (Int_t i=0; i<(Int_t)fEvPool.size(); i++)
+    if (fEvPool[i]) fEvPool[i]->SetQuantized(b);
+  if (fMemoryBudget > 0) BalanceMemory();
+}
+
+void StEventPoolManager::SetMemoryBudget(Long64_t bytes, Int_t interval)
+{
+  // Limit the track storage of all (ring buffer) pools to <bytes> in total,
+  // 0 removes the limits. The budget is shared out again every <interval>
+  // pool updates, see BalanceMemory().
+
+  fMemoryBudget = TMath::Max(bytes, (Long64_t)0);
+  fBalanceInterval = TMath::Max(interval, 1);
+  fNUpdates = 0;
+  if (fMemoryBudget > 0) {
+    BalanceMemory();
+    return;
+  }
+  for (Int_t i=0; i<(Int_t)fEvPool.size(); i++)
+    if (fEvPool[i]) fEvPool[i]->SetMaxTrackCapacity(0);
+}
+
+void StEventPoolManager::BalanceMemory()
+{
+  // Share the memory budget out to the pools by demand: each pool needs
+  // its default ring capacity (2 x target track depth, min. 1024 tracks),
+  // its share of the budget is proportional to its number of updates (+1).
+  // Pools needing less than their share get their need, the rest is shared
+  // again among the others (water filling). Pools above their new limit
+  // drop their oldest events. Snapshot pools are not counted.
+
+  if (fMemoryBudget <= 0) return;
+
+  Int_t nPools = fEvPool.size();
+  const Double_t bytesPerTrack = (fQuantized) ? 3*sizeof(UShort_t) + sizeof(Char_t) : 3*sizeof(Float_t) + sizeof(Char_t);
+  std::vector<Int_t> active;
+  std::vector<Double_t> need(nPools, 0.), demand(nPools, 0.), alloc(nPools, 0.);
+  Double_t remaining = fMemoryBudget;
+  for (Int_t i=0; i<nPools; i++) {
+    StEventPool *pool = fEvPool[i];
+    if (!pool || pool->HasSnapshot()) continue;
+    remaining -= 3*sizeof(Int_t)*TMath::Max(pool->GetRingEventCapacity(), 16); // event table
+    need[i] = TMath::Max(2*fTargetTrackDepth, 1024);
+    demand[i] = pool->GetNUpdates() + 1.;
+    active.push_back(i);
+  }
+  remaining = TMath::Max(remaining/bytesPerTrack, 0.);
+
+  Bool_t changed = kTRUE;
+  while (changed && !active.empty()) {
+    changed = kFALSE;
+    Double_t sumDemand = 0.;
+    for (UInt_t j=0; j<active.size(); j++) sumDemand += demand[active[j]];
+
+    std::vector<Int_t> next;
+    Double_t given = 0.;
+    for (UInt_t j=0; j<active.size(); j++) {
+      Int_t i = active[j];
+      if (need[i] <= remaining*demand[i]/sumDemand) {
+        alloc[i] = need[i];
+        given += need[i];
+        changed = kTRUE;
+      } else next.push_back(i);
+    }
+    remaining -= given;
+    active.swap(next);
+
+    if (!changed) {
+      for (UInt_t j=0; j<active.size(); j++)
+        alloc[active[j]] = remaining*demand[active[j]]/sumDemand;
+    }
+  }
+
+  for (Int_t i=0; i<nPools; i++) {
+    StEventPool *pool = fEvPool[i];
+    if (!pool || pool->HasSnapshot()) continue;
+    pool->SetMaxTrackCapacity(TMath::Max((Int_t)alloc[i], 1));
+  }
+}
+
+Long64_t StEventPoolManager::GetMemoryUsage() const
+{
+  // Allocated track storage of all pools in bytes (without a mapped snapshot)
+
+  Long64_t bytes = 0;
+  for (Int_t i=0; i<(Int_t)fEvPool.size(); i++)
+    if (fEvPool[i]) bytes += fEvPool[i]->GetMemoryUsage();
+  return bytes;
+}
+
 void StEventPoolManager::ClearPools()
 {
   // Clear the pools that are not marked to be saved
@@ -523,6 +1270,8 @@ void StEventPoolManager::Validate()
 
   std::cout << "Note: Locked pools won't be filled. They are intended to serve as external input.\n";
   std::cout << "      Pools with save flag: Those pools are intended to be written to the output file.\n";
+  if(fSnapshotMap)
+    std::cout << Form("Pool snapshot: %lld bytes memory mapped (read-only, shared)", fSnapshotSize) << std::endl;
 
   for (Int_t iM=0; iM<fNMultBins; iM++)
     for (Int_t iZ=0; iZ<fNZvtxBins; iZ++)
@@ -533,7 +1282,7 @@ void StEventPoolManager::Validate()
           if(!pool)
             Form("Pool (%i,%i,%i,%i) is not correctly initialized!", iM, iZ, iP, iPt);
           if(pool->GetLockFlag())
-            std::cout << Form(" Pool (mult=%4.3f-%4.3f, zvertex=%4.3f-%4.3f, psi=%4.3f-%4.3f, pt=%4.3f-%4.3f) locked", fMultBins[iM], fMultBins[iM+1], fZvtxBins[iZ], fZvtxBins[iZ+1], fPsiBins[iP], fPsiBins[iP+1], fPtBins[iPt], fPtBins[iPt+1]) << std::endl;
+            std::cout << Form(" Pool (mult=%4.3f-%4.3f, zvertex=%4.3f-%4.3f, psi=%4.3f-%4.3f, pt=%4.3f-%4.3f) locked%s", fMultBins[iM], fMultBins[iM+1], fZvtxBins[iZ], fZvtxBins[iZ+1], fPsiBins[iP], fPsiBins[iP+1], fPtBins[iPt], fPtBins[iPt+1], (pool->HasSnapshot()) ? " (snapshot)" : "") << std::endl;
         }
 
   for (Int_t iM=0; iM<fNMultBins; iM++)
@@ -546,11 +1295,260 @@ void StEventPoolManager::Validate()
             std::cout << Form(" Pool (mult=%4.3f-%4.3f, zvertex=%3.3f-%4.3f, psi=%4.3f-%4.3f, pt=%4.3f-%4.3f) will be saved", fMultBins[iM], fMultBins[iM+1], fZvtxBins[iZ], fZvtxBins[iZ+1], fPsiBins[iP], fPsiBins[iP+1], fPtBins[iPt], fPtBins[iPt+1]) << std::endl;
         }
 
+  // occupancy (tracks / target track depth) and allocated memory per bin
+  std::cout << "== Pool occupancy and memory ==\n";
+  Int_t nFilled = 0, nReady = 0;
+  Long64_t nTracks = 0;
+  for (Int_t iM=0; iM<fNMultBins; iM++)
+    for (Int_t iZ=0; iZ<fNZvtxBins; iZ++)
+      for (Int_t iP=0; iP<fNPsiBins; iP++)
+        for (Int_t iPt=0; iPt<fNPtBins; iPt++) 
+        {
+          StEventPool* pool = GetEventPool(iM, iZ, iP, iPt);
+          if(pool->GetCurrentNEvents() == 0 && pool->GetMemoryUsage() == 0) continue;
+          nFilled++;
+          if(pool->IsReady()) nReady++;
+          nTracks += pool->NTracksInPool();
+          TString limit = (pool->GetMaxTrackCapacity() > 0) ? Form(", limit %d tracks", pool->GetMaxTrackCapacity()) : "";
+          std::cout << Form(" Pool (mult=%4.3f-%4.3f, zvertex=%4.3f-%4.3f, psi=%4.3f-%4.3f, pt=%4.3f-%4.3f): %d events, %d tracks (%.0f%% of target), %.1f kB%s%s", fMultBins[iM], fMultBins[iM+1], fZvtxBins[iZ], fZvtxBins[iZ+1], fPsiBins[iP], fPsiBins[iP+1], fPtBins[iPt], fPtBins[iPt+1], pool->GetCurrentNEvents(), pool->NTracksInPool(), (fTargetTrackDepth > 0) ? 100.*pool->NTracksInPool()/fTargetTrackDepth : 0., pool->GetMemoryUsage()/1024., limit.Data(), (pool->HasSnapshot()) ? " (snapshot)" : "") << std::endl;
+        }
+  TString budget = (fMemoryBudget > 0) ? Form(", budget %.1f MB", fMemoryBudget/1048576.) : "";
+  std::cout << Form("Total: %d of %d pools filled, %d ready, %lld tracks, %.1f MB (%s storage%s)", nFilled, (Int_t)fEvPool.size(), nReady, nTracks, GetMemoryUsage()/1048576., (fQuantized) ? "16 bit" : "float", budget.Data()) << std::endl;
+
   std::cout << "############## StEventPoolManager ##############\n"; 
 
 }
 
 
+Int_t StEventPoolManager::WritePoolSnapshot(const char *fileName, Bool_t onlyReady) const
+{
+  // Export the pools to a binary snapshot for ReadPoolSnapshot(): the
+  // pools with save flag if any pool is flagged (SetSaveFlag()), else all
+  // ready pools (<onlyReady>) or all non-empty pools. Only ring buffer
+  // pools are stored. The file is written under a temporary name and
+  // renamed, so that running jobs never map a partial file.
+  // Returns the number of stored pools, -1 on error.
+
+  Bool_t useSaveFlag = kFALSE;
+  for (Int_t i=0; i<(Int_t)fEvPool.size(); i++)
+    if (fEvPool[i] && fEvPool[i]->GetSaveFlag()) useSaveFlag = kTRUE;
+
+  std::vector<StPoolSnapshotEntry> entries;
+  std::vector<Int_t> offset, ntracks, eventIndex;
+  Long64_t nTracks = 0;
+  for (Int_t i=0; i<(Int_t)fEvPool.size(); i++) {
+    StEventPool *pool = fEvPool[i];
+    if (!pool || pool->GetCurrentNEvents() == 0) continue;
+    if (useSaveFlag && !pool->GetSaveFlag()) continue;
+    if (!useSaveFlag && onlyReady && !pool->IsReady()) continue;
+    if (!pool->GetUseRingBuffer()) {
+      cout << "StEventPoolManager::WritePoolSnapshot(): pool " << i << " does not use the ring buffer, not stored" << endl;
+      continue;
+    }
+
+    StPoolSnapshotEntry entry;
+    entry.fIndex = i;
+    entry.fNEvents = pool->GetCurrentNEvents();
+    entry.fFirstEvent = offset.size();
+    entry.fFirstTrack = nTracks;
+    Int_t pos = 0;
+    for (Int_t j=0; j<entry.fNEvents; j++) {
+      const Float_t *pt, *eta, *phi; const Char_t *charge;
+      Int_t n = pool->GetEventTracks(j, pt, eta, phi, charge);
+      offset.push_back(pos);
+      ntracks.push_back(n);
+      eventIndex.push_back(pool->GlobalEventIndex(j));
+      pos += n;
+    }
+    nTracks += pos;
+    entries.push_back(entry);
+  }
+
+  std::vector<Double_t> edges;
+  edges.insert(edges.end(), fMultBins.begin(), fMultBins.end());
+  edges.insert(edges.end(), fZvtxBins.begin(), fZvtxBins.end());
+  edges.insert(edges.end(), fPsiBins.begin(), fPsiBins.end());
+  edges.insert(edges.end(), fPtBins.begin(), fPtBins.end());
+
+  StPoolSnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  header.fMagic = kSnapshotMagic;
+  header.fVersion = kSnapshotVersion;
+  header.fNMultBins = fNMultBins;
+  header.fNZvtxBins = fNZvtxBins;
+  header.fNPsiBins = fNPsiBins;
+  header.fNPtBins = fNPtBins;
+  header.fNPools = entries.size();
+  header.fTargetTrackDepth = fTargetTrackDepth;
+  header.fNEvents = offset.size();
+  header.fNTracks = nTracks;
+  header.fEdgesOffset  = SnapshotAlign(sizeof(header));
+  header.fPoolsOffset  = SnapshotAlign(header.fEdgesOffset  + edges.size()*sizeof(Double_t));
+  header.fEventsOffset = SnapshotAlign(header.fPoolsOffset  + entries.size()*sizeof(StPoolSnapshotEntry));
+  header.fPtOffset     = SnapshotAlign(header.fEventsOffset + 3*header.fNEvents*sizeof(Int_t));
+  header.fEtaOffset    = SnapshotAlign(header.fPtOffset     + nTracks*sizeof(Float_t));
+  header.fPhiOffset    = SnapshotAlign(header.fEtaOffset    + nTracks*sizeof(Float_t));
+  header.fChargeOffset = SnapshotAlign(header.fPhiOffset    + nTracks*sizeof(Float_t));
+  header.fFileSize     = header.fChargeOffset + nTracks*sizeof(Char_t);
+
+  TString tmpName = Form("%s.tmp%d", fileName, (Int_t)getpid());
+  FILE *f = fopen(tmpName.Data(), "wb");
+  if (!f) {
+    cout << "StEventPoolManager::WritePoolSnapshot(): cannot open " << tmpName.Data() << endl;
+    return -1;
+  }
+
+  Long64_t pos = 0;
+  Bool_t ok = SnapshotWrite(f, pos, &header, sizeof(header)) && SnapshotPad(f, pos);
+  ok = ok && SnapshotWrite(f, pos, &edges[0], edges.size()*sizeof(Double_t)) && SnapshotPad(f, pos);
+  if (!entries.empty()) ok = ok && SnapshotWrite(f, pos, &entries[0], entries.size()*sizeof(StPoolSnapshotEntry));
+  ok = ok && SnapshotPad(f, pos);
+  if (!offset.empty()) {
+    ok = ok && SnapshotWrite(f, pos, &offset[0],     offset.size()*sizeof(Int_t));
+    ok = ok && SnapshotWrite(f, pos, &ntracks[0],    ntracks.size()*sizeof(Int_t));
+    ok = ok && SnapshotWrite(f, pos, &eventIndex[0], eventIndex.size()*sizeof(Int_t));
+  }
+  ok = ok && SnapshotPad(f, pos);
+
+  // track arrays: one pass per quantity, events are contiguous in the pools
+  for (Int_t q=0; q<4 && ok; q++) {
+    for (Int_t i=0; i<(Int_t)entries.size() && ok; i++) {
+      StEventPool *pool = fEvPool[entries[i].fIndex];
+      for (Int_t j=0; j<entries[i].fNEvents && ok; j++) {
+        const Float_t *pt, *eta, *phi; const Char_t *charge;
+        Int_t n = pool->GetEventTracks(j, pt, eta, phi, charge);
+        if (q == 0) ok = SnapshotWrite(f, pos, pt,     n*sizeof(Float_t));
+        if (q == 1) ok = SnapshotWrite(f, pos, eta,    n*sizeof(Float_t));
+        if (q == 2) ok = SnapshotWrite(f, pos, phi,    n*sizeof(Float_t));
+        if (q == 3) ok = SnapshotWrite(f, pos, charge, n*sizeof(Char_t));
+      }
+    }
+    if (q < 3) ok = ok && SnapshotPad(f, pos);
+  }
+
+  ok = (fclose(f) == 0) && ok && (pos == header.fFileSize);
+  if (ok) ok = (rename(tmpName.Data(), fileName) == 0);
+  if (!ok) {
+    cout << "StEventPoolManager::WritePoolSnapshot(): writing " << fileName << " failed" << endl;
+    remove(tmpName.Data());
+    return -1;
+  }
+
+  cout << Form("StEventPoolManager::WritePoolSnapshot(): %d pools, %lld events, %lld tracks written to %s",
+               header.fNPools, header.fNEvents, header.fNTracks, fileName) << endl;
+  return header.fNPools;
+}
+
+Int_t StEventPoolManager::ReadPoolSnapshot(const char *fileName, Bool_t lock)
+{
+  // Import a snapshot of WritePoolSnapshot() with the same binning. The
+  // file is memory mapped read-only and shared: the pools use the mapped
+  // track arrays directly and are locked (<lock>), so they serve as
+  // external input and are not updated. Unlocked pools start from the
+  // snapshot and copy it at their first update.
+  // Returns the number of imported pools, -1 on error.
+
+  DetachSnapshot(kFALSE);
+
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0) {
+    cout << "StEventPoolManager::ReadPoolSnapshot(): cannot open " << fileName << endl;
+    return -1;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(StPoolSnapshotHeader)) {
+    cout << "StEventPoolManager::ReadPoolSnapshot(): " << fileName << " is not a pool snapshot" << endl;
+    close(fd);
+    return -1;
+  }
+  void *map = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); // the mapping stays valid
+  if (map == MAP_FAILED) {
+    cout << "StEventPoolManager::ReadPoolSnapshot(): cannot map " << fileName << endl;
+    return -1;
+  }
+  const char *base = (const char*)map;
+  Long64_t size = st.st_size;
+
+  // header, binning and section bounds
+  const StPoolSnapshotHeader *header = (const StPoolSnapshotHeader*)base;
+  TString error = "";
+  if (header->fMagic != kSnapshotMagic) error = "not a pool snapshot (or different byte order)";
+  else if (header->fVersion != kSnapshotVersion) error = Form("version %u, expected %u", header->fVersion, kSnapshotVersion);
+  else if (header->fFileSize != size) error = "truncated file";
+  else if (header->fNMultBins != fNMultBins || header->fNZvtxBins != fNZvtxBins ||
+           header->fNPsiBins != fNPsiBins || header->fNPtBins != fNPtBins) error = "different number of bins";
+  else if (header->fNPools < 0 || header->fNEvents < 0 || header->fNTracks < 0 ||
+           header->fEdgesOffset  + (fNMultBins+fNZvtxBins+fNPsiBins+fNPtBins+4)*(Long64_t)sizeof(Double_t) > size ||
+           header->fPoolsOffset  + header->fNPools*(Long64_t)sizeof(StPoolSnapshotEntry) > size ||
+           header->fEventsOffset + 3*header->fNEvents*(Long64_t)sizeof(Int_t) > size ||
+           header->fChargeOffset + header->fNTracks*(Long64_t)sizeof(Char_t) > size) error = "inconsistent sections";
+
+  if (error == "") {
+    const Double_t *edges = (const Double_t*)(base + header->fEdgesOffset);
+    const std::vector<Double_t> *bins[4] = {&fMultBins, &fZvtxBins, &fPsiBins, &fPtBins};
+    for (Int_t b=0; b<4; b++) {
+      for (Int_t i=0; i<(Int_t)bins[b]->size(); i++, edges++)
+        if (TMath::Abs(*edges - bins[b]->at(i)) > 1e-9*TMath::Max(1., TMath::Abs(*edges))) error = "different bin edges";
+    }
+  }
+
+  if (error != "") {
+    cout << "StEventPoolManager::ReadPoolSnapshot(): " << fileName << ": " << error.Data() << endl;
+    munmap(map, size);
+    return -1;
+  }
+
+  // the pages are shared between all jobs mapping this file
+  madvise(map, size, MADV_WILLNEED);
+  fSnapshotMap = map;
+  fSnapshotSize = size;
+
+  const StPoolSnapshotEntry *entries = (const StPoolSnapshotEntry*)(base + header->fPoolsOffset);
+  const Int_t *offset     = (const Int_t*)(base + header->fEventsOffset);
+  const Int_t *ntracks    = offset  + header->fNEvents;
+  const Int_t *eventIndex = ntracks + header->fNEvents;
+  const Float_t *pt     = (const Float_t*)(base + header->fPtOffset);
+  const Float_t *eta    = (const Float_t*)(base + header->fEtaOffset);
+  const Float_t *phi    = (const Float_t*)(base + header->fPhiOffset);
+  const Char_t  *charge = (const Char_t*)(base + header->fChargeOffset);
+
+  Int_t nImported = 0;
+  for (Int_t i=0; i<header->fNPools; i++) {
+    const StPoolSnapshotEntry &entry = entries[i];
+    StEventPool *pool = GetEventPoolAt(entry.fIndex);
+    if (!pool || entry.fNEvents < 0 || entry.fFirstEvent + entry.fNEvents > header->fNEvents) continue;
+    Long64_t ntrk = 0;
+    for (Int_t j=0; j<entry.fNEvents; j++)
+      ntrk = TMath::Max(ntrk, (Long64_t)offset[entry.fFirstEvent + j] + ntracks[entry.fFirstEvent + j]);
+    if (entry.fFirstTrack + ntrk > header->fNTracks) continue;
+
+    const Long64_t e = entry.fFirstEvent, t = entry.fFirstTrack;
+    pool->SetLockFlag(kFALSE);
+    pool->AttachSnapshot(entry.fNEvents, offset + e, ntracks + e, eventIndex + e, pt + t, eta + t, phi + t, charge + t);
+    pool->SetLockFlag(lock);
+    nImported++;
+  }
+
+  cout << Form("StEventPoolManager::ReadPoolSnapshot(): %d pools, %lld events, %lld tracks mapped from %s%s",
+               nImported, header->fNEvents, header->fNTracks, fileName, (lock) ? " (locked)" : "") << endl;
+  return nImported;
+}
+
+void StEventPoolManager::DetachSnapshot(Bool_t copy)
+{
+  // Release the mapped snapshot: pools still using it are copied to their
+  // own storage (<copy>, e.g. before the manager is written) or cleared.
+
+  if (!fSnapshotMap) return;
+  for (Int_t i=0; i<(Int_t)fEvPool.size(); i++)
+    if (fEvPool[i] && fEvPool[i]->HasSnapshot()) fEvPool[i]->DetachSnapshot(copy);
+
+  munmap(fSnapshotMap, fSnapshotSize);
+  fSnapshotMap = 0;
+  fSnapshotSize = 0;
+}
+
 StEventPool *StEventPoolManager::GetEventPool(Int_t iMult, Int_t iZvtx, Int_t iPsi, Int_t iPt) const
 {
   if (iMult < 0 || iMult >= fNMultBins) 
@@ -591,35 +1589,113 @@ StEventPool *StEventPoolManager::GetEventPool(Double_t centVal, Double_t zVtxVal
 {
   // Return appropriate pool for this centrality and z-vertex value.
 
-  for (Int_t iM=0; iM<fNMultBins; iM++) {
-    for (Int_t iZ=0; iZ<fNZvtxBins; iZ++) {
-      for (Int_t iP=0; iP<fNPsiBins; iP++) {
-        StEventPool* pool = GetEventPool(iM, iZ, iP, iPt);
-        if (pool->EventMatchesBin(centVal, zVtxVal, psiVal, (pool->GetPtMin()+pool->GetPtMax())/2 ))
-          return pool;
-      }
-    }
+  return GetEventPoolAt(GetPoolIndex(centVal, zVtxVal, psiVal, iPt));
+}
+
+Int_t StEventPoolManager::GetPoolIndex(Double_t centVal, Double_t zVtxVal, Double_t psiVal, Int_t iPt) const
+{
+  // Flat index (GetBinIndex) of the pool for this centrality, z-vertex and
+  // Psi value, -1 if outside of the binning. Same bin convention as
+  // StEventPool::EventMatchesBin: lower limit included, upper excluded.
+
+  if (iPt < 0 || iPt >= fNPtBins) return -1;
+
+  Int_t iM = FindBin(fMultBins, centVal, fMultUniform, fMultInvWidth);
+  if (iM < 0) return -1;
+  Int_t iZ = FindBin(fZvtxBins, zVtxVal, fZvtxUniform, fZvtxInvWidth);
+  if (iZ < 0) return -1;
+  Int_t iP = FindBin(fPsiBins, psiVal, fPsiUniform, fPsiInvWidth);
+  if (iP < 0) return -1;
+
+  return GetBinIndex(iM, iZ, iP, iPt);
+}
+
+Int_t StEventPoolManager::GetPoolIndices(Int_t n, const Double_t *centVal, const Double_t *zVtxVal, const Double_t *psiVal, Int_t *index, Int_t iPt) const
+{
+  // Batch version of GetPoolIndex: fills index[i] for the n (cent, zvtx, psi)
+  // values, psiVal can be 0 (Psi = 0). Returns the number of values inside
+  // the binning.
+
+  Int_t nFound = 0;
+  for (Int_t i=0; i<n; i++) {
+    index[i] = GetPoolIndex(centVal[i], zVtxVal[i], (psiVal) ? psiVal[i] : 0., iPt);
+    if (index[i] >= 0) nFound++;
+  }
+  return nFound;
+}
+
+Bool_t StEventPoolManager::IsUniformBinning(const std::vector<Double_t> &edges, Double_t &invWidth)
+{
+  // Check for equidistant bin edges, sets 1 / bin width
+
+  invWidth = 0;
+  Int_t nBins = (Int_t)edges.size() - 1;
+  if (nBins < 1) return kFALSE;
+
+  Double_t width = (edges[nBins] - edges[0]) / nBins;
+  if (width <= 0) return kFALSE;
+  for (Int_t i=0; i<=nBins; i++)
+    if (TMath::Abs(edges[i] - (edges[0] + i*width)) > 1e-9*width) return kFALSE;
+
+  invWidth = 1. / width;
+  return kTRUE;
+}
+
+Int_t StEventPoolManager::FindBin(const std::vector<Double_t> &edges, Double_t x, Bool_t uniform, Double_t invWidth)
+{
+  // Bin of x in [edges[0], edges[n]), -1 if outside: O(1) for uniform bins,
+  // binary search otherwise
+
+  Int_t nBins = (Int_t)edges.size() - 1;
+  if (nBins < 1 || !(x >= edges[0] && x < edges[nBins])) return -1;
+
+  Int_t bin;
+  if (uniform) {
+    bin = (Int_t)((x - edges[0]) * invWidth);
+    if (bin > nBins - 1) bin = nBins - 1;
+    // rounding at the edges: stay consistent with the stored edges
+    if (bin > 0 && x < edges[bin]) bin--;
+    else if (bin < nBins - 1 && x >= edges[bin+1]) bin++;
+  } else {
+    bin = std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
   }
-  return 0x0;
+  return bin;
 }
 
 Int_t StEventPoolManager::UpdatePools(TObjArray *trk)
 {
   // Call UpdatePool for all bins.
+  // the ownership of <trk> is delegated to this class: every pool gets
+  // its own copy (UpdatePool() owns its array), <trk> is deleted
 
   for (Int_t iM=0; iM<fNMultBins; iM++) {
     for (Int_t iZ=0; iZ<fNZvtxBins; iZ++) {
       for (Int_t iP=0; iP<fNPsiBins; iP++) {
         for (Int_t iPt=0; iPt<fNPtBins; iPt++) {
-          if (fEvPool.at(GetBinIndex(iM, iZ, iP, iPt))->UpdatePool(trk) > -1)
+          if (fEvPool.at(GetBinIndex(iM, iZ, iP, iPt))->UpdatePool(static_cast<TObjArray*>(trk->Clone())) > -1)
             break;
         }
       }
     }
   }  
+  delete trk;
   return 0;
 }
 
+Int_t StEventPoolManager::UpdatePools(TObjArray *trk, Double_t centVal, Double_t zVtxVal, Double_t psiVal, Int_t iPt)
+{
+  // Update only the pool of this centrality, z-vertex and Psi value,
+  // returns its number of events (-1: no pool)
+  // the ownership of <trk> is delegated to this class (see StEventPool::UpdatePool())
+
+  StEventPool *pool = GetEventPoolAt(GetPoolIndex(centVal, zVtxVal, psiVal, iPt));
+  if (!pool) {
+    delete trk;
+    return -1;
+  }
+  return pool->UpdatePool(trk);
+}
+
 Double_t* StEventPoolManager::GetBinning(const char* configuration, const char* tag, Int_t& nBins) const
 {  
   TString config(configuration);
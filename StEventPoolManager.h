@@ -20,9 +20,38 @@
 // $ALICE_ROOT/PWGCF/Correlations/DPhi/AliAnalysisTaskPhiCorrelations.cxx
 //
 // Authors: A. Adare and C. Loizides
+//
+// Ring buffer backend (SetUseRingBuffer()): instead of one TObjArray of
+// track objects per event, each pool keeps its tracks in contiguous float
+// pt / eta / phi and Char_t charge arrays of fixed capacity, with per-event
+// offsets in a ring of event slots. The oldest event is dropped by moving the
+// head, new events are copied in place, so the storage is reused from event
+// to event and only grows if an event does not fit. Events are read with
+// GetEventTracks(); GetEvent() / GetRandomTrack() return transient
+// StFemtoTrack views for backward compatibility.
+//
+// Pool snapshots (WritePoolSnapshot() / ReadPoolSnapshot()): the filled ring
+// buffer pools are exported to a compact binary file, bin edges + per pool
+// event table + pt / eta / phi / charge arrays. At import the file is memory
+// mapped read-only and the pools point into the mapping (no copy), so
+// concurrent jobs on one node share the same pages and mixing starts with
+// the first event. Imported pools are locked (external input, as with
+// SetSaveFlag()); unlocked imports are copied to the pool's own storage at
+// their first update.
+//
+// Memory budget (StEventPoolManager::SetMemoryBudget()): the ring buffer
+// track capacity of all pools is shared out by demand (number of updates
+// of each pool), pools at their limit drop the oldest events instead of
+// growing. Quantized storage (SetQuantizedStorage()) keeps pt / eta / phi
+// as 16 bit fixed point (fgQuantRange) + charge, 7 instead of 13 bytes per
+// track, decoded when read.
 
 using std::deque;
 
+class TClonesArray;
+class TRandom;
+class StEventPoolManager;
+
 class StEventPool : public TObject
 {
  public:
@@ -51,7 +80,38 @@ class StEventPool : public TObject
     fSaveFlag(0),
     fNTimes(0),
     fTargetFraction(1),
-    fTargetEvents(0)  {;} // default constructor needed for correct saving
+    fTargetEvents(0),
+    fUseRingBuffer(0),
+    fRingTrackCapacity(0),
+    fRingEventCapacity(0),
+    fRingPt(0),
+    fRingEta(0),
+    fRingPhi(0),
+    fRingCharge(0),
+    fRingOffset(0),
+    fRingNTracks(0),
+    fRingEventIndex(0),
+    fRingHead(0),
+    fRingNEvents(0),
+    fRingTail(0),
+    fRingNTracksTotal(0),
+    fRingWrapped(0),
+    fRingEventView(0),
+    fRingBufPt(0),
+    fRingBufEta(0),
+    fRingBufPhi(0),
+    fRingBufCharge(0),
+    fMapPt(0),
+    fMapEta(0),
+    fMapPhi(0),
+    fMapCharge(0),
+    fQuantized(0),
+    fRingQPt(0),
+    fRingQEta(0),
+    fRingQPhi(0),
+    fRingMaxTracks(0),
+    fNUpdates(0),
+    fManager(0)  {;} // default constructor needed for correct saving
 
  // 'explicit' added below to constructor to remove cppcheck warning - double check this one in particular FIXME TODO
  explicit StEventPool(Int_t d) 
@@ -79,7 +139,38 @@ class StEventPool : public TObject
     fSaveFlag(0),
     fNTimes(0),
     fTargetFraction(1),
-    fTargetEvents(0)  {;}
+    fTargetEvents(0),
+    fUseRingBuffer(0),
+    fRingTrackCapacity(0),
+    fRingEventCapacity(0),
+    fRingPt(0),
+    fRingEta(0),
+    fRingPhi(0),
+    fRingCharge(0),
+    fRingOffset(0),
+    fRingNTracks(0),
+    fRingEventIndex(0),
+    fRingHead(0),
+    fRingNEvents(0),
+    fRingTail(0),
+    fRingNTracksTotal(0),
+    fRingWrapped(0),
+    fRingEventView(0),
+    fRingBufPt(0),
+    fRingBufEta(0),
+    fRingBufPhi(0),
+    fRingBufCharge(0),
+    fMapPt(0),
+    fMapEta(0),
+    fMapPhi(0),
+    fMapCharge(0),
+    fQuantized(0),
+    fRingQPt(0),
+    fRingQEta(0),
+    fRingQPhi(0),
+    fRingMaxTracks(0),
+    fNUpdates(0),
+    fManager(0)  {;}
   
 
  StEventPool(Int_t d, Double_t multMin, Double_t multMax, 
@@ -110,23 +201,55 @@ class StEventPool : public TObject
     fSaveFlag(0),
     fNTimes(0),
     fTargetFraction(1),
-    fTargetEvents(0) {;}
+    fTargetEvents(0),
+    fUseRingBuffer(0),
+    fRingTrackCapacity(0),
+    fRingEventCapacity(0),
+    fRingPt(0),
+    fRingEta(0),
+    fRingPhi(0),
+    fRingCharge(0),
+    fRingOffset(0),
+    fRingNTracks(0),
+    fRingEventIndex(0),
+    fRingHead(0),
+    fRingNEvents(0),
+    fRingTail(0),
+    fRingNTracksTotal(0),
+    fRingWrapped(0),
+    fRingEventView(0),
+    fRingBufPt(0),
+    fRingBufEta(0),
+    fRingBufPhi(0),
+    fRingBufCharge(0),
+    fMapPt(0),
+    fMapEta(0),
+    fMapPhi(0),
+    fMapCharge(0),
+    fQuantized(0),
+    fRingQPt(0),
+    fRingQEta(0),
+    fRingQPhi(0),
+    fRingMaxTracks(0),
+    fNUpdates(0),
+    fManager(0) {;}
   
-  ~StEventPool() {;}
+  ~StEventPool();
   
   Bool_t      EventMatchesBin(Int_t mult,    Double_t zvtx, Double_t psi=0., Double_t pt=0.) const;
   Bool_t      EventMatchesBin(Double_t mult, Double_t zvtx, Double_t psi=0., Double_t pt=0.) const;
   Bool_t      IsReady()                    const { return IsReady(NTracksInPool(), GetCurrentNEvents()); }
   Bool_t      IsFirstReady()               const { return fFirstFilled;   }
   Int_t       GetNTimes()                  const { return fNTimes;        }
-  Int_t       GetCurrentNEvents()          const { return fEvents.size(); }
+  Int_t       GetCurrentNEvents()          const { return (fUseRingBuffer) ? fRingNEvents : (Int_t)fEvents.size(); }
   Int_t       GlobalEventIndex(Int_t j)    const;
   TObject    *GetRandomTrack()             const;
   TObjArray  *GetRandomEvent()             const;
+  Int_t       GetRandomEvents(std::vector<Int_t> &events, Int_t nEvents, Int_t maxTracks = 0, TRandom *rnd = 0) const;
   TObjArray  *GetEvent(Int_t i)            const;
   Int_t       MultBinIndex()               const { return fMultBinIndex; }
   Int_t       NTracksInEvent(Int_t iEvent) const;
-  Int_t       NTracksInCurrentEvent()      const { return fNTracksInEvent.back(); }
+  Int_t       NTracksInCurrentEvent()      const { return (fUseRingBuffer) ? fRingNTracks[RingSlot(fRingNEvents-1)] : fNTracksInEvent.back(); }
   void        PrintInfo()                  const;
   Int_t       PsiBinIndex()                const { return fPsiBinIndex; }
   Int_t       PtBinIndex()                 const { return fPtBinIndex; }
@@ -158,8 +281,36 @@ class StEventPool : public TObject
   Double_t    GetZvtxMin() { return fZvtxMin; }
   Double_t    GetZvtxMax() { return fZvtxMax; }
 
+  // the pool owns <trk> after the call (kept, or copied and deleted by the ring buffer / a locked pool)
   Int_t       UpdatePool(TObjArray *trk);
+  Int_t       UpdatePool(Int_t ntrk, const Float_t *pt, const Float_t *eta, const Float_t *phi, const Char_t *charge);
+
+  // ring buffer backend
+  void        SetUseRingBuffer(Bool_t b, Int_t trackCapacity = 0);
+  Bool_t      GetUseRingBuffer()           const { return fUseRingBuffer; }
+  Int_t       GetRingTrackCapacity()       const { return fRingTrackCapacity; }
+  Int_t       GetRingEventCapacity()       const { return fRingEventCapacity; }
+  Int_t       GetEventTracks(Int_t i, const Float_t *&pt, const Float_t *&eta, const Float_t *&phi, const Char_t *&charge) const;
+  Int_t       GetEventTracks(Int_t i, const UShort_t *&pt, const UShort_t *&eta, const UShort_t *&phi, const Char_t *&charge) const;
+
+  // quantized track storage and memory budget
+  void        SetQuantized(Bool_t b);
+  Bool_t      IsQuantized()                const { return fQuantized && !fMapPt; } // snapshot pools are float
+  void        SetMaxTrackCapacity(Int_t n);
+  Int_t       GetMaxTrackCapacity()        const { return fRingMaxTracks; }
+  Int_t       GetNUpdates()                const { return fNUpdates; }
+  Long64_t    GetMemoryUsage()             const;
+  void        SetManager(StEventPoolManager *mgr) { fManager = mgr; }
+  static Float_t  QuantDecode(UShort_t q, Int_t var) { return fgQuantRange[2*var] + q*(fgQuantRange[2*var+1] - fgQuantRange[2*var])/65536.; }
+  static UShort_t QuantEncode(Float_t x, Int_t var);
+  static const Double_t fgQuantRange[6];      // pt, eta, phi ranges of quantized storage
   Long64_t    Merge(TCollection* hlist);
+
+  // read-only track arrays of a pool snapshot (not owned), see StEventPoolManager::ReadPoolSnapshot()
+  void        AttachSnapshot(Int_t nEvents, const Int_t *offset, const Int_t *ntracks, const Int_t *eventIndex,
+                             const Float_t *pt, const Float_t *eta, const Float_t *phi, const Char_t *charge);
+  void        DetachSnapshot(Bool_t copy);
+  Bool_t      HasSnapshot()                const { return fMapPt != 0; }
 //  deque<TObjArray*> GetEvents() { return fEvents; }
 
 //  void        Clear();
@@ -167,6 +318,11 @@ class StEventPool : public TObject
 
 protected:
   Bool_t      IsReady(Int_t tracks, Int_t events) const { return (tracks >= fTargetFraction * fTargetTrackDepth) || ((fTargetEvents > 0) && (events >= fTargetEvents)); }
+  Int_t       RingSlot(Int_t i)            const { return (fRingHead + i) % fRingEventCapacity; }
+  Int_t       RingFindSpace(Int_t ntrk);
+  void        RingRemoveFirstEvent();
+  void        RingResize(Int_t trackCapacity, Int_t eventCapacity);
+  Int_t       RingFillFromArray(TObjArray *trk);
   
   deque<TObjArray*>     fEvents;              //Holds TObjArrays of MyTracklets
   deque<int>            fNTracksInEvent;      //Tracks in event
@@ -190,7 +346,41 @@ protected:
   Float_t               fTargetFraction;      //fraction of fTargetTrackDepth at which pool is ready (default: 1.0)
   Int_t                 fTargetEvents;        //if non-zero: number of filled events after which pool is ready regardless of fTargetTrackDepth (default: 0)
 
-  ClassDef(StEventPool,1) // Event pool class
+  Bool_t                fUseRingBuffer;       //tracks stored in ring buffer instead of TObjArrays
+  Int_t                 fRingTrackCapacity;   //track slots of ring buffer (0: 2 x fTargetTrackDepth at first update)
+  Int_t                 fRingEventCapacity;   //event slots of ring buffer
+  std::vector<Float_t>  fRingPt;              //track pt
+  std::vector<Float_t>  fRingEta;             //track eta
+  std::vector<Float_t>  fRingPhi;             //track phi
+  std::vector<Char_t>   fRingCharge;          //track charge
+  std::vector<Int_t>    fRingOffset;          //first track of event (per event slot)
+  std::vector<Int_t>    fRingNTracks;         //tracks in event (per event slot)
+  std::vector<Int_t>    fRingEventIndex;      //original event index (per event slot)
+  Int_t                 fRingHead;            //event slot of oldest event
+  Int_t                 fRingNEvents;         //events in ring buffer
+  Int_t                 fRingTail;            //track slot after newest event
+  Int_t                 fRingNTracksTotal;    //tracks in ring buffer
+  Bool_t                fRingWrapped;         //newest events stored before oldest event in track arrays
+
+  mutable TClonesArray *fRingEventView;       //! StFemtoTrack view of ring buffer event (GetEvent, GetRandomTrack)
+  mutable std::vector<Float_t> fRingBufPt;    //! conversion buffer for UpdatePool(TObjArray*), decoded quantized tracks
+  mutable std::vector<Float_t> fRingBufEta;   //! conversion buffer for UpdatePool(TObjArray*), decoded quantized tracks
+  mutable std::vector<Float_t> fRingBufPhi;   //! conversion buffer for UpdatePool(TObjArray*), decoded quantized tracks
+  mutable std::vector<Char_t>  fRingBufCharge;//! conversion buffer for UpdatePool(TObjArray*)
+  const Float_t        *fMapPt;               //! snapshot track pt (memory mapped, replaces fRingPt)
+  const Float_t        *fMapEta;              //! snapshot track eta
+  const Float_t        *fMapPhi;              //! snapshot track phi
+  const Char_t         *fMapCharge;           //! snapshot track charge
+
+  Bool_t                fQuantized;           //tracks stored as 16 bit fixed point (fRingQ*) instead of float
+  std::vector<UShort_t> fRingQPt;             //quantized track pt
+  std::vector<UShort_t> fRingQEta;            //quantized track eta
+  std::vector<UShort_t> fRingQPhi;            //quantized track phi
+  Int_t                 fRingMaxTracks;       //track capacity limit of the memory budget (0: none)
+  Int_t                 fNUpdates;            //number of updates (demand for the memory budget)
+  StEventPoolManager   *fManager;             //! manager of the memory budget
+
+  ClassDef(StEventPool,3) // Event pool class
 };
 
 class StEventPoolManager : public TObject
@@ -207,7 +397,19 @@ public:
     fPsiBins(),
     fPtBins(),
     fEvPool(0),
-    fTargetTrackDepth(0) {}
+    fTargetTrackDepth(0),
+    fMultUniform(0),
+    fZvtxUniform(0),
+    fPsiUniform(0),
+    fMultInvWidth(0),
+    fZvtxInvWidth(0),
+    fPsiInvWidth(0),
+    fSnapshotMap(0),
+    fSnapshotSize(0),
+    fMemoryBudget(0),
+    fBalanceInterval(0),
+    fQuantized(0),
+    fNUpdates(0) {}
   StEventPoolManager(Int_t maxEvts, Int_t minNTracks,
           Int_t nMultBins, Double_t *multbins,
           Int_t nZvtxBins, Double_t *zvtxbins);
@@ -226,13 +428,18 @@ public:
   StEventPoolManager(Int_t maxEvts, Int_t minNTracks, const char* binning);
 
 
-  ~StEventPoolManager() {;}
+  ~StEventPoolManager();
   Long64_t    Merge(TCollection* hlist);
 
   // First uses bin indices, second uses the variables themselves.
   StEventPool *GetEventPool(Int_t iMult, Int_t iZvtx, Int_t iPsi=0, Int_t iPt=0) const;
   StEventPool *GetEventPool(Int_t centVal, Double_t zvtxVal, Double_t psiVal=0., Int_t iPt=0) const;
   StEventPool *GetEventPool(Double_t centVal, Double_t zvtxVal, Double_t psiVal=0., Int_t iPt=0) const;
+  StEventPool *GetEventPoolAt(Int_t index) const { return (index >= 0 && index < (Int_t)fEvPool.size()) ? fEvPool[index] : 0x0; }
+
+  // flat pool index (-1: outside of binning), direct bin computation
+  Int_t       GetPoolIndex(Double_t centVal, Double_t zvtxVal, Double_t psiVal=0., Int_t iPt=0) const;
+  Int_t       GetPoolIndices(Int_t n, const Double_t *centVal, const Double_t *zvtxVal, const Double_t *psiVal, Int_t *index, Int_t iPt=0) const;
 
   Int_t       InitEventPools(Int_t depth, 
                 Int_t nMultBins, Double_t *multbin, 
@@ -241,8 +448,11 @@ public:
                 Int_t nPtBins, Double_t *ptbin);
   
   void        SetTargetTrackDepth(Int_t d) { fTargetTrackDepth = d;} // Same as for G.E.P. class
+  // <trk> is owned by the manager after the call (one copy per pool), as for StEventPool::UpdatePool()
   Int_t       UpdatePools(TObjArray *trk);
+  Int_t       UpdatePools(TObjArray *trk, Double_t centVal, Double_t zvtxVal, Double_t psiVal=0., Int_t iPt=0);
   void        SetDebug(Bool_t b) { fDebug = b; }
+  void        SetUseRingBuffer(Bool_t b, Int_t trackCapacity = 0);
   void        SetTargetValues(Int_t trackDepth, Float_t fraction, Int_t events);
   Int_t       GetNumberOfAllBins() {return fNPtBins*fNMultBins*fNZvtxBins*fNPsiBins;}
   Int_t       GetNumberOfPtBins() {return fNPtBins;}
@@ -251,6 +461,19 @@ public:
   Int_t       GetNumberOfPsiBins() {return fNPsiBins;}
 
   void        Validate();
+
+  // pool snapshot: export of the filled pools, read-only memory mapped import
+  Int_t       WritePoolSnapshot(const char *fileName, Bool_t onlyReady = kTRUE) const;
+  Int_t       ReadPoolSnapshot(const char *fileName, Bool_t lock = kTRUE);
+  void        DetachSnapshot(Bool_t copy = kTRUE);
+
+  // memory: budget over all pools (bytes, 0: none), shared by demand; 16 bit track storage
+  void        SetMemoryBudget(Long64_t bytes, Int_t interval = 10000);
+  Long64_t    GetMemoryBudget()            const { return fMemoryBudget; }
+  void        BalanceMemory();
+  void        PoolUpdated()                      { if (fMemoryBudget > 0 && ++fNUpdates % fBalanceInterval == 0) BalanceMemory(); }
+  void        SetQuantizedStorage(Bool_t b);
+  Long64_t    GetMemoryUsage()             const;
   void        ClearPools();
   void        ClearPools(Double_t minCent, Double_t maxCent,  Double_t minZvtx, Double_t maxZvtx, Double_t minPsi, Double_t maxPsi, Double_t minPt, Double_t maxPt);
   void        SetSaveFlag(Double_t minCent, Double_t maxCent,  Double_t minZvtx, Double_t maxZvtx, Double_t minPsi, Double_t maxPsi, Double_t minPt, Double_t maxPt);
@@ -270,10 +493,27 @@ public:
   std::vector<StEventPool*> fEvPool;                    // pool in bins of [fNMultBin][fNZvtxBin][fNPsiBin][fNPtBins]
   Int_t      fTargetTrackDepth;                         // Required track size, same for all pools.
 
+  Bool_t     fMultUniform;                              // mult bins equidistant (fast path of FindBin)
+  Bool_t     fZvtxUniform;                              // vertex bins equidistant
+  Bool_t     fPsiUniform;                               // Event plane angle (Psi) bins equidistant
+  Double_t   fMultInvWidth;                             // 1 / mult bin width (uniform bins)
+  Double_t   fZvtxInvWidth;                             // 1 / vertex bin width (uniform bins)
+  Double_t   fPsiInvWidth;                              // 1 / Psi bin width (uniform bins)
+
+  void      *fSnapshotMap;                              //! memory mapped pool snapshot
+  Long64_t   fSnapshotSize;                             //! size of mapped snapshot
+
+  Long64_t   fMemoryBudget;                             // bytes for the tracks of all pools (0: no limit)
+  Int_t      fBalanceInterval;                          // pool updates between BalanceMemory() calls
+  Bool_t     fQuantized;                                // pools use quantized track storage
+  Long64_t   fNUpdates;                                 //! pool updates
+
   Int_t       GetBinIndex(Int_t iMult, Int_t iZvtx, Int_t iPsi, Int_t iPt) const {return fNZvtxBins*fNPsiBins*fNPtBins*iMult + fNPsiBins*fNPtBins*iZvtx + fNPtBins*iPsi + iPt;}
   Double_t*   GetBinning(const char* configuration, const char* tag, Int_t& nBins) const;
+  static Bool_t IsUniformBinning(const std::vector<Double_t> &edges, Double_t &invWidth);
+  static Int_t  FindBin(const std::vector<Double_t> &edges, Double_t x, Bool_t uniform, Double_t invWidth);
 
-  ClassDef(StEventPoolManager,1)
+  ClassDef(StEventPoolManager,3)
 };
 
 #endif
@@ -16,6 +16,54 @@
 class StFJWrapper
 {
  public:
+  // one step of the primary C/A declustering of a jet (following the harder branch)
+  struct StDeclusterStep {
+    Double_t fPt;        // pt of the subjet declustered in this step
+    Double_t fM;         // mass of the subjet declustered in this step
+    Double_t fZ;         // pt softer / (pt harder + pt softer)
+    Double_t fDeltaR;    // distance between harder and softer branch
+    Double_t fKt;        // pt softer * deltaR
+  };
+  // SoftDrop result of one (z_cut, beta) setting
+  struct StSoftDropResult {
+    Double_t fZg;        // z of first splitting passing the condition, 0 = none
+    Double_t fRg;        // deltaR of that splitting, 0 = none
+    Double_t fMg;        // groomed jet mass
+    Double_t fPtg;       // groomed jet pt
+    Int_t    fNDropped;  // splittings dropped before
+  };
+  // jet shapes filled by GetJetShapes (observables not requested are left at 0)
+  struct StJetShapeResult {
+    Double_t fMass;          // jet mass
+    Double_t fAngularity;    // sum pt_i dR_i / sum pt_i
+    Double_t fpTD;           // sqrt(sum pt_i^2) / sum pt_i
+    Double_t fCircularity;   // 2 x minor eigenvalue of the normalised transverse momentum tensor
+    Double_t fSigma2;        // minor axis of the pt^2 weighted (eta, phi) tensor
+    Double_t fLeSub;         // pt leading - pt subleading constituent
+    Int_t    fNConst;        // number of (real) constituents
+  };
+  // N-subjettiness (NormalizedMeasure) with exclusive kt axes, filled by GetSubjettiness
+  struct StSubjettinessResult {
+    Double_t fTau1;
+    Double_t fTau2;
+    Double_t fTau3;
+    Double_t fTau21;         // tau2/tau1, 0 if tau1 = 0
+    Double_t fTau32;         // tau3/tau2, 0 if tau2 = 0
+    Double_t fOpeningAngle;  // eta-phi distance of the 2 subjet axes, -2 if less than 2 constituents
+  };
+  // observables of GetJetShapes
+  enum EJetShape {
+    kShapeMass        = 1<<0,
+    kShapeAngularity  = 1<<1,
+    kShapepTD         = 1<<2,
+    kShapeCircularity = 1<<3,
+    kShapeSigma2      = 1<<4,
+    kShapeLeSub       = 1<<5,
+    kShapeConstituent = 1<<6,
+    kShapeGR          = 1<<7,   // angular structure numerator/denominator, see SetRMaxAndStep
+    kShapeAll         = 0xff
+  };
+
   StFJWrapper(const char *name, const char *title);
   virtual ~StFJWrapper();
 
@@ -26,6 +74,8 @@ class StFJWrapper
   virtual const char *ClassName()                            const { return "StFJWrapper";              }
   virtual void  Clear(const Option_t* /*opt*/ = "");
   virtual void  ClearMemory();
+  virtual void  ClearDefinitions();
+  virtual Int_t InitDefinitions();
   virtual void  CopySettingsFrom (const StFJWrapper& wrapper);
   virtual void  GetMedianAndSigma(Double_t& median, Double_t& sigma, Int_t remove = 0) const;
   fastjet::ClusterSequenceArea*           GetClusterSequence() const   { return fClustSeq;                 }
@@ -36,6 +86,7 @@ class StFJWrapper
   const std::vector<fastjet::PseudoJet>&  GetInclusiveJets()   const { return fInclusiveJets;              }
   const std::vector<fastjet::PseudoJet>&  GetFilteredJets()    const { return fFilteredJets;               }
   std::vector<fastjet::PseudoJet>         GetJetConstituents(UInt_t idx) const;
+  void                                    GetJetConstituents(UInt_t idx, std::vector<fastjet::PseudoJet>& constituents) const;
   std::vector<fastjet::PseudoJet>         GetFilteredJetConstituents(UInt_t idx) const;
   Double_t                                GetMedianUsedForBgSubtraction() const { return fMedUsedForBgSub; }
   const char*                             GetName()            const { return fName;                       }
@@ -48,6 +99,8 @@ class StFJWrapper
   virtual std::vector<double>             GetSubtractedJetsPts(Double_t median_pt = -1, Bool_t sorted = kFALSE);
   Bool_t                                  GetLegacyMode()            { return fLegacyMode; }
   Bool_t                                  GetDoFilterArea()          { return fDoFilterArea; }
+  Bool_t                                  GetDefinitionsValid() const { return fDefinitionsValid; }
+  Int_t                                   GetFixedGhostSeed()   const { return fGhostSeed; }
   Double_t                                NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Int_t Option=0);
   Double32_t                              NSubjettinessDerivativeSub(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Double_t JetR, fastjet::PseudoJet jet, Int_t Option=0);
 #ifdef FASTJET_VERSION
@@ -94,33 +147,68 @@ class StFJWrapper
   virtual Int_t DoGenericSubtractionJetOpeningAngle_kt();
 */
   virtual Int_t DoConstituentSubtraction();
+  virtual Int_t SubtractEventConstituents();
   virtual Int_t DoSoftDrop();
+
+  // C/A declustering history of inclusive jet ijet: built once per jet and event (on first use),
+  // SoftDrop settings, Lund plane, groomed mass and Rg are then read from it without reclustering
+  virtual Int_t DeclusterJet(UInt_t ijet);
+  const StDeclusterStep& GetDeclusterStep(UInt_t ijet, Int_t istep) const { return fDeclSteps[fDeclFirst[ijet] + istep]; }
+  Int_t GetSoftDrop(UInt_t ijet, Double_t zcut, Double_t beta, StSoftDropResult &result, Double_t R0 = 1.0);
+  Int_t GetSoftDrop(UInt_t ijet, const std::vector<Double_t> &zcuts, const std::vector<Double_t> &betas,
+                    std::vector<StSoftDropResult> &results, Double_t R0 = 1.0);
+  Int_t GetLundPlane(UInt_t ijet, std::vector<Double_t> &lnInvDeltaR, std::vector<Double_t> &lnKt);
+
+  // jet shapes (unsubtracted) of inclusive jet ijet, all requested observables (EJetShape mask)
+  // from one walk over the constituents. kShapeGR fills GetGRNumerator()/GetGRDenominator()
+  // with GetNGRBins() bins; the all-jets version stores jet ijet at [ijet*GetNGRBins()]
+  Int_t GetJetShapes(UInt_t ijet, StJetShapeResult &result, UInt_t mask = kShapeAll);
+  Int_t GetJetShapes(std::vector<StJetShapeResult> &results, UInt_t mask = kShapeAll);
+  Int_t GetNGRBins() const { return (fDRStep > 0) ? TMath::FloorNint(fRMax/fDRStep) : 0; }
+
+  // N = 1, 2, 3 subjettiness and opening angle from a single exclusive kt reclustering:
+  // the axes of inclusive jet ijet are kept for the event (R0 < 0: jet radius), those of
+  // an external jet (derivative subtraction) until a different jet is passed
+  Int_t GetSubjettiness(UInt_t ijet, StSubjettinessResult &result, Double_t beta = 1.0, Double_t R0 = -1.);
+  Int_t GetSubjettiness(const fastjet::PseudoJet &jet, StSubjettinessResult &result, Double_t beta = 1.0, Double_t R0 = 0.4);
   
   void SetName(const char* name)        { fName           = name;    }
   void SetTitle(const char* title)      { fTitle          = title;   }
-  void SetStrategy(const fastjet::Strategy &strat)                 { fStrategy = strat;  }
-  void SetAlgorithm(const fastjet::JetAlgorithm &algor)            { fAlgor    = algor;  }
-  void SetRecombScheme(const fastjet::RecombinationScheme &scheme) { fScheme   = scheme; }
-  void SetAreaType(const fastjet::AreaType &atype)                 { fAreaType = atype;  }
-  void SetNRepeats(Int_t nrepeat)       { fNGhostRepeats  = nrepeat; }
-  void SetGhostArea(Double_t gharea)    { fGhostArea      = gharea;  }
-  void SetMaxRap(Double_t maxrap)       { fMaxRap         = maxrap;  }
-  void SetR(Double_t r)                 { fR              = r;       }
-  void SetGridScatter(Double_t gridSc)  { fGridScatter    = gridSc;  }
-  void SetKtScatter(Double_t ktSc)      { fKtScatter      = ktSc;    }
-  void SetMeanGhostKt(Double_t meankt)  { fMeanGhostKt    = meankt;  }
-  void SetPluginAlgor(Int_t plugin)     { fPluginAlgor    = plugin;  }
+  // the jet, area and range definitions are built once and kept between events:
+  // changing one of these settings rebuilds them on the next Run()
+  void SetStrategy(const fastjet::Strategy &strat)                 { fStrategy = strat;  fDefinitionsValid = kFALSE; }
+  void SetAlgorithm(const fastjet::JetAlgorithm &algor)            { fAlgor    = algor;  fDefinitionsValid = kFALSE; }
+  void SetRecombScheme(const fastjet::RecombinationScheme &scheme) { fScheme   = scheme; fDefinitionsValid = kFALSE; }
+  void SetAreaType(const fastjet::AreaType &atype)                 { fAreaType = atype;  fDefinitionsValid = kFALSE; }
+  void SetNRepeats(Int_t nrepeat)       { fNGhostRepeats  = nrepeat; fDefinitionsValid = kFALSE; }
+  void SetGhostArea(Double_t gharea)    { fGhostArea      = gharea;  fDefinitionsValid = kFALSE; }
+  void SetMaxRap(Double_t maxrap)       { fMaxRap         = maxrap;  fDefinitionsValid = kFALSE; fCSGhostRap.clear(); }
+  void SetR(Double_t r)                 { fR              = r;       fDefinitionsValid = kFALSE; }
+  void SetGridScatter(Double_t gridSc)  { fGridScatter    = gridSc;  fDefinitionsValid = kFALSE; }
+  void SetKtScatter(Double_t ktSc)      { fKtScatter      = ktSc;    fDefinitionsValid = kFALSE; }
+  void SetMeanGhostKt(Double_t meankt)  { fMeanGhostKt    = meankt;  fDefinitionsValid = kFALSE; }
+  void SetPluginAlgor(Int_t plugin)     { fPluginAlgor    = plugin;  fDefinitionsValid = kFALSE; }
   void SetUseArea4Vector(Bool_t useA4v) { fUseArea4Vector = useA4v;  }
+  // > 0: same seeded ghosts every event. FastJet keeps one static ghost generator for all
+  // GhostedAreaSpecs: Run() replays the checkpoint of this wrapper and then restores the
+  // generator, so other wrappers keep their random ghosts. Not thread safe: wrappers sharing
+  // the generator must not run concurrently
+  void SetFixedGhosts(Int_t seed)       { fGhostSeed      = seed;    fDefinitionsValid = kFALSE; }
   void SetupAlgorithmfromOpt(const char *option);
   void SetupAreaTypefromOpt(const char *option);
   void SetupSchemefromOpt(const char *option);
   void SetupStrategyfromOpt(const char *option);
-  void SetLegacyMode (Bool_t mode)      { fLegacyMode ^= mode; }
+  void SetLegacyMode (Bool_t mode)      { fLegacyMode ^= mode; fDefinitionsValid = kFALSE; }
   void SetLegacyFJ();
   void SetUseExternalBkg(Bool_t b, Double_t rho, Double_t rhom) { fUseExternalBkg = b; fRho = rho; fRhom = rhom;}
   void SetRMaxAndStep(Double_t rmax, Double_t dr) {fRMax = rmax; fDRStep = dr; }
   void SetRhoRhom (Double_t rho, Double_t rhom) { fUseExternalBkg = kTRUE; fRho = rho; fRhom = rhom;} // if using rho,rhom then fUseExternalBkg is true
   void SetMinJetPt(Double_t MinPt) {fMinJetPt=MinPt;}
+  // event-wide constituent subtraction (SubtractEventConstituents): max particle-ghost distance,
+  // distance weight pt^alpha and area of the ghost grid
+  void SetEventSubtractionParameters(Double_t maxDeltaR, Double_t alpha = 0., Double_t ghostArea = 0.01)
+    { fCSMaxDeltaR = maxDeltaR; fCSAlpha = alpha; fCSGhostArea = ghostArea; fCSGhostRap.clear(); }
+  Int_t GetNEventSubtractionPairs() const { return fCSPairs.size(); }
 
  protected:
   TString                                fName;               //!
@@ -198,6 +286,64 @@ class StFJWrapper
   std::vector<double>                      fGRDenominator;    //!
   std::vector<double>                      fGRNumeratorSub;   //!
   std::vector<double>                      fGRDenominatorSub; //!
+  Bool_t                                   fDefinitionsValid; //! jet/area/range definitions built for current settings
+  Int_t                                    fGhostSeed;        //! seed of fixed ghosts, <= 0: new random ghosts every event
+  // event-wide constituent subtraction
+  struct StCSPair {
+    Double_t fDist;    // pt^(2 alpha) * deltaR^2
+    Int_t    fPart;    // input vector index
+    Int_t    fGhost;   // ghost index
+    bool operator<(const StCSPair &other) const { return fDist < other.fDist; }
+  };
+  Double_t                                 fCSMaxDeltaR;      //! max particle-ghost distance
+  Double_t                                 fCSAlpha;          //! distance weight pt^alpha
+  Double_t                                 fCSGhostArea;      //! area of ghost grid cell
+  Double_t                                 fCSGhostCellArea;  //! actual ghost area (grid covers |y| < fMaxRap exactly)
+  std::vector<Double_t>                    fCSGhostRap;       //! ghost grid, kept while the settings are unchanged
+  std::vector<Double_t>                    fCSGhostPhi;       //!
+  std::vector<Double_t>                    fCSGhostPt;        //! per event: ghost pt left
+  std::vector<Double_t>                    fCSGhostMd;        //! per event: ghost (mt - pt) left
+  std::vector<Double_t>                    fCSPartPt;         //! per event: particle pt left
+  std::vector<Double_t>                    fCSPartMd;         //! per event: particle (mt - pt) left
+  std::vector<Int_t>                       fCSCellHead;       //! particle grid index: first particle of cell
+  std::vector<Int_t>                       fCSNext;           //! particle grid index: next particle of same cell
+  std::vector<StCSPair>                    fCSPairs;          //! particle-ghost pairs within fCSMaxDeltaR
+  std::vector<fastjet::PseudoJet>          fCSOutput;         //! subtracted particles
+  // C/A declustering cache (per event)
+  std::vector<StDeclusterStep>             fDeclSteps;        //! steps of all declustered jets
+  std::vector<Int_t>                       fDeclFirst;        //! first step of inclusive jet, -1 = not declustered
+  std::vector<Int_t>                       fDeclN;            //! number of steps of inclusive jet (-1: declustering failed)
+  std::vector<Double_t>                    fDeclLeafPt;       //! pt of last harder branch (single constituent)
+  std::vector<Double_t>                    fDeclLeafM;        //! mass of last harder branch
+  std::vector<fastjet::PseudoJet>          fDeclConstituents; //! constituents of jet being declustered
+  // jet shape engine buffers (per jet)
+  std::vector<fastjet::PseudoJet>          fShapeConstituents;//! constituents of jet being evaluated
+  std::vector<Double_t>                    fShapePt;          //! pt of real constituents
+  std::vector<Double_t>                    fShapeEta;         //! eta of real constituents
+  std::vector<Double_t>                    fShapePhi;         //! phi of real constituents
+
+  // exclusive kt subjet cache: axes N=1 at [0], N=2 at [1,2], N=3 at [3,5]
+  std::vector<fastjet::PseudoJet>          fSubjetAxes;       //! 6 axes per inclusive jet
+  std::vector<Int_t>                       fSubjetNConst;     //! constituents of inclusive jet, -1 = not reclustered
+  // external jet cache: the ghost-shifted jets of the derivative subtraction differ only in the
+  // ghost momenta, the four-momentum and number of constituents identify (jet, ghost scale)
+  enum { kSubjetCacheSize = 256 };   // shifted jets kept, enough for the per-shape loops over the jets
+  struct StSubjetCacheEntry {
+    fastjet::PseudoJet   fJet;       // four-momentum of the (shifted) jet
+    Int_t                fNConst;    // number of constituents
+    Double_t             fBeta;
+    Double_t             fR0;
+    StSubjettinessResult fResult;
+  };
+  std::vector<StSubjetCacheEntry>          fSubjetCache;      //! last kSubjetCacheSize external jets
+  UInt_t                                   fSubjetCacheNext;  //! slot overwritten next when full
+
+  void           ResetDeclusterings();
+  void           AddJetShapeGR();
+  Int_t          FindExclusiveSubjets(const std::vector<fastjet::PseudoJet> &constituents, fastjet::PseudoJet *axes);
+  void           ComputeSubjettiness(const std::vector<fastjet::PseudoJet> &constituents, const fastjet::PseudoJet *axes,
+                                     Double_t beta, Double_t R0, StSubjettinessResult &result) const;
+  static Double_t SelectSubjettiness(const StSubjettinessResult &result, Int_t N, Int_t Option);
 
   virtual void   SubtractBackground(const Double_t median_pt = -1);
 
@@ -286,6 +432,36 @@ StFJWrapper::StFJWrapper(const char *name, const char *title)
   , fGRDenominator()
   , fGRNumeratorSub()
   , fGRDenominatorSub()
+  , fDefinitionsValid(kFALSE)
+  , fGhostSeed(0)
+  , fCSMaxDeltaR(0.25)
+  , fCSAlpha(0.)
+  , fCSGhostArea(0.01)
+  , fCSGhostCellArea(0.)
+  , fCSGhostRap()
+  , fCSGhostPhi()
+  , fCSGhostPt()
+  , fCSGhostMd()
+  , fCSPartPt()
+  , fCSPartMd()
+  , fCSCellHead()
+  , fCSNext()
+  , fCSPairs()
+  , fCSOutput()
+  , fDeclSteps()
+  , fDeclFirst()
+  , fDeclN()
+  , fDeclLeafPt()
+  , fDeclLeafM()
+  , fDeclConstituents()
+  , fShapeConstituents()
+  , fShapePt()
+  , fShapeEta()
+  , fShapePhi()
+  , fSubjetAxes()
+  , fSubjetNConst()
+  , fSubjetCache()
+  , fSubjetCacheNext(0)
 {
   // Constructor.
 }
@@ -295,29 +471,40 @@ StFJWrapper::~StFJWrapper()
 {
   // Destructor.
   ClearMemory();
+  ClearDefinitions();
 }
 
 //_________________________________________________________________________________________________
 void StFJWrapper::ClearMemory()
 {
-  // Destructor.
-  if (fAreaDef)           { delete fAreaDef;           fAreaDef         = NULL; }
-  if (fVorAreaSpec)       { delete fVorAreaSpec;       fVorAreaSpec     = NULL; }
-  if (fGhostedAreaSpec)   { delete fGhostedAreaSpec;   fGhostedAreaSpec = NULL; }
-  if (fJetDef)            { delete fJetDef;            fJetDef          = NULL; }
-  if (fPlugin)            { delete fPlugin;            fPlugin          = NULL; }
-  if (fRange)             { delete fRange;             fRange           = NULL; }
+  // Delete the per-event objects (cluster sequences).
+  // The jet, area and range definitions are kept, see ClearDefinitions().
   if (fClustSeq)          { delete fClustSeq;          fClustSeq        = NULL; }
   if (fClustSeqSA)        { delete fClustSeqSA;        fClustSeqSA        = NULL; }
   if (fClustSeqActGhosts) { delete fClustSeqActGhosts; fClustSeqActGhosts = NULL; }
   #ifdef FASTJET_VERSION
-  if (fBkrdEstimator)          { delete fBkrdEstimator; fBkrdEstimator = NULL; }
 ////  if (fGenSubtractor)          { delete fGenSubtractor; fGenSubtractor = NULL; }
   if (fConstituentSubtractor)  { delete fConstituentSubtractor; fConstituentSubtractor = NULL; }
   if (fSoftDrop)          { delete fSoftDrop; fSoftDrop = NULL;}
   #endif
 }
 
+//_________________________________________________________________________________________________
+void StFJWrapper::ClearDefinitions()
+{
+  // Delete the jet, area and range definitions (rebuilt on the next Run()).
+  if (fAreaDef)           { delete fAreaDef;           fAreaDef         = NULL; }
+  if (fVorAreaSpec)       { delete fVorAreaSpec;       fVorAreaSpec     = NULL; }
+  if (fGhostedAreaSpec)   { delete fGhostedAreaSpec;   fGhostedAreaSpec = NULL; }
+  if (fJetDef)            { delete fJetDef;            fJetDef          = NULL; }
+  if (fPlugin)            { delete fPlugin;            fPlugin          = NULL; }
+  if (fRange)             { delete fRange;             fRange           = NULL; }
+  #ifdef FASTJET_VERSION
+  if (fBkrdEstimator)     { delete fBkrdEstimator;     fBkrdEstimator   = NULL; }
+  #endif
+  fDefinitionsValid = kFALSE;
+}
+
 //_________________________________________________________________________________________________
 void StFJWrapper::CopySettingsFrom(const StFJWrapper& wrapper)
 {
@@ -344,6 +531,12 @@ void StFJWrapper::CopySettingsFrom(const StFJWrapper& wrapper)
   fUseExternalBkg   = wrapper.fUseExternalBkg;
   fRho              = wrapper.fRho;
   fRhom             = wrapper.fRhom;
+  fGhostSeed        = wrapper.fGhostSeed;
+  fCSMaxDeltaR      = wrapper.fCSMaxDeltaR;
+  fCSAlpha          = wrapper.fCSAlpha;
+  fCSGhostArea      = wrapper.fCSGhostArea;
+  fCSGhostRap.clear();
+  fDefinitionsValid = kFALSE;
 }
 
 //_________________________________________________________________________________________________
@@ -356,8 +549,9 @@ void StFJWrapper::Clear(const Option_t */*opt*/)
   fInputVectors.clear();
   fInputGhosts.clear();
   fMedUsedForBgSub = 0;
+  ResetDeclusterings();
 
-  // for the moment brute force delete everything
+  // delete the cluster sequences: the definitions are kept for the next event
   ClearMemory();
 }
 
@@ -533,6 +727,21 @@ StFJWrapper::GetJetConstituents(UInt_t idx) const
   return retval;
 }
 
+//_________________________________________________________________________________________________
+void
+StFJWrapper::GetJetConstituents(UInt_t idx, std::vector<fastjet::PseudoJet>& constituents) const
+{
+  // Get jets constituents into an existing vector (keeps its capacity).
+
+  constituents.clear();
+
+  if ( idx < fInclusiveJets.size() ) {
+    fClustSeq->add_constituents(fInclusiveJets[idx], constituents);
+  } else {
+    __ERROR(Form("Wrong index: %d",idx));
+  }
+}
+
 //_________________________________________________________________________________________________
 std::vector<fastjet::PseudoJet>
 StFJWrapper::GetFilteredJetConstituents(UInt_t idx) const
@@ -580,9 +789,15 @@ void StFJWrapper::GetMedianAndSigma(Double_t &median, Double_t &sigma, Int_t rem
 }
 
 //_________________________________________________________________________________________________
-Int_t StFJWrapper::Run()
+Int_t StFJWrapper::InitDefinitions()
 {
-  // Run the actual jet finder.
+  // Build the jet, area and range definitions for the current settings.
+  // Done once (e.g. at Init) and kept between events: Run() only rebuilds
+  // them after a setting was changed.
+  // Cluster sequences made with the old definitions are deleted as well.
+
+  ClearMemory();
+  ClearDefinitions();
 
   if (fAreaType == fj::voronoi_area) {
     // Rfact - check dependence - default is 1.
@@ -597,6 +812,20 @@ Int_t StFJWrapper::Run()
                                                fKtScatter,
                                                fMeanGhostKt);
 
+    // fixed ghosts: seed the ghost generator once and replay the same ghosts every event.
+    // The generator is static in GhostedAreaSpec (shared by all wrappers): its status is
+    // restored after the checkpoint here and after every Run(), see SetFixedGhosts()
+    if (fGhostSeed > 0) {
+      std::vector<int> savedStatus;
+      fGhostedAreaSpec->get_random_status(savedStatus);
+      std::vector<int> seeds(2);
+      seeds[0] = fGhostSeed;
+      seeds[1] = fGhostSeed + 1;
+      fGhostedAreaSpec->set_random_status(seeds);
+      fGhostedAreaSpec->checkpoint_random();
+      fGhostedAreaSpec->set_random_status(savedStatus);
+    }
+
     fAreaDef = new fj::AreaDefinition(*fGhostedAreaSpec, fAreaType);
   }
 
@@ -628,18 +857,12 @@ Int_t StFJWrapper::Run()
       fJetDef = new fastjet::JetDefinition(fPlugin);
     } else {
      __ERROR(Form("Unrecognized plugin number!"));
+     return -1;
     }
   } else {
     fJetDef = new fj::JetDefinition(fAlgor, fR, fScheme, fStrategy);
   }
 
-  try {
-    fClustSeq = new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
-  } catch (fj::Error) {
-    __ERROR(Form("FJ Exception caught."));
-    return -1;
-  }
-
   // FJ3 :: Define an JetMedianBackgroundEstimator just in case it will be used
 #ifdef FASTJET_VERSION
   fBkrdEstimator     = new fj::JetMedianBackgroundEstimator(fj::SelectorAbsRapMax(fMaxRap));
@@ -647,9 +870,41 @@ Int_t StFJWrapper::Run()
 
   if (fLegacyMode) { SetLegacyFJ(); } // for FJ 2.x even if fLegacyMode is set, SetLegacyFJ is dummy
 
+  fDefinitionsValid = kTRUE;
+  return 0;
+}
+
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::Run()
+{
+  // Run the actual jet finder.
+
+  // definitions are only (re)built when a setting changed
+  if (!fDefinitionsValid && (InitDefinitions() != 0)) return -1;
+
+  // fixed ghosts: same ghost set as in the previous events. The shared ghost generator is
+  // put back to its status before this Run(), so the random ghosts of other wrappers go on
+  // as if this wrapper had not drawn any
+  const Bool_t fixedGhosts = (fGhostSeed > 0) && fGhostedAreaSpec;
+  std::vector<int> savedStatus;
+  if (fixedGhosts) {
+    fGhostedAreaSpec->get_random_status(savedStatus);
+    fGhostedAreaSpec->restore_checkpoint_random();
+  }
+
+  try {
+    fClustSeq = new fj::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
+  } catch (fj::Error) {
+    if (fixedGhosts) fGhostedAreaSpec->set_random_status(savedStatus);
+    __ERROR(Form("FJ Exception caught."));
+    return -1;
+  }
+  if (fixedGhosts) fGhostedAreaSpec->set_random_status(savedStatus);
+
   // inclusive jets:
   fInclusiveJets.clear();
   fInclusiveJets = fClustSeq->inclusive_jets(0.0);
+  ResetDeclusterings();
 
   return 0;
 }
@@ -661,13 +916,14 @@ Int_t StFJWrapper::Filter()
 //  StFJWrapper::Filter
 //
 
-  fJetDef = new fj::JetDefinition(fAlgor, fR, fScheme, fStrategy);
+  // local definition: the persistent fJetDef is kept for Run()
+  fj::JetDefinition jetDef(fAlgor, fR, fScheme, fStrategy);
 
   if (fDoFilterArea) {
     if (fInputGhosts.size()>0) {
       try {
         fClustSeqActGhosts = new fj::ClusterSequenceActiveAreaExplicitGhosts(fInputVectors,
-                                                                           *fJetDef,
+                                                                            jetDef,
                                                                             fInputGhosts,
                                                                             fGhostArea);
       } catch (fj::Error) {
@@ -682,7 +938,7 @@ Int_t StFJWrapper::Filter()
     }
   } else {
     try {
-      fClustSeqSA = new fastjet::ClusterSequence(fInputVectors, *fJetDef);
+      fClustSeqSA = new fastjet::ClusterSequence(fInputVectors, jetDef);
     } catch (fj::Error) {
       __WARNING(Form("FJ Exception caught."));
       return -1;
@@ -789,6 +1045,452 @@ Int_t StFJWrapper::DoConstituentSubtraction() {
   return 0;
 }
 
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::SubtractEventConstituents()
+{
+  // Event-wide constituent subtraction of the input vectors, before Run().
+  // Ghosts on a fixed eta-phi grid (|y| < fMaxRap) carry pt = fRho*A and (mt - pt) = fRhom*A
+  // (set with SetRhoRhom(), e.g. from the rho maker). Particle-ghost pairs closer than
+  // fCSMaxDeltaR are found through a grid index of the particles (cells >= fCSMaxDeltaR,
+  // only the 3x3 neighbouring cells are searched), sorted by pt^alpha*deltaR and pt
+  // (and mt - pt) is moved from the particle to the ghost pair by pair.
+  // Particles without pt left are removed, the user index of the others is kept.
+  // Returns the number of removed particles.
+
+  const Int_t nPart = fInputVectors.size();
+  if (nPart == 0) return 0;
+  if (fCSMaxDeltaR <= 0 || fCSGhostArea <= 0) return 0;
+
+  const Double_t twoPi = TMath::TwoPi();
+
+  // ghost grid: built once for the settings
+  if (fCSGhostRap.empty()) {
+    Int_t nRap = TMath::Max(1, TMath::CeilNint(2.*fMaxRap / TMath::Sqrt(fCSGhostArea)));
+    Int_t nPhi = TMath::Max(1, TMath::CeilNint(twoPi / TMath::Sqrt(fCSGhostArea)));
+    Double_t dRap = 2.*fMaxRap / nRap;
+    Double_t dPhi = twoPi / nPhi;
+    fCSGhostCellArea = dRap * dPhi;
+    fCSGhostRap.reserve(nRap*nPhi);
+    fCSGhostPhi.reserve(nRap*nPhi);
+    for (Int_t ir = 0; ir < nRap; ir++) {
+      for (Int_t ip = 0; ip < nPhi; ip++) {
+        fCSGhostRap.push_back(-fMaxRap + (ir + 0.5)*dRap);
+        fCSGhostPhi.push_back((ip + 0.5)*dPhi);
+      }
+    }
+  }
+  const Int_t nGhost = fCSGhostRap.size();
+  fCSGhostPt.assign(nGhost, fRho  * fCSGhostCellArea);
+  fCSGhostMd.assign(nGhost, fRhom * fCSGhostCellArea);
+
+  // particle grid index: cells at least fCSMaxDeltaR wide
+  const Int_t nCellRap = TMath::Max(1, (Int_t)(2.*fMaxRap / fCSMaxDeltaR));
+  const Int_t nCellPhi = TMath::Max(1, (Int_t)(twoPi / fCSMaxDeltaR));
+  const Double_t cellRap = 2.*fMaxRap / nCellRap;
+  const Double_t cellPhi = twoPi / nCellPhi;
+  fCSCellHead.assign(nCellRap*nCellPhi, -1);
+  fCSNext.assign(nPart, -1);
+  fCSPartPt.resize(nPart);
+  fCSPartMd.resize(nPart);
+  for (Int_t i = 0; i < nPart; i++) {
+    const fj::PseudoJet &part = fInputVectors[i];
+    fCSPartPt[i] = part.perp();
+    fCSPartMd[i] = part.mperp() - fCSPartPt[i];
+
+    // outside the ghost grid: not subtracted
+    Double_t rap = part.rap();
+    if (TMath::Abs(rap) >= fMaxRap) continue;
+    Int_t ir = TMath::Min(nCellRap - 1, (Int_t)((rap + fMaxRap) / cellRap));
+    Int_t ip = TMath::Min(nCellPhi - 1, (Int_t)(part.phi() / cellPhi)); // phi in [0, 2pi)
+    Int_t icell = ir*nCellPhi + ip;
+    fCSNext[i] = fCSCellHead[icell];
+    fCSCellHead[icell] = i;
+  }
+
+  // particle-ghost pairs within fCSMaxDeltaR
+  const Double_t maxDR2 = fCSMaxDeltaR*fCSMaxDeltaR;
+  fCSPairs.clear();
+  for (Int_t ig = 0; ig < nGhost; ig++) {
+    Double_t grap = fCSGhostRap[ig];
+    Double_t gphi = fCSGhostPhi[ig];
+    Int_t ir0 = TMath::Min(nCellRap - 1, (Int_t)((grap + fMaxRap) / cellRap));
+    Int_t ip0 = TMath::Min(nCellPhi - 1, (Int_t)(gphi / cellPhi));
+
+    for (Int_t ir = TMath::Max(0, ir0 - 1); ir <= TMath::Min(nCellRap - 1, ir0 + 1); ir++) {
+      // neighbouring phi cells, wrapped (each cell once for small grids)
+      Int_t nDphi = TMath::Min(3, nCellPhi);
+      for (Int_t jp = 0; jp < nDphi; jp++) {
+        Int_t ip = (ip0 - 1 + jp + nCellPhi) % nCellPhi;
+        if (nCellPhi < 3) ip = jp;
+
+        for (Int_t i = fCSCellHead[ir*nCellPhi + ip]; i >= 0; i = fCSNext[i]) {
+          Double_t drap = fInputVectors[i].rap() - grap;
+          Double_t dphi = TMath::Abs(fInputVectors[i].phi() - gphi);
+          if (dphi > TMath::Pi()) dphi = twoPi - dphi;
+          Double_t dr2 = drap*drap + dphi*dphi;
+          if (dr2 >= maxDR2) continue;
+
+          StCSPair csPair;
+          csPair.fDist  = (fCSAlpha != 0.) ? dr2 * TMath::Power(fCSPartPt[i], 2.*fCSAlpha) : dr2;
+          csPair.fPart  = i;
+          csPair.fGhost = ig;
+          fCSPairs.push_back(csPair);
+        }
+      }
+    }
+  }
+
+  // subtraction: closest pairs first
+  std::sort(fCSPairs.begin(), fCSPairs.end());
+  for (UInt_t ip = 0; ip < fCSPairs.size(); ip++) {
+    const Int_t i  = fCSPairs[ip].fPart;
+    const Int_t ig = fCSPairs[ip].fGhost;
+
+    if (fCSPartPt[i] > 0 && fCSGhostPt[ig] > 0) {
+      if (fCSPartPt[i] >= fCSGhostPt[ig]) { fCSPartPt[i] -= fCSGhostPt[ig]; fCSGhostPt[ig] = 0; }
+      else                                { fCSGhostPt[ig] -= fCSPartPt[i]; fCSPartPt[i] = 0; }
+    }
+    if (fCSPartMd[i] > 0 && fCSGhostMd[ig] > 0) {
+      if (fCSPartMd[i] >= fCSGhostMd[ig]) { fCSPartMd[i] -= fCSGhostMd[ig]; fCSGhostMd[ig] = 0; }
+      else                                { fCSGhostMd[ig] -= fCSPartMd[i]; fCSPartMd[i] = 0; }
+    }
+  }
+
+  // subtracted particles replace the input vectors
+  fCSOutput.clear();
+  for (Int_t i = 0; i < nPart; i++) {
+    const fj::PseudoJet &part = fInputVectors[i];
+    Double_t pt = fCSPartPt[i];
+    if (pt <= 0) continue;
+
+    // (mt - pt) subtracted when rho_m is given, otherwise the original mass is kept
+    Double_t mt = (fRhom > 0) ? pt + fCSPartMd[i] : TMath::Sqrt(pt*pt + TMath::Max(0., part.m2()));
+    Double_t rap = part.rap();
+    Double_t phi = part.phi();
+    fj::PseudoJet sub(pt*TMath::Cos(phi), pt*TMath::Sin(phi), mt*TMath::SinH(rap), mt*TMath::CosH(rap));
+    sub.set_user_index(part.user_index());
+    fCSOutput.push_back(sub);
+  }
+
+  Int_t nRemoved = nPart - fCSOutput.size();
+  fInputVectors.swap(fCSOutput);
+
+  return nRemoved;
+}
+
+//_________________________________________________________________________________________________
+void StFJWrapper::ResetDeclusterings()
+{
+  // Forget the declusterings and subjets of the previous jets (buffers keep their capacity).
+
+  fDeclSteps.clear();
+  fDeclFirst.assign(fInclusiveJets.size(), -1);
+  fDeclN.assign(fInclusiveJets.size(), 0);
+  fDeclLeafPt.assign(fInclusiveJets.size(), 0.);
+  fDeclLeafM.assign(fInclusiveJets.size(), 0.);
+  fSubjetAxes.resize(6 * fInclusiveJets.size());
+  fSubjetNConst.assign(fInclusiveJets.size(), -1);
+}
+
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::DeclusterJet(UInt_t ijet)
+{
+  // Recluster the constituents of inclusive jet ijet with C/A (E-scheme) and follow the
+  // harder branch, storing z, deltaR, kt and the subjet pt and mass of every step.
+  // Done once per jet: later calls return the cached number of steps (-1 on error).
+
+  if (ijet >= fInclusiveJets.size() || !fClustSeq) {
+    __ERROR(Form("Wrong index: %d",ijet));
+    return -1;
+  }
+  if (fDeclFirst[ijet] >= 0) return fDeclN[ijet];
+
+  // real constituents only
+  fDeclConstituents.clear();
+#ifdef FASTJET_VERSION
+  std::vector<fj::PseudoJet> constituents = fClustSeq->constituents(fInclusiveJets[ijet]);
+  for (UInt_t ic = 0; ic < constituents.size(); ic++) {
+    if (constituents[ic].is_pure_ghost()) continue;
+    fDeclConstituents.push_back(constituents[ic]);
+  }
+#else
+  fDeclConstituents = fClustSeq->constituents(fInclusiveJets[ijet]);
+#endif
+
+  fDeclFirst[ijet] = fDeclSteps.size();
+  fDeclN[ijet] = 0;
+  if (fDeclConstituents.empty()) return 0;
+
+  try {
+    fj::JetDefinition caDef(fj::cambridge_algorithm, fj::JetDefinition::max_allowable_R);
+    fj::ClusterSequence caSeq(fDeclConstituents, caDef);
+    std::vector<fj::PseudoJet> caJets = caSeq.exclusive_jets(1);
+
+    fj::PseudoJet jj = caJets[0];
+    fj::PseudoJet j1, j2;
+    while (jj.has_parents(j1, j2)) {
+      if (j1.perp2() < j2.perp2()) std::swap(j1, j2);
+
+      StDeclusterStep step;
+      step.fPt     = jj.perp();
+      step.fM      = jj.m();
+      step.fDeltaR = j1.delta_R(j2);
+      step.fZ      = j2.perp() / (j1.perp() + j2.perp());
+      step.fKt     = j2.perp() * step.fDeltaR;
+      fDeclSteps.push_back(step);
+      fDeclN[ijet]++;
+
+      jj = j1;
+    }
+    fDeclLeafPt[ijet] = jj.perp();
+    fDeclLeafM[ijet]  = jj.m();
+  } catch (fj::Error) {
+    __WARNING(Form("FJ Exception caught."));
+    // cache the error: later calls return -1 without reclustering
+    fDeclSteps.resize(fDeclFirst[ijet]);
+    fDeclN[ijet] = -1;
+    return -1;
+  }
+
+  return fDeclN[ijet];
+}
+
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::GetSoftDrop(UInt_t ijet, Double_t zcut, Double_t beta, StSoftDropResult &result, Double_t R0)
+{
+  // SoftDrop (z > zcut (deltaR/R0)^beta) from the cached declustering of jet ijet.
+  // Returns the step of the groomed jet, -1 if no splitting passed (groomed jet = single constituent).
+
+  result.fZg = 0.; result.fRg = 0.; result.fMg = 0.; result.fPtg = 0.; result.fNDropped = 0;
+  Int_t nSteps = DeclusterJet(ijet);
+  if (nSteps < 0) return -1;
+
+  const StDeclusterStep *steps = (nSteps > 0) ? &fDeclSteps[fDeclFirst[ijet]] : 0;
+  for (Int_t istep = 0; istep < nSteps; istep++) {
+    const StDeclusterStep &step = steps[istep];
+    Double_t cut = (beta == 0.) ? zcut : zcut * TMath::Power(step.fDeltaR / R0, beta);
+    if (step.fZ >= cut) {
+      result.fZg = step.fZ;
+      result.fRg = step.fDeltaR;
+      result.fMg = step.fM;
+      result.fPtg = step.fPt;
+      result.fNDropped = istep;
+      return istep;
+    }
+  }
+
+  // everything groomed away
+  result.fMg = fDeclLeafM[ijet];
+  result.fPtg = fDeclLeafPt[ijet];
+  result.fNDropped = nSteps;
+  return -1;
+}
+
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::GetSoftDrop(UInt_t ijet, const std::vector<Double_t> &zcuts, const std::vector<Double_t> &betas,
+                               std::vector<StSoftDropResult> &results, Double_t R0)
+{
+  // SoftDrop for a list of (zcuts[i], betas[i]) settings, one declustering for all.
+  // Returns the number of settings with a splitting passing the condition.
+
+  results.resize(zcuts.size());
+  Int_t nPassed = 0;
+  for (UInt_t is = 0; is < zcuts.size(); is++) {
+    Double_t beta = (is < betas.size()) ? betas[is] : 0.;
+    if (GetSoftDrop(ijet, zcuts[is], beta, results[is], R0) >= 0) nPassed++;
+  }
+
+  return nPassed;
+}
+
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::GetLundPlane(UInt_t ijet, std::vector<Double_t> &lnInvDeltaR, std::vector<Double_t> &lnKt)
+{
+  // Primary Lund plane coordinates (ln 1/deltaR, ln kt) of jet ijet, from the cached declustering.
+
+  lnInvDeltaR.clear();
+  lnKt.clear();
+  Int_t nSteps = DeclusterJet(ijet);
+  for (Int_t istep = 0; istep < nSteps; istep++) {
+    const StDeclusterStep &step = fDeclSteps[fDeclFirst[ijet] + istep];
+    if (step.fDeltaR <= 0 || step.fKt <= 0) continue;
+    lnInvDeltaR.push_back(TMath::Log(1.0 / step.fDeltaR));
+    lnKt.push_back(TMath::Log(step.fKt));
+  }
+
+  return lnKt.size();
+}
+
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::GetJetShapes(UInt_t ijet, StJetShapeResult &result, UInt_t mask)
+{
+  // Jet shapes of inclusive jet ijet (same definitions as the StJetShape functors), accumulated
+  // in a single pass over the constituents; ghosts are skipped.
+  // Returns the number of constituents used, -1 on error.
+
+  result.fMass = 0.; result.fAngularity = 0.; result.fpTD = 0.; result.fCircularity = 0.;
+  result.fSigma2 = 0.; result.fLeSub = 0.; result.fNConst = 0;
+  if (mask & kShapeGR) {
+    fGRNumerator.assign(GetNGRBins(), 0.);
+    fGRDenominator.assign(GetNGRBins(), 0.);
+  }
+
+  if (ijet >= fInclusiveJets.size() || !fClustSeq) {
+    __ERROR(Form("Wrong index: %d",ijet));
+    return -1;
+  }
+
+  const fj::PseudoJet &jet = fInclusiveJets[ijet];
+  if (mask & kShapeMass) result.fMass = jet.m();
+
+  GetJetConstituents(ijet, fShapeConstituents);
+  if (mask & kShapeGR) {
+    fShapePt.clear(); fShapeEta.clear(); fShapePhi.clear();
+  }
+
+  Double_t jetEta = jet.eta(), jetPhi = jet.phi();
+
+  // circularity: transverse plane of the jet axis
+  Double_t px = jet.px(), py = jet.py(), pz = jet.pz();
+  TVector3 axis(px, py, pz);
+  TVector3 axis3(-px*pz, -py*pz, px*px + py*py);
+  TVector3 axis2(-py, px, 0);
+  if (mask & kShapeCircularity) { axis3.SetMag(1.); axis2.SetMag(1.); }
+  Bool_t circOk = kTRUE;
+
+  Double_t sumPt = 0., sumPt2 = 0., sumPtDR = 0.;
+  Double_t cxx = 0., cyy = 0., cxy = 0., csum = 0.;   // circularity tensor
+  Double_t sxx = 0., syy = 0., sxy = 0.;              // sigma2 tensor, normalised by sumPt2
+  Double_t lead = 0., sublead = 0.;
+  Int_t nc = 0;
+
+  for (UInt_t ic = 0; ic < fShapeConstituents.size(); ic++) {
+    const fj::PseudoJet &part = fShapeConstituents[ic];
+#ifdef FASTJET_VERSION
+    if (part.is_pure_ghost()) continue;
+#endif
+    Double_t pt = part.perp();
+    nc++;
+    sumPt  += pt;
+    sumPt2 += pt*pt;
+
+    if (pt > lead) { sublead = lead; lead = pt; }
+    else if (pt > sublead) sublead = pt;
+
+    if (mask & (kShapeAngularity | kShapeSigma2 | kShapeGR)) {
+      Double_t eta = part.eta(), phi = part.phi();
+      Double_t deta = eta - jetEta;
+      Double_t dphi = phi - jetPhi;
+      if (dphi < -1.*TMath::Pi()) dphi += TMath::TwoPi();
+      if (dphi > TMath::Pi()) dphi -= TMath::TwoPi();
+      if (mask & kShapeAngularity) sumPtDR += pt * TMath::Sqrt(deta*deta + dphi*dphi);
+      sxx += pt*pt*deta*deta;
+      syy += pt*pt*dphi*dphi;
+      sxy -= pt*pt*deta*TMath::Abs(dphi);
+      if (mask & kShapeGR) {
+        fShapePt.push_back(pt);
+        fShapeEta.push_back(eta);
+        fShapePhi.push_back(phi);
+      }
+    }
+
+    if ((mask & kShapeCircularity) && circOk) {
+      TVector3 pp(part.px(), part.py(), part.pz());
+      TVector3 pPerp = pp - pp.Dot(axis) / axis.Mag2() * axis;
+      Double_t x = pPerp.Dot(axis2);
+      Double_t y = pPerp.Dot(axis3);
+      Double_t t = TMath::Sqrt(x*x + y*y);
+      if (t <= 0) circOk = kFALSE;
+      else {
+        cxx += x*x/t; cyy += y*y/t; cxy += x*y/t;
+        csum += t;
+      }
+    }
+  }
+
+  result.fNConst = nc;
+  if (nc == 0) return 0;
+
+  if (mask & kShapeAngularity) result.fAngularity = sumPtDR / sumPt;
+  if (mask & kShapepTD) result.fpTD = TMath::Sqrt(sumPt2) / sumPt;
+  if ((mask & kShapeLeSub) && nc >= 2) result.fLeSub = lead - sublead;
+
+  // minor eigenvalue of a symmetric 2x2 matrix: (a+d)/2 - sqrt(((a-d)/2)^2 + b^2)
+  if ((mask & kShapeCircularity) && circOk && nc >= 2 && csum > 0) {
+    Double_t a = cxx/csum, d = cyy/csum, b = cxy/csum;
+    result.fCircularity = 2.*(0.5*(a+d) - TMath::Sqrt(0.25*(a-d)*(a-d) + b*b));
+  }
+  if ((mask & kShapeSigma2) && nc >= 2 && sumPt2 > 0) {
+    Double_t lmin = 0.5*(sxx+syy) - TMath::Sqrt(0.25*(sxx-syy)*(sxx-syy) + sxy*sxy);
+    result.fSigma2 = TMath::Sqrt(TMath::Abs(lmin) / sumPt2);
+  }
+
+  if (mask & kShapeGR) AddJetShapeGR();
+
+  return nc;
+}
+
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::GetJetShapes(std::vector<StJetShapeResult> &results, UInt_t mask)
+{
+  // Jet shapes of all inclusive jets. Returns the number of jets.
+
+  Int_t nBins = GetNGRBins();
+  std::vector<double> grNum, grDen;
+  if (mask & kShapeGR) {
+    grNum.reserve(nBins * fInclusiveJets.size());
+    grDen.reserve(nBins * fInclusiveJets.size());
+  }
+
+  results.resize(fInclusiveJets.size());
+  for (UInt_t ijet = 0; ijet < fInclusiveJets.size(); ijet++) {
+    GetJetShapes(ijet, results[ijet], mask);
+    if (mask & kShapeGR) {
+      grNum.insert(grNum.end(), fGRNumerator.begin(), fGRNumerator.end());
+      grDen.insert(grDen.end(), fGRDenominator.begin(), fGRDenominator.end());
+    }
+  }
+  if (mask & kShapeGR) {
+    fGRNumerator.swap(grNum);
+    fGRDenominator.swap(grDen);
+  }
+
+  return results.size();
+}
+
+//_________________________________________________________________________________________________
+void StFJWrapper::AddJetShapeGR()
+{
+  // Angular structure numerator (gaussian) and denominator (error function) for r = ib*fDRStep,
+  // all bins filled from one loop over the constituent pairs in fShapePt/Eta/Phi.
+  // Bins more than 10 fDRStep away from the pair distance get no numerator and the full
+  // (or no) denominator weight.
+
+  Int_t nBins = GetNGRBins();
+  Double_t norm = 1. / (TMath::Sqrt(2.*TMath::Pi()) * fDRStep);
+  Double_t range = 10. * fDRStep;
+  UInt_t n = fShapePt.size();
+  for (UInt_t ic = 0; ic < n; ic++) {
+    for (UInt_t jc = ic+1; jc < n; jc++) {
+      Double_t dphi = fShapePhi[ic] - fShapePhi[jc];
+      if (dphi < -1.*TMath::Pi()) dphi += TMath::TwoPi();
+      if (dphi > TMath::Pi()) dphi -= TMath::TwoPi();
+      Double_t deta = fShapeEta[ic] - fShapeEta[jc];
+      Double_t dr2 = deta*deta + dphi*dphi;
+      if (dr2 <= 0.) continue;
+      Double_t dr = TMath::Sqrt(dr2);
+      Double_t w = fShapePt[ic] * fShapePt[jc] * dr2;
+      for (Int_t ib = 0; ib < nBins; ib++) {
+        Double_t x = ib*fDRStep - dr;
+        if (x > range) { fGRDenominator[ib] += w; continue; }
+        if (x < -range) continue;
+        fGRNumerator[ib]   += w * TMath::Exp(-x*x/(2*fDRStep*fDRStep)) * norm;
+        fGRDenominator[ib] += w * 0.5*(1.+TMath::Erf(x/(TMath::Sqrt(2.)*fDRStep)));
+      }
+    }
+  }
+}
+
 //_________________________________________________________________________________________________
 Int_t StFJWrapper::DoSoftDrop() {
   //Do grooming
@@ -870,6 +1572,7 @@ void StFJWrapper::SetupAlgorithmfromOpt(const char *option)
   // Setup algorithm from char.
 
   std::string opt(option);
+  fDefinitionsValid = kFALSE;
 
   if (!opt.compare("kt"))                fAlgor    = fj::kt_algorithm;
   if (!opt.compare("antikt"))            fAlgor    = fj::antikt_algorithm;
@@ -888,6 +1591,7 @@ void StFJWrapper::SetupAreaTypefromOpt(const char *option)
   // Setup area type from char.
 
   std::string opt(option);
+  fDefinitionsValid = kFALSE;
 
   if (!opt.compare("active"))                      fAreaType = fj::active_area;
   if (!opt.compare("invalid"))                     fAreaType = fj::invalid_area;
@@ -905,6 +1609,7 @@ void StFJWrapper::SetupSchemefromOpt(const char *option)
   //
 
   std::string opt(option);
+  fDefinitionsValid = kFALSE;
 
   if (!opt.compare("BIpt"))   fScheme   = fj::BIpt_scheme;
   if (!opt.compare("BIpt2"))  fScheme   = fj::BIpt2_scheme;
@@ -921,6 +1626,7 @@ void StFJWrapper::SetupStrategyfromOpt(const char *option)
   // Setup strategy from char.
 
   std::string opt(option);
+  fDefinitionsValid = kFALSE;
 
   if (!opt.compare("Best"))            fStrategy = fj::Best;
   if (!opt.compare("N2MinHeapTiled"))  fStrategy = fj::N2MinHeapTiled;
@@ -937,13 +1643,166 @@ void StFJWrapper::SetupStrategyfromOpt(const char *option)
   if (!opt.compare("plugin"))          fStrategy = fj::plugin_strategy;
 }
  
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::FindExclusiveSubjets(const std::vector<fastjet::PseudoJet> &constituents, fastjet::PseudoJet *axes)
+{
+  // Exclusive kt (E-scheme) 1, 2 and 3 subjet axes of the constituents, as KT_Axes of Nsubjettiness,
+  // from one reclustering. With n <= N constituents the axes are the constituents (tau_N = 0).
+  // Returns the number of constituents, -1 on error.
+
+  Int_t n = constituents.size();
+  for (Int_t i = 0; i < 6; i++) axes[i] = fj::PseudoJet(0., 0., 0., 0.);
+  if (n == 0) return 0;
+
+  try {
+    fj::JetDefinition ktDef(fj::kt_algorithm, fj::JetDefinition::max_allowable_R, fj::E_scheme, fj::Best);
+    fj::ClusterSequence ktSeq(constituents, ktDef);
+    for (Int_t N = 1; N <= 3; N++) {
+      fj::PseudoJet *axesN = axes + N*(N-1)/2;
+      if (n <= N) {
+        for (Int_t i = 0; i < n; i++) axesN[i] = constituents[i];
+        continue;
+      }
+      std::vector<fj::PseudoJet> subjets = ktSeq.exclusive_jets(N);
+      for (Int_t i = 0; i < N; i++) axesN[i] = subjets[i];
+    }
+  } catch (fj::Error) {
+    __WARNING(Form("FJ Exception caught."));
+    return -1;
+  }
+
+  return n;
+}
+
+//_________________________________________________________________________________________________
+void StFJWrapper::ComputeSubjettiness(const std::vector<fastjet::PseudoJet> &constituents, const fastjet::PseudoJet *axes,
+                                      Double_t beta, Double_t R0, StSubjettinessResult &result) const
+{
+  // tau_1, tau_2, tau_3 (normalised measure) from one loop over the constituents.
+
+  Int_t n = constituents.size();
+  Double_t num[3] = {0., 0., 0.};
+  Double_t den = 0.;
+  for (Int_t ic = 0; ic < n; ic++) {
+    const fj::PseudoJet &part = constituents[ic];
+    Double_t pt = part.perp();
+    den += pt;
+    for (Int_t N = 1; N <= 3; N++) {
+      if (n <= N) continue;
+      const fj::PseudoJet *axesN = axes + N*(N-1)/2;
+      Double_t minDR2 = part.squared_distance(axesN[0]);
+      for (Int_t i = 1; i < N; i++) minDR2 = TMath::Min(minDR2, part.squared_distance(axesN[i]));
+      num[N-1] += pt * ((beta == 2.) ? minDR2 : TMath::Power(minDR2, 0.5*beta));
+    }
+  }
+  den *= TMath::Power(R0, beta);
+
+  result.fTau1 = (den > 0) ? num[0]/den : 0.;
+  result.fTau2 = (den > 0) ? num[1]/den : 0.;
+  result.fTau3 = (den > 0) ? num[2]/den : 0.;
+  result.fTau21 = (result.fTau1 > 0) ? result.fTau2/result.fTau1 : 0.;
+  result.fTau32 = (result.fTau2 > 0) ? result.fTau3/result.fTau2 : 0.;
+
+  result.fOpeningAngle = -2;
+  if (n >= 2) {
+    Double_t deta = axes[1].pseudorapidity() - axes[2].pseudorapidity();
+    Double_t dphi = axes[1].phi() - axes[2].phi();
+    if(dphi < -1*TMath::Pi()) dphi += (2*TMath::Pi());
+    else if (dphi > TMath::Pi()) dphi -= (2*TMath::Pi());
+    result.fOpeningAngle = TMath::Sqrt(deta*deta + dphi*dphi);
+  }
+}
+
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::GetSubjettiness(UInt_t ijet, StSubjettinessResult &result, Double_t beta, Double_t R0)
+{
+  // N-subjettiness of inclusive jet ijet, reclustered once per event.
+  // Returns the number of constituents, -1 on error.
+
+  if (ijet >= fInclusiveJets.size() || !fClustSeq) {
+    __ERROR(Form("Wrong index: %d",ijet));
+    return -1;
+  }
+  if (R0 < 0) R0 = fR;
+
+  // real constituents only
+  GetJetConstituents(ijet, fShapeConstituents);
+#ifdef FASTJET_VERSION
+  UInt_t nReal = 0;
+  for (UInt_t ic = 0; ic < fShapeConstituents.size(); ic++) {
+    if (fShapeConstituents[ic].is_pure_ghost()) continue;
+    fShapeConstituents[nReal++] = fShapeConstituents[ic];
+  }
+  fShapeConstituents.resize(nReal);
+#endif
+  if (fSubjetNConst[ijet] < 0) {
+    fSubjetNConst[ijet] = FindExclusiveSubjets(fShapeConstituents, &fSubjetAxes[6*ijet]);
+    if (fSubjetNConst[ijet] < 0) return -1;
+  }
+  ComputeSubjettiness(fShapeConstituents, &fSubjetAxes[6*ijet], beta, R0, result);
+
+  return fSubjetNConst[ijet];
+}
+
+//_________________________________________________________________________________________________
+Int_t StFJWrapper::GetSubjettiness(const fastjet::PseudoJet &jet, StSubjettinessResult &result, Double_t beta, Double_t R0)
+{
+  // N-subjettiness of any jet with constituents (e.g. the ghost-shifted jets of the derivative
+  // subtraction, ghosts included). The results of the last kSubjetCacheSize jets are kept, so
+  // tau_1, tau_2, tau_3 and the opening angle of the same shifted jet share one reclustering
+  // also when each observable loops over all jets. Returns the number of constituents, -1 on error.
+
+  if (!jet.has_constituents()) return -1;
+
+  fShapeConstituents = jet.constituents();
+  Int_t n = fShapeConstituents.size();
+  for (UInt_t ic = 0; ic < fSubjetCache.size(); ic++) {
+    const StSubjetCacheEntry &entry = fSubjetCache[ic];
+    if (n == entry.fNConst && beta == entry.fBeta && R0 == entry.fR0 &&
+        jet.E() == entry.fJet.E() && jet.px() == entry.fJet.px() &&
+        jet.py() == entry.fJet.py() && jet.pz() == entry.fJet.pz()) {
+      result = entry.fResult;
+      return n;
+    }
+  }
+
+  fj::PseudoJet axes[6];
+  if (FindExclusiveSubjets(fShapeConstituents, axes) < 0) return -1;
+  ComputeSubjettiness(fShapeConstituents, axes, beta, R0, result);
+
+  StSubjetCacheEntry entry;
+  entry.fJet    = fj::PseudoJet(jet.px(), jet.py(), jet.pz(), jet.E());
+  entry.fNConst = n;
+  entry.fBeta   = beta;
+  entry.fR0     = R0;
+  entry.fResult = result;
+  if (fSubjetCache.size() < kSubjetCacheSize) fSubjetCache.push_back(entry);
+  else {
+    fSubjetCache[fSubjetCacheNext] = entry;
+    fSubjetCacheNext = (fSubjetCacheNext + 1) % kSubjetCacheSize;
+  }
+
+  return n;
+}
+
+//_________________________________________________________________________________________________
+Double_t StFJWrapper::SelectSubjettiness(const StSubjettinessResult &result, Int_t N, Int_t Option)
+{
+  // NSubjettiness return value (Option 0: tau_N, 1 and 2: opening angle for N = 2).
+
+  if (Option == 0) return (N == 1) ? result.fTau1 : ((N == 2) ? result.fTau2 : result.fTau3);
+  if ((Option == 1 || Option == 2) && N == 2 && result.fOpeningAngle >= 0) return result.fOpeningAngle;
+  return -2;
+}
+
 Double_t StFJWrapper::NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Int_t Option){
   //Option 0=Nsubjettiness result, 1=opening angle between axes in Eta-Phi plane, 2=Distance between axes in Eta-Phi plane
   
-  fJetDef = new fj::JetDefinition(fAlgor, fR*100, fScheme, fStrategy ); //the *2 is becasue of a handful of jets that end up missing a track for some reason.
+  // local definition: the persistent fJetDef is kept for Run()
+  fj::JetDefinition jetDef(fAlgor, fR*100, fScheme, fStrategy ); //the *2 is becasue of a handful of jets that end up missing a track for some reason.
 
   try {
-    fClustSeqSA = new fastjet::ClusterSequence(fInputVectors, *fJetDef);
+    fClustSeqSA = new fastjet::ClusterSequence(fInputVectors, jetDef);
     // ClustSeqSA = new fastjet::ClusterSequenceArea(fInputVectors, *fJetDef, *fAreaDef);
   } catch (fj::Error) {
     __WARNING(Form("FJ Exception caught."));
@@ -951,6 +1810,12 @@ Double_t StFJWrapper::NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, D
   }
   fFilteredJets.clear();
   fFilteredJets = fClustSeqSA->inclusive_jets(fMinJetPt-0.1); //becasue this is < not <=
+  // exclusive kt axes: shared reclustering for tau_1,2,3 and the opening angle
+  if (Algorithm==0 && N>=1 && N<=3 && !fFilteredJets.empty()) {
+    StSubjettinessResult res;
+    if (GetSubjettiness(fFilteredJets[0], res, Beta, fR) < 0) return -1;
+    return SelectSubjettiness(res, N, Option);
+  }
   Double_t Result=-1;
   std::vector<fastjet::PseudoJet> SubJet_Axes;
   fj::PseudoJet SubJet1_Axis;
@@ -1038,6 +1903,13 @@ Double_t StFJWrapper::NSubjettiness(Int_t N, Int_t Algorithm, Double_t Radius, D
 
 Double32_t StFJWrapper::NSubjettinessDerivativeSub(Int_t N, Int_t Algorithm, Double_t Radius, Double_t Beta, Double_t JetR, fastjet::PseudoJet jet, Int_t Option){ //For derivative subtraction
 
+  // exclusive kt axes: shared reclustering for tau_1,2,3 and the opening angle
+  if (Algorithm==0 && N>=1 && N<=3) {
+    StSubjettinessResult res;
+    if (GetSubjettiness(jet, res, Beta, JetR) < 0) return -1;
+    return SelectSubjettiness(res, N, Option);
+  }
+
   Double_t Result=-1;
   std::vector<fastjet::PseudoJet> SubJet_Axes;
   fj::PseudoJet SubJet1_Axis;
@@ -59,7 +59,10 @@ StJet::StJet() :
   fLabel(-1),
   fHasGhost(kFALSE),
   fGhosts(),
-  fJetConstit(),
+  fConstitTable(0),
+  fConstitFirst(0),
+  fConstitN(0),
+  fSortedIDs(kFALSE),
   fJetShapeProperties(0)
 {
   fClosestJets[0] = 0;
@@ -104,7 +107,10 @@ StJet::StJet(Double_t px, Double_t py, Double_t pz) :
   fLabel(-1),
   fHasGhost(kFALSE),
   fGhosts(),
-  fJetConstit(),
+  fConstitTable(0),
+  fConstitFirst(0),
+  fConstitN(0),
+  fSortedIDs(kFALSE),
   fJetShapeProperties(0)
 {
   if (fPt != 0) {
@@ -154,7 +160,10 @@ StJet::StJet(Double_t pt, Double_t eta, Double_t phi, Double_t m) :
   fLabel(-1),
   fHasGhost(kFALSE),
   fGhosts(),
-  fJetConstit(),
+  fConstitTable(0),
+  fConstitFirst(0),
+  fConstitN(0),
+  fSortedIDs(kFALSE),
   fJetShapeProperties(0)
 {
   fPhi = TVector2::Phi_0_2pi(fPhi);
@@ -198,7 +207,10 @@ StJet::StJet(const StJet& jet) :
   fLabel(jet.fLabel),
   fHasGhost(jet.fHasGhost),
   fGhosts(jet.fGhosts),
-  fJetConstit(jet.fJetConstit),
+  fConstitTable(0),                  // the constituent table is only valid for the event of the original jet
+  fConstitFirst(0),
+  fConstitN(0),
+  fSortedIDs(jet.fSortedIDs),
   fJetShapeProperties(0)
 {
   // Copy constructor.
@@ -259,7 +271,10 @@ StJet& StJet::operator=(const StJet& jet)
     fLabel              = jet.fLabel;
     fHasGhost           = jet.fHasGhost;
     fGhosts             = jet.fGhosts;
-    fJetConstit         = jet.fJetConstit;
+    fConstitTable       = 0;           // not copied, see copy constructor
+    fConstitFirst       = 0;
+    fConstitN           = 0;
+    fSortedIDs          = jet.fSortedIDs;
     if (jet.fJetShapeProperties) {
       fJetShapeProperties = new StJetShapeProperties(*(jet.fJetShapeProperties));
     }
@@ -358,6 +373,51 @@ void StJet::SortConstituents()
 {
   std::sort(fClusterIDs.GetArray(), fClusterIDs.GetArray() + fClusterIDs.GetSize());
   std::sort(fTrackIDs.GetArray(), fTrackIDs.GetArray() + fTrackIDs.GetSize());
+  fSortedIDs = kTRUE;
+}
+
+/**
+ * Copy the constituent four-momenta of the jet from the event constituent table.
+ * @param[out] constituents Vector filled with the jet constituents (capacity is kept)
+ */
+void StJet::GetJetConstituents(std::vector<fastjet::PseudoJet> &constituents) const
+{
+  constituents.clear();
+  for (Int_t i = 0; i < GetNumberOfJetConstituents(); i++) constituents.push_back(JetConstituentAt(i));
+}
+
+/**
+ * Constituent returned by JetConstituentAt() for a jet without constituent table
+ * (copies, jets read back from file) or an index out of range
+ * @param idx Requested constituent index
+ * @return Reference to an empty four-momentum
+ */
+const fastjet::PseudoJet& StJet::NoJetConstituent(Int_t idx) const
+{
+  static const fastjet::PseudoJet empty(0., 0., 0., 0.);
+  cout<<Form("%s: no jet constituent %d (constituent table %s, %d constituents)", GetName(), idx, fConstitTable ? "set" : "not set", GetNumberOfJetConstituents())<<endl;
+  return empty;
+}
+
+/**
+ * Position of an index in a constituent index array
+ * @param ids Constituent index array
+ * @param id Index to search
+ * @param sorted If the array is sorted a binary search is done
+ * @return The position of the index in the array, -1 if not found
+ */
+Int_t StJet::FindID(const TArrayI &ids, Int_t id, Bool_t sorted)
+{
+  const Int_t *first = ids.GetArray();
+  const Int_t *last = first + ids.GetSize();
+  if (sorted) {
+    const Int_t *it = std::lower_bound(first, last, id);
+    return (it != last && *it == id) ? (Int_t)(it - first) : -1;
+  }
+  for (const Int_t *it = first; it != last; ++it) {
+    if (*it == id) return (Int_t)(it - first);
+  }
+  return -1;
 }
 
 /**
@@ -516,10 +576,7 @@ void StJet::ResetMatching()
 // this returns 1 less than the track ID since it returns the place in the Array
 Int_t StJet::ContainsTrack(Int_t it) const
 {
-  for (Int_t i = 0; i < fTrackIDs.GetSize(); i++) {
-    if (it == fTrackIDs[i]) return i;
-  }
-  return -1;
+  return FindID(fTrackIDs, it, fSortedIDs);
 }
 
 /**
@@ -592,6 +649,7 @@ void StJet::AddGhost(const Double_t dPx, const Double_t dPy, const Double_t dPz,
 
 /**
  * Clear this object: remove matching information, jet constituents, ghosts
+ * and reset the jet properties, so the object can be reused (TClonesArray::ConstructedAt())
  */
 void StJet::Clear(Option_t */*option*/)
 {
@@ -599,13 +657,29 @@ void StJet::Clear(Option_t */*option*/)
   fTrackIDs.Set(0);
   fClosestJets[0] = 0;
   fClosestJets[1] = 0;
-  fClosestJetsDist[0] = 0;
-  fClosestJetsDist[1] = 0;
-  fMatched = 0;
+  fClosestJetsDist[0] = 999;
+  fClosestJetsDist[1] = 999;
+  fMatched = 2;
   fPtSub = 0;
   fGhosts.clear();
   fHasGhost = kFALSE;
-  fJetConstit.clear();
+  fConstitTable = 0;
+  fConstitFirst = 0;
+  fConstitN = 0;
+  fSortedIDs = kFALSE;
+
+  // jet properties
+  fNEF = 0;
+  fArea = 0; fAreaEta = 0; fAreaPhi = 0; fAreaE = 0;
+  fMaxCPt = 0; fMaxNPt = 0;
+  fMaxTrackPt = 0; fMaxClusterPt = 0; fMaxTowerE = 0;
+  fMCPt = 0;
+  fNn = 0; fNch = 0;
+  fMatchingType = 0;
+  fPtSubVect = 0;
+  fTriggers = 0;
+  fLabel = -1;
+  if(fJetShapeProperties) { delete fJetShapeProperties; fJetShapeProperties = 0; }
 }
 
 /**
@@ -628,10 +702,7 @@ Int_t StJet::ContainsTrack(StVParticle* track, TClonesArray* tracks) const // FI
 // this returns 1 less than the cluster/towers ID since it returns the place in the Array
 Int_t StJet::ContainsCluster(Int_t ic) const
 {
-  for (Int_t i = 0; i < fClusterIDs.GetSize(); i++) {
-    if (ic == fClusterIDs[i]) return i;
-  }
-  return -1;
+  return FindID(fClusterIDs, ic, fSortedIDs);
 }
 
 /**
@@ -642,10 +713,7 @@ Int_t StJet::ContainsCluster(Int_t ic) const
 // this returns 1 less than the towers ID since it returns the place in the Array
 Int_t StJet::ContainsTower(Int_t ic) const
 {
-  for (Int_t i = 0; i < fClusterIDs.GetSize(); i++) {
-    if (ic == fClusterIDs[i]) return i;
-  }
-  return -1;
+  return FindID(fClusterIDs, ic, fSortedIDs);
 }
 
 // test functions for now = FIXME
@@ -658,14 +726,7 @@ Int_t StJet::ContainsTower(Int_t ic) const
  */
 Bool_t StJet::IsJetCluster(StJet* jet, Int_t iclus, Bool_t sorted) const
 {
-  for (Int_t i = 0; i < jet->GetNumberOfClusters(); ++i) {
-    Int_t ijetclus = jet->ClusterAt(i);
-    if (sorted && ijetclus > iclus)
-      return kFALSE;
-    if (ijetclus == iclus)
-      return kTRUE;
-  }
-  return kFALSE;
+  return (FindID(jet->fClusterIDs, iclus, sorted || jet->fSortedIDs) >= 0);
 }
 
 /**
@@ -677,12 +738,5 @@ Bool_t StJet::IsJetCluster(StJet* jet, Int_t iclus, Bool_t sorted) const
  */
 Bool_t StJet::IsJetTrack(StJet* jet, Int_t itrack, Bool_t sorted) const
 {
-  for (Int_t i = 0; i < jet->GetNumberOfTracks(); ++i) {
-    Int_t ijettrack = jet->TrackAt(i);
-    if (sorted && ijettrack > itrack)
-      return kFALSE;
-    if (ijettrack == itrack)
-      return kTRUE;
-  }
-  return kFALSE;
+  return (FindID(jet->fTrackIDs, itrack, sorted || jet->fSortedIDs) >= 0);
 }
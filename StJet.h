@@ -141,6 +141,7 @@ class StJet : public StVParticle
   Double_t          DeltaR(const StVParticle* part)                                         const;
 
   // Setters
+  void              SetPtEtaPhiM(Double_t pt, Double_t eta, Double_t phi, Double_t m) { fPt = pt; fEta = eta; fPhi = TVector2::Phi_0_2pi(phi); fM = m; }
   void              SetLabel(Int_t l)                  { fLabel   = l;                     }
   void              SetArea(Double_t a)                { fArea    = a;                     }
   void              SetAreaEta(Double_t a)             { fAreaEta = a;                     }
@@ -149,15 +150,15 @@ class StJet : public StVParticle
   void              SetMaxNeutralPt(Double32_t t)      { fMaxNPt  = t;                     }
   void              SetMaxChargedPt(Double32_t t)      { fMaxCPt  = t;                     }
   void              SetNEF(Double_t nef)               { fNEF     = nef;                   }
-  void              SetNumberOfClusters(Int_t n)       { fClusterIDs.Set(n);               } // towers
-  void              SetNumberOfTracks(Int_t n)         { fTrackIDs.Set(n);                 }
+  void              SetNumberOfClusters(Int_t n)       { fClusterIDs.Set(n); fSortedIDs = kFALSE; } // towers
+  void              SetNumberOfTracks(Int_t n)         { fTrackIDs.Set(n);   fSortedIDs = kFALSE; }
   void              SetNumberOfCharged(Int_t n)        { fNch = n;                         }
   void              SetNumberOfNeutrals(Int_t n)       { fNn = n;                          }
   void              SetMCPt(Double_t p)                { fMCPt = p;                        }
   void              SetPtSub(Double_t ps)              { fPtSub          = ps;             }
   void              SetPtSubVect(Double_t ps)          { fPtSubVect      = ps;             }
-  void              AddClusterAt(Int_t clus, Int_t idx){ fClusterIDs.AddAt(clus, idx);     } // towers
-  void              AddTrackAt(Int_t track, Int_t idx) { fTrackIDs.AddAt(track, idx);      }
+  void              AddClusterAt(Int_t clus, Int_t idx){ fClusterIDs.AddAt(clus, idx); fSortedIDs = kFALSE; } // towers
+  void              AddTrackAt(Int_t track, Int_t idx) { fTrackIDs.AddAt(track, idx);   fSortedIDs = kFALSE; }
   void              Clear(Option_t* /*option*/="");
 
   // March 19, 2018 - DOUBLE CHECK and fix these 
@@ -168,8 +169,9 @@ class StJet : public StVParticle
   void              SetMaxTowerE(Double32_t t)           { fMaxTowerE = t;                   }
   Double_t          GetMaxTowerE()                       const { return fMaxTowerE;          } // ;
 
-  // Sorting methods
+  // Sorting methods: with sorted indices the Contains*() lookups are binary searches
   void              SortConstituents();
+  Bool_t            HasSortedConstituents()              const { return fSortedIDs;          }
   std::vector<int>  GetPtSortedTrackConstituentIndexes(TClonesArray *tracks) const;
 
   // Trigger
@@ -195,10 +197,13 @@ class StJet : public StVParticle
   Bool_t HasGhost() const                               { return fHasGhost; }
   const std::vector<TLorentzVector> GetGhosts()   const { return fGhosts  ; }
 
-//TEST =========================
-  void SetJetConstituents(std::vector<fastjet::PseudoJet> n)        { fJetConstit = n;                         }
-  //const std::vector<fastjet::PseudoJet>&  GetInputVectors()    const { return fInputVectors;               }
-  const std::vector<fastjet::PseudoJet>& GetMyJets()  const { return fJetConstit; }
+  // Constituent four-momenta: index span into the event constituent table of the jet maker
+  // (StJetMakerTask::GetEventConstituents()), only valid for the event the jet was found in.
+  // Not copied by the copy constructor and assignment: copies have no constituent table.
+  void SetJetConstituents(const std::vector<fastjet::PseudoJet> *table, Int_t first, Int_t n) { fConstitTable = table; fConstitFirst = first; fConstitN = n; }
+  Int_t GetNumberOfJetConstituents()                    const { return fConstitTable ? fConstitN : 0; }
+  const fastjet::PseudoJet& JetConstituentAt(Int_t idx) const { return (fConstitTable && idx >= 0 && idx < fConstitN) ? (*fConstitTable)[fConstitFirst + idx] : NoJetConstituent(idx); }
+  void GetJetConstituents(std::vector<fastjet::PseudoJet> &constituents) const;
 
   // Debug printouts
   void Print(Option_t* /*opt*/ = "") const;
@@ -211,6 +216,8 @@ class StJet : public StVParticle
  protected:
   Bool_t            IsJetTrack(StJet* jet, Int_t itrack, Bool_t sorted = kFALSE)       const;
   Bool_t            IsJetCluster(StJet* jet, Int_t iclus, Bool_t sorted = kFALSE)      const;
+  static Int_t      FindID(const TArrayI &ids, Int_t id, Bool_t sorted);
+  const fastjet::PseudoJet& NoJetConstituent(Int_t idx) const;
   // add tower?
 
   /// Jet transverse momentum
@@ -255,7 +262,10 @@ class StJet : public StVParticle
   Bool_t            fHasGhost;            //!<! Whether ghost particle are included within the constituents
   std::vector<TLorentzVector> fGhosts;    //!<! Vector containing the ghost particles
 
-  std::vector<fastjet::PseudoJet> fJetConstit; //!<! Vector containing the jet constituents
+  const std::vector<fastjet::PseudoJet> *fConstitTable; //!<! Event constituent table of the jet maker
+  Int_t             fConstitFirst;        //!<! First constituent of this jet in fConstitTable
+  Int_t             fConstitN;            //!<! Number of constituents of this jet in fConstitTable
+  Bool_t            fSortedIDs;           //!<! fTrackIDs and fClusterIDs sorted by index (SortConstituents())
 
   StJetShapeProperties *fJetShapeProperties; //!<! Pointer to the jet shape properties
 
@@ -0,0 +1,331 @@
+// $Id$
+// Jet DST cache: writes the jets, rho values and event header of each event
+// to a tree (kWrite) and serves them to the jet maker and the analysis
+// makers on reruns (kRead), see StJetCacheMaker.h
+//
+
+#include "StJetCacheMaker.h"
+
+// ROOT includes
+#include <TClonesArray.h>
+#include <TFile.h>
+#include <TDirectory.h>
+#include <TTree.h>
+#include <TBranch.h>
+#include <TObjArray.h>
+
+// JetFramework includes
+#include "StJet.h"
+#include "StRhoParameter.h"
+#include "StJetMakerTask.h"
+#include "StPicoEventHeaderMaker.h"
+
+// STAR includes
+#include "StRoot/StPicoDstMaker/StPicoDst.h"
+#include "StRoot/StPicoDstMaker/StPicoDstMaker.h"
+#include "StRoot/StPicoEvent/StPicoEvent.h"
+
+ClassImp(StJetCacheMaker)
+
+//________________________________________________________________________
+StJetCacheMaker::StJetCacheMaker() :
+  StRhoBase(""),
+  fCacheFileName(""),
+  fCacheMode(kWrite),
+  fSourceRhoMakerName(""),
+  fCacheFile(0x0),
+  fCacheTree(0x0),
+  fCacheEvent(),
+  fCacheJets(),
+  fCacheJetsNames(),
+  fEventLoaded(kFALSE),
+  fLastRunId(-1),
+  fLastEventId(-1),
+  fNEventsCached(0)
+{
+  mOutName = "";
+  fJetMakerName = "";
+  fRhoMakerName = "";
+}
+
+//________________________________________________________________________
+StJetCacheMaker::StJetCacheMaker(const char *name, const char *cacheFile, Int_t mode, const char *jetMakerName, const char *rhoMakerName) :
+  StRhoBase(name, kFALSE, "", jetMakerName),
+  fCacheFileName(cacheFile),
+  fCacheMode(mode),
+  fSourceRhoMakerName(rhoMakerName),
+  fCacheFile(0x0),
+  fCacheTree(0x0),
+  fCacheEvent(),
+  fCacheJets(),
+  fCacheJetsNames(),
+  fEventLoaded(kFALSE),
+  fLastRunId(-1),
+  fLastEventId(-1),
+  fNEventsCached(0)
+{
+  // Constructor.
+  mOutName = "";
+  fJetMakerName = jetMakerName;
+  fRhoMakerName = name;
+
+  if (!name) return;
+  SetName(name);
+}
+
+//________________________________________________________________________
+StJetCacheMaker::~StJetCacheMaker()
+{
+  // destructor: jet collections are owned in kRead mode only
+  if(fCacheMode == kRead) {
+    for(UInt_t i = 0; i < fCacheJets.size(); i++) delete fCacheJets[i];
+  }
+  fCacheJets.clear();
+
+  if(fCacheFile) { fCacheFile->Close(); delete fCacheFile; }
+}
+
+//________________________________________________________________________
+Int_t StJetCacheMaker::Init()
+{
+  // base class creates the output rho objects and centrality correction
+  StRhoBase::Init();
+
+  if(fCacheFileName == "") {
+    LOG_WARN << " No jet cache file name set! " << endm;
+    return kStWarn;
+  }
+
+  Bool_t ok = (fCacheMode == kRead) ? InitRead() : InitWrite();
+  if(!ok) return kStWarn;
+
+  return kStOk;
+}
+
+//________________________________________________________________________
+Bool_t StJetCacheMaker::InitWrite()
+{
+  // cache tree with the event record and one branch per jet collection of the jet maker
+  // (the jet maker has to be created before this maker: its collections exist after its Init)
+  JetMaker = static_cast<StJetMakerTask*>(GetMaker(fJetMakerName));
+  const char *fJetMakerNameCh = fJetMakerName;
+  if(!JetMaker || !JetMaker->GetJets()) {
+    LOG_WARN << Form(" No %s! Skip! ", fJetMakerNameCh) << endm;
+    return kFALSE;
+  }
+
+  fCacheJets.clear();
+  fCacheJetsNames.clear();
+  fCacheJets.push_back(JetMaker->GetJets());
+  fCacheJetsNames.push_back(JetMaker->GetJetsName());
+  for(Int_t idef = 0; idef < JetMaker->GetNumberOfJetDefinitions(); idef++) {
+    fCacheJets.push_back(JetMaker->GetJets(idef));
+    fCacheJetsNames.push_back(JetMaker->GetJetsName(idef));
+  }
+
+  // the new file becomes gDirectory: switch back on return, or the histograms of the makers
+  // initialised later are owned by the cache file and deleted when it is closed in Finish()
+  TDirectory::TContext ctx(gDirectory);
+  fCacheFile = new TFile(fCacheFileName.Data(), "RECREATE");
+  if(!fCacheFile || fCacheFile->IsZombie()) {
+    LOG_WARN << Form(" Can not create jet cache file %s! ", fCacheFileName.Data()) << endm;
+    return kFALSE;
+  }
+  fCacheTree = new TTree("JetCache", "jet DST cache");
+  fCacheTree->SetDirectory(fCacheFile);
+  fCacheTree->Branch("event", &fCacheEvent, "fRunId/I:fEventId/I:fCent16/I:fZVtx/F:fRefMultCorr/F:fWeight/F:fRho/F:fRhoSigma/F:fRhoM/F");
+  for(UInt_t i = 0; i < fCacheJets.size(); i++) {
+    fCacheTree->Branch(fCacheJetsNames[i].Data(), &fCacheJets[i], 32000, 99);
+  }
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t StJetCacheMaker::InitRead()
+{
+  // cache tree with an index on (run ID, event ID): every jet branch gets its own collection
+  // (gDirectory is switched back on return, see InitWrite())
+  TDirectory::TContext ctx(gDirectory);
+  fCacheFile = TFile::Open(fCacheFileName.Data(), "READ");
+  if(!fCacheFile || fCacheFile->IsZombie()) {
+    LOG_WARN << Form(" Can not open jet cache file %s! ", fCacheFileName.Data()) << endm;
+    return kFALSE;
+  }
+  fCacheTree = static_cast<TTree*>(fCacheFile->Get("JetCache"));
+  if(!fCacheTree) {
+    LOG_WARN << Form(" No JetCache tree in %s! ", fCacheFileName.Data()) << endm;
+    return kFALSE;
+  }
+
+  TObjArray *branches = fCacheTree->GetListOfBranches();
+  fCacheJets.clear();
+  fCacheJetsNames.clear();
+  for(Int_t ib = 0; ib < branches->GetEntriesFast(); ib++) {
+    TString branchName = branches->At(ib)->GetName();
+    if(branchName == "event") continue;
+    fCacheJetsNames.push_back(branchName);
+    fCacheJets.push_back(new TClonesArray("StJet"));
+  }
+
+  // addresses after the vector is complete (no reallocation)
+  fCacheTree->SetBranchAddress("event", &fCacheEvent);
+  for(UInt_t i = 0; i < fCacheJets.size(); i++) {
+    fCacheTree->SetBranchAddress(fCacheJetsNames[i].Data(), &fCacheJets[i]);
+  }
+  fCacheTree->BuildIndex("fRunId", "fEventId");
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Int_t StJetCacheMaker::Finish() {
+  // write cache tree and close file
+  if(fCacheMode == kWrite && fCacheFile && fCacheTree) {
+    TDirectory::TContext ctx(gDirectory);
+    fCacheFile->cd();
+    fCacheTree->Write();
+    cout<<"StJetCacheMaker: "<<fNEventsCached<<" events written to "<<fCacheFileName.Data()<<endl;
+  }
+  if(fCacheMode == kRead) {
+    cout<<"StJetCacheMaker: "<<fNEventsCached<<" events read from "<<fCacheFileName.Data()<<endl;
+  }
+
+  if(fCacheFile) {
+    fCacheFile->Close();
+    delete fCacheFile;
+    fCacheFile = 0x0;
+    fCacheTree = 0x0;
+  }
+
+  return kStOK;
+}
+
+//________________________________________________________________________
+void StJetCacheMaker::Clear(Option_t *opt) {
+  fEventLoaded = kFALSE;
+  fLastRunId = -1;
+  fLastEventId = -1;
+}
+
+//________________________________________________________________________
+Bool_t StJetCacheMaker::LoadEvent(Int_t runId, Int_t eventId)
+{
+  // load the cache entry of event (runId, eventId): done once per event, also when called by the jet maker
+  if(fCacheMode != kRead || !fCacheTree) return kFALSE;
+  if(runId == fLastRunId && eventId == fLastEventId) return fEventLoaded;
+
+  fLastRunId = runId;
+  fLastEventId = eventId;
+  fEventLoaded = (fCacheTree->GetEntryWithIndex(runId, eventId) > 0);
+  if(fEventLoaded) fNEventsCached++;
+
+  return fEventLoaded;
+}
+
+//________________________________________________________________________
+TClonesArray* StJetCacheMaker::GetCachedJets(const char *jetsName)
+{
+  // jet collection jetsName of the loaded event
+  for(UInt_t i = 0; i < fCacheJetsNames.size(); i++) {
+    if(fCacheJetsNames[i] == jetsName) return fCacheJets[i];
+  }
+  return 0x0;
+}
+
+//________________________________________________________________________
+Int_t StJetCacheMaker::Make()
+{
+  // Run the analysis - for each event
+
+  // get PicoDstMaker
+  mPicoDstMaker = static_cast<StPicoDstMaker*>(GetMaker("picoDst"));
+  if(!mPicoDstMaker) {
+    LOG_WARN << " No PicoDstMaker! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // construct PicoDst object from maker
+  mPicoDst = static_cast<StPicoDst*>(mPicoDstMaker->picoDst());
+  if(!mPicoDst) {
+    LOG_WARN << " No PicoDst! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // create pointer to PicoEvent
+  mPicoEvent = static_cast<StPicoEvent*>(mPicoDst->event());
+  if(!mPicoEvent) {
+    LOG_WARN << " No PicoEvent! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // initialize outputs
+  fOutRho->SetVal(0);
+  fOutRhoSigma->SetVal(0);
+  fOutRhoM->SetVal(0);
+  if(fOutRhoScaled) fOutRhoScaled->SetVal(0);
+
+  // kRead: publish the cached rho values
+  if(fCacheMode == kRead) {
+    if(!LoadEvent(mPicoEvent->runId(), mPicoEvent->eventId())) return kStOk;
+    fOutRho->SetVal(fCacheEvent.fRho);
+    fOutRhoSigma->SetVal(fCacheEvent.fRhoSigma);
+    fOutRhoM->SetVal(fCacheEvent.fRhoM);
+    if(fOutRhoScaled) fOutRhoScaled->SetVal(fCacheEvent.fRho * GetScaleFactor(GetCentBin(fCacheEvent.fCent16, 16)*5.0));
+    return kStOk;
+  }
+
+  // kWrite: events rejected by the event header or the z-vertex cut are not written
+  if(!InitEventHeader()) return kStWarn;
+  if(fEventHeader && !fEventHeader->IsEventSelected()) return kStOk;
+
+  mVertex = mPicoEvent->primaryVertex();
+  double zVtx = mVertex.z();
+  // (done once per event by the shared event header when set)
+  if(!fEventHeader && ((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut))) return kStOk;
+
+  return FillCache();
+}
+
+//________________________________________________________________________
+Int_t StJetCacheMaker::FillCache()
+{
+  // fill the event record and write the entry (jet collections are read from the jet maker branches)
+  if(!fCacheTree) return kStWarn;
+
+  Int_t cent16, cent9;
+  Double_t refCorr2, eventWeight;
+  GetEventCentrality(mVertex.z(), cent16, cent9, refCorr2, eventWeight);
+  if(cent16 == -1) return kStOk; // lowest multiplicity events 80%+ are cut by the jet and rho makers as well
+
+  fCacheEvent.fRunId       = mPicoEvent->runId();
+  fCacheEvent.fEventId     = mPicoEvent->eventId();
+  fCacheEvent.fCent16      = cent16;
+  fCacheEvent.fZVtx        = mVertex.z();
+  fCacheEvent.fRefMultCorr = refCorr2;
+  fCacheEvent.fWeight      = eventWeight;
+  fCacheEvent.fRho         = 0.;
+  fCacheEvent.fRhoSigma    = 0.;
+  fCacheEvent.fRhoM        = 0.;
+
+  // rho values of the source rho maker (run before this maker)
+  if(fSourceRhoMakerName != "") {
+    StRhoBase *rhoMaker = static_cast<StRhoBase*>(GetMaker(fSourceRhoMakerName));
+    const char *fRhoMakerNameCh = fSourceRhoMakerName;
+    if(!rhoMaker || !rhoMaker->GetRho()) {
+      LOG_WARN << Form(" No %s! Skip! ", fRhoMakerNameCh) << endm;
+      return kStWarn;
+    }
+    fCacheEvent.fRho      = rhoMaker->GetRho()->GetVal();
+    fCacheEvent.fRhoSigma = (rhoMaker->GetRhoSigma()) ? rhoMaker->GetRhoSigma()->GetVal() : 0.;
+    fCacheEvent.fRhoM     = (rhoMaker->GetRhoM()) ? rhoMaker->GetRhoM()->GetVal() : 0.;
+  }
+  fOutRho->SetVal(fCacheEvent.fRho);
+  fOutRhoSigma->SetVal(fCacheEvent.fRhoSigma);
+  fOutRhoM->SetVal(fCacheEvent.fRhoM);
+
+  fCacheTree->Fill();
+  fNEventsCached++;
+
+  return kStOk;
+}
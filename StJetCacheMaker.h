@@ -0,0 +1,98 @@
+#ifndef STJETCACHEMAKER_H
+#define STJETCACHEMAKER_H
+
+// $Id$
+//
+// Jet DST cache: jets of a jet maker with rho, sigma, rho_m and the event
+// header written to a compact per-event tree, so that analysis reruns can
+// skip the jet finding.
+//
+// kWrite: run after the jet maker and the rho maker, each event gets one
+//         entry (run ID, event ID, centrality, z-vertex, rho values and the
+//         StJet collections of the jet maker: main + additional definitions,
+//         with area and track / tower constituent indices)
+// kRead:  the entry of the current event (run ID, event ID) is loaded, the
+//         jet maker with SetJetCacheMakerName() fills its jet collections from
+//         it instead of clustering, and the rho values are published by this
+//         maker (pass its name as rho maker name to the analysis makers)
+//
+// In kRead mode the jets have no constituent four-momenta and no FastJet
+// wrapper state (StJet::JetConstituentAt(), StJetMakerTask::GetFJWrapper()).
+
+#include "StRhoBase.h"
+
+// additional includes
+#include "StMaker.h"
+#include <vector>
+
+// ROOT classes
+class TClonesArray;
+class TFile;
+class TTree;
+
+class StJetCacheMaker : public StRhoBase {
+
+ public:
+  enum ECacheMode_t {
+    kWrite,
+    kRead
+  };
+
+  // per-event record of the cache tree (branch "event")
+  struct StJetCacheEvent {
+    Int_t    fRunId;         // run ID
+    Int_t    fEventId;       // event ID
+    Int_t    fCent16;        // 16 bin centrality
+    Float_t  fZVtx;          // z-vertex
+    Float_t  fRefMultCorr;   // corrected grefMult
+    Float_t  fWeight;        // StRefMultCorr event weight
+    Float_t  fRho;           // rho
+    Float_t  fRhoSigma;      // in-event fluctuation of rho
+    Float_t  fRhoM;          // rho_m
+  };
+
+  StJetCacheMaker();
+  StJetCacheMaker(const char *name, const char *cacheFile, Int_t mode = kWrite, const char *jetMakerName = "", const char *rhoMakerName = "");
+  virtual ~StJetCacheMaker();
+
+  virtual Int_t Init();
+  virtual Int_t Make();
+  virtual void  Clear(Option_t *opt="");
+  virtual Int_t Finish();
+
+  void    SetCacheFileName(const char *f)    { fCacheFileName  = f; }
+  void    SetCacheMode(Int_t m)              { fCacheMode      = m; }
+  void    SetSourceRhoMakerName(const char *n) { fSourceRhoMakerName = n; }
+
+  Int_t   GetCacheMode() const               { return fCacheMode; }
+  Bool_t  LoadEvent(Int_t runId, Int_t eventId);
+  Bool_t  IsEventLoaded() const              { return fEventLoaded; }
+  const StJetCacheEvent& GetCacheEvent() const { return fCacheEvent; }
+  TClonesArray* GetCachedJets(const char *jetsName);
+
+ protected:
+  Bool_t            InitWrite();
+  Bool_t            InitRead();
+  Int_t             FillCache();
+
+  TString           fCacheFileName;                 // name of cache file
+  Int_t             fCacheMode;                     // kWrite or kRead
+  TString           fSourceRhoMakerName;            // rho maker whose values are written (kWrite)
+
+  TFile            *fCacheFile;                     //! cache file
+  TTree            *fCacheTree;                     //! cache tree
+  StJetCacheEvent   fCacheEvent;                    //! current event record
+  std::vector<TClonesArray*> fCacheJets;            //! jet collections (kWrite: of the jet maker)
+  std::vector<TString>       fCacheJetsNames;       //! branch names = jet collection names
+  Bool_t            fEventLoaded;                   //! entry of current event loaded (kRead)
+  Int_t             fLastRunId;                     //! run ID of last LoadEvent() call
+  Int_t             fLastEventId;                   //! event ID of last LoadEvent() call
+  Int_t             fNEventsCached;                 //! events written / found
+
+ private:
+  StJetCacheMaker(const StJetCacheMaker&);             // not implemented
+  StJetCacheMaker& operator=(const StJetCacheMaker&);  // not implemented
+
+  ClassDef(StJetCacheMaker, 1); // jet DST cache
+};
+#endif
@@ -31,6 +31,8 @@
 #include "StRho.h"
 #include "StJetMakerTask.h"
 #include "StEventPlaneMaker.h" // new
+#include "StPicoTrackTableMaker.h"
+#include "StPicoEventHeaderMaker.h"
 
 // new includes
 #include "StRoot/StPicoEvent/StPicoEvent.h"
@@ -48,6 +50,8 @@
 
 
 #include "StEmcUtil/projection/StEmcPosition.h"
+#include "StEmcPositionCache.h"
+#include "StPicoTriggerDecoder.h"
 class StEmcPosition;
 
 // classes
@@ -98,6 +102,9 @@ StJetFrameworkPicoBase::StJetFrameworkPicoBase() :
   JetMakerBG(0x0),
   RhoMaker(0x0),
   EventPlaneMaker(0x0),
+  fTrackTable(0x0),
+  fTrackTableProfile(-1),
+  fEventHeader(0x0),
   grefmultCorr(0),
   refmultCorr(0),
   refmult2Corr(0),
@@ -109,6 +116,8 @@ StJetFrameworkPicoBase::StJetFrameworkPicoBase() :
   fRhoMakerName(""),
   fRhoSparseMakerName(""),
   fEventPlaneMakerName(""),
+  fTrackTableMakerName(""),
+  fEventHeaderMakerName(""),
   fRho(0x0),
   fRhoVal(0),
   fAddToHistogramsName(""),
@@ -156,6 +165,9 @@ StJetFrameworkPicoBase::StJetFrameworkPicoBase(const char* name) :
   JetMakerBG(0x0),
   RhoMaker(0x0),
   EventPlaneMaker(0x0),
+  fTrackTable(0x0),
+  fTrackTableProfile(-1),
+  fEventHeader(0x0),
   grefmultCorr(0),
   refmultCorr(0),
   refmult2Corr(0),
@@ -167,6 +179,8 @@ StJetFrameworkPicoBase::StJetFrameworkPicoBase(const char* name) :
   fRhoMakerName(""),
   fRhoSparseMakerName(""),
   fEventPlaneMakerName(""),
+  fTrackTableMakerName(""),
+  fEventHeaderMakerName(""),
   fRho(0x0),
   fRhoVal(0),
   fAddToHistogramsName(""),
@@ -269,7 +283,7 @@ void StJetFrameworkPicoBase::Clear(Option_t *opt) {
 double StJetFrameworkPicoBase::GetRhoValue(TString fRhoMakerNametemp)
 {
   // get RhoMaker from event: old names "StRho_JetsBG", "OutRho", "StMaker#0"
-  RhoMaker = static_cast<StRho*>(GetMaker(fRhoMakerNametemp));
+  RhoMaker = static_cast<StRhoBase*>(GetMaker(fRhoMakerNametemp));
   const char *fRhoMakerNameCh = fRhoMakerNametemp;
   if(!RhoMaker) {
     LOG_WARN << Form(" No %s! Skip! ", fRhoMakerNameCh) << endm;
@@ -514,13 +528,132 @@ Bool_t StJetFrameworkPicoBase::AcceptTrack(StPicoTrack *trk, Float_t B, StThreeV
   return kTRUE;
 }
 
+//
+// track cuts and momentum vector (global or primary) for PicoDst track index iTrk
+// taken from the shared track table when available, computed here otherwise
+//________________________________________________________________________
+Bool_t StJetFrameworkPicoBase::GetAcceptedTrack(Int_t iTrk, StThreeVectorF &mom) {
+  // track table: cuts and helix momentum were done once for the event
+  if(fTrackTable) {
+    if((iTrk < 0) || (iTrk >= fTrackTable->GetNumberOfTracks())) return kFALSE;
+    if(!fTrackTable->PassCuts(iTrk, fTrackTableProfile)) return kFALSE;
+    mom = StThreeVectorF(fTrackTable->GetPx(iTrk), fTrackTable->GetPy(iTrk), fTrackTable->GetPz(iTrk));
+    return kTRUE;
+  }
+
+  StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(iTrk));
+  if(!trk) return kFALSE;
+
+  // acceptance and kinematic quality cuts
+  if(!StJetFrameworkPicoBase::AcceptTrack(trk, Bfield, mVertex)) return kFALSE;
+
+  // get momentum vector of track - global or primary track
+  if(doUsePrimTracks) {
+    // get primary track vector
+    mom = trk->pMom();
+  } else {
+    // get global track vector
+    mom = trk->gMom(mVertex, Bfield);
+  }
+
+  return kTRUE;
+}
+
+//
+// get shared track table (if requested) and register track cuts with it
+//________________________________________________________________________
+Bool_t StJetFrameworkPicoBase::InitTrackTable() {
+  // not used
+  if(fTrackTableMakerName.IsNull()) return kTRUE;
+  if(fTrackTable) return kTRUE;
+
+  fTrackTable = static_cast<StPicoTrackTableMaker*>(GetMaker(fTrackTableMakerName));
+  const char *fTrackTableMakerNameCh = fTrackTableMakerName;
+  if(!fTrackTable) {
+    LOG_WARN << Form(" No %s! Skip! ", fTrackTableMakerNameCh) << endm;
+    return kFALSE;
+  }
+
+  // the table must be filled with the same type of tracks
+  if(fTrackTable->GetUsePrimaryTracks() != doUsePrimTracks) {
+    LOG_WARN << Form(" %s primary track setting differs from %s, not using track table! ", fTrackTableMakerNameCh, GetName()) << endm;
+    fTrackTable = 0x0;
+    fTrackTableMakerName = "";
+    return kTRUE;
+  }
+
+  // register track cuts
+  fTrackTableProfile = fTrackTable->AddCutProfile(GetName(), fTrackPtMinCut, fTrackPtMaxCut,
+      fTrackEtaMinCut, fTrackEtaMaxCut, fTrackPhiMinCut, fTrackPhiMaxCut,
+      fTrackDCAcut, fTracknHitsFit, fTracknHitsRatio);
+  if(fTrackTableProfile < 0) {
+    fTrackTable = 0x0;
+    fTrackTableMakerName = "";
+  }
+
+  return kTRUE;
+}
+
+//
+// get shared event header (if requested): trigger selection of the maker, kTriggerANY if none
+//________________________________________________________________________
+Bool_t StJetFrameworkPicoBase::InitEventHeader(UInt_t triggerToUse, UInt_t mbEventType, UInt_t emcTriggerEventType) {
+  // not used
+  if(fEventHeaderMakerName.IsNull()) return kTRUE;
+  if(fEventHeader) return kTRUE;
+
+  fEventHeader = static_cast<StPicoEventHeaderMaker*>(GetMaker(fEventHeaderMakerName));
+  const char *fEventHeaderMakerNameCh = fEventHeaderMakerName;
+  if(!fEventHeader) {
+    LOG_WARN << Form(" No %s! Skip! ", fEventHeaderMakerNameCh) << endm;
+    return kFALSE;
+  }
+
+  // centrality and event selection must be the same: the header rejects events for the whole chain
+  const char *diff = fEventHeader->CompareSettings(fRunFlag, fCentralityDef, doUseBBCCoincidenceRate,
+      fEventZVtxMinCut, fEventZVtxMaxCut, triggerToUse, mbEventType, emcTriggerEventType);
+  if(diff) {
+    LOG_WARN << Form(" %s %s setting differs from %s, not using event header! ", fEventHeaderMakerNameCh, diff, GetName()) << endm;
+    fEventHeader = 0x0;
+    fEventHeaderMakerName = "";
+  }
+
+  return kTRUE;
+}
+
+//
+// centrality of event: taken from the shared event header when available, computed here otherwise
+//________________________________________________________________________
+void StJetFrameworkPicoBase::GetEventCentrality(Double_t zVertex, Int_t &cent16, Int_t &cent9, Double_t &refCorr2, Double_t &weight) {
+  // event header: centrality correction was done once for the event
+  if(fEventHeader) {
+    const StPicoEventHeaderMaker::StEventRecord &evt = fEventHeader->GetEventRecord();
+    cent16 = evt.fCent16;
+    cent9 = evt.fCent9;
+    refCorr2 = evt.fRefMultCorr;
+    weight = evt.fWeight;
+    return;
+  }
+
+  // 10 14 21 29 40 54 71 92 116 145 179 218 263 315 373 441  // RUN 14 AuAu binning
+  int RunId = mPicoEvent->runId();
+  double fCoincidenceRate = (doUseBBCCoincidenceRate) ? mPicoEvent->BBCx() : mPicoEvent->ZDCx();
+  int grefMult = mPicoEvent->grefMult();
+  grefmultCorr->init(RunId);
+  grefmultCorr->initEvent(grefMult, zVertex, fCoincidenceRate);
+  refCorr2 = grefmultCorr->getRefMultCorr(grefMult, zVertex, fCoincidenceRate, 2);
+  cent16 = grefmultCorr->getCentralityBin16();
+  cent9 = grefmultCorr->getCentralityBin9();
+  weight = grefmultCorr->getWeight();
+}
+
 /*
 //
 // Tower Quality Cuts
 //________________________________________________________________________
 Bool_t StJetFrameworkPicoBase::AcceptTower(StPicoBTowHit *tower, StThreeVectorF Vertex) {
   // get EMCal position
-  StEmcPosition *mPosition = new StEmcPosition();
+  StEmcPositionCache *mPosition = StEmcPositionCache::Instance();
 
   // constants:
   double pi = 1.0*TMath::Pi();
@@ -532,7 +665,7 @@ Bool_t StJetFrameworkPicoBase::AcceptTower(StPicoBTowHit *tower, StThreeVectorF
   if(towerID < 0) return kFALSE; 
 
   // cluster and tower position - from vertex and ID: shouldn't need additional eta correction
-  StThreeVectorF towerPosition = mPosition->getPosFromVertex(mVertex, towerID);
+  StThreeVectorF towerPosition = mPosition->GetPosFromVertex(mVertex, towerID);
   double phi = towerPosition.phi();
   if(phi < 0)    phi += 2.0*pi;
   if(phi > 2*pi) phi -= 2.0*pi;
@@ -917,114 +1050,28 @@ Bool_t StJetFrameworkPicoBase::DoComparison(int myarr[], int elems) {
 
 //_________________________________________________________________________
 Bool_t StJetFrameworkPicoBase::CheckForMB(int RunFlag, int type) {
-  // Run14 triggers:
-  int arrMB_Run14[] = {450014};
-  int arrMB30_Run14[] = {450010, 450020};
-  int arrMB5_Run14[] = {450005, 450008, 450009, 450014, 450015, 450018, 450024, 450025, 450050, 450060};
-  // additional 30: 4, 5, 450201, 450202, 450211, 450212
-
-  // Run16 triggers:
-  int arrMB_Run16[] = {520021};
-  int arrMB5_Run16[] = {520001, 520002, 520003, 520011, 520012, 520013, 520021, 520022, 520023, 520031, 520033, 520041, 520042, 520043, 520051, 520822, 520832, 520842, 570702};
-  int arrMB10_Run16[] = {520007, 520017, 520027, 520037, 520201, 520211, 520221, 520231, 520241, 520251, 520261, 520601, 520611, 520621, 520631, 520641};
-
-  // run flag selection to check for MB firing
-  switch(RunFlag) {
-    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
-        switch(type) { 
-          case kRun14main :
-              if((DoComparison(arrMB_Run14, sizeof(arrMB_Run14)/sizeof(*arrMB_Run14)))) { return kTRUE; }
-              break;
-          case kVPDMB5 :
-              if((DoComparison(arrMB5_Run14, sizeof(arrMB5_Run14)/sizeof(*arrMB5_Run14)))) { return kTRUE; }
-              break;
-          case kVPDMB30 :
-              if((DoComparison(arrMB30_Run14, sizeof(arrMB30_Run14)/sizeof(*arrMB30_Run14)))) { return kTRUE; }
-              break;
-          default :
-              if((DoComparison(arrMB_Run14, sizeof(arrMB_Run14)/sizeof(*arrMB_Run14)))) { return kTRUE; }
-        }
-        break; // added May20
-
-    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
-        switch(type) {
-          case kRun16main :
-              if((DoComparison(arrMB_Run16, sizeof(arrMB_Run16)/sizeof(*arrMB_Run16)))) { return kTRUE; }
-              break;
-          case kVPDMB5 :
-              if((DoComparison(arrMB5_Run16, sizeof(arrMB5_Run16)/sizeof(*arrMB5_Run16)))) { return kTRUE; }
-              break;
-          case kVPDMB10 :
-              if((DoComparison(arrMB10_Run16, sizeof(arrMB10_Run16)/sizeof(*arrMB10_Run16)))) { return kTRUE; }
-              break;
-          default :
-              if((DoComparison(arrMB_Run16, sizeof(arrMB_Run16)/sizeof(*arrMB_Run16)))) { return kTRUE; }
-        }
-        break; // added May20
-  } // RunFlag switch
+  // trigger bits are decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, RunFlag);
 
-  // return status
-  return kFALSE;
+  // MB selection of run flag
+  return ((mask & StPicoTriggerDecoder::GetMBBit(RunFlag, type)) != 0);
 } // MB function
 
 //
 // check to see if the event was EMC triggered for High Towers
 //____________________________________________________________________________
 Bool_t StJetFrameworkPicoBase::CheckForHT(int RunFlag, int type) {
+  // trigger bits are decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, RunFlag);
 
-  // Run14 triggers:
-  int arrHT1_Run14[] = {450201, 450211, 460201};
-  int arrHT2_Run14[] = {450202, 450212, 460202, 460212};
-  int arrHT3_Run14[] = {450203, 450213, 460203};
-
-  // Run16 triggers:
-  int arrHT1_Run16[] = {520201, 520211, 520221, 520231, 520241, 520251, 520261, 520605, 520615, 520625, 520635, 520645, 520655, 550201, 560201, 560202, 530201, 540201};
-  int arrHT2_Run16[] = {530202, 540203};
-  int arrHT3_Run16[] = {520203, 530213};
-
-  // run flag selection to check for MB firing
-  switch(RunFlag) {
-    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
-        switch(type) {
-          case kIsHT1 :
-              if((DoComparison(arrHT1_Run14, sizeof(arrHT1_Run14)/sizeof(*arrHT1_Run14)))) { return kTRUE; }
-              break;
-          case kIsHT2 :
-              if((DoComparison(arrHT2_Run14, sizeof(arrHT2_Run14)/sizeof(*arrHT2_Run14)))) { return kTRUE; }
-              break;
-          case kIsHT3 :
-              if((DoComparison(arrHT3_Run14, sizeof(arrHT3_Run14)/sizeof(*arrHT3_Run14)))) { return kTRUE; }
-              break;
-          default :  // default to HT2
-              if((DoComparison(arrHT2_Run14, sizeof(arrHT2_Run14)/sizeof(*arrHT2_Run14)))) { return kTRUE; }
-        }
-        break; // added May20
-
-    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
-        switch(type) {
-          case kIsHT1 :
-              if((DoComparison(arrHT1_Run16, sizeof(arrHT1_Run16)/sizeof(*arrHT1_Run16)))) { return kTRUE; }
-              break;
-          case kIsHT2 :
-              if((DoComparison(arrHT2_Run16, sizeof(arrHT2_Run16)/sizeof(*arrHT2_Run16)))) { return kTRUE; }
-              break;
-          case kIsHT3 :
-              if((DoComparison(arrHT3_Run16, sizeof(arrHT3_Run16)/sizeof(*arrHT3_Run16)))) { return kTRUE; }
-              break;
-          default :  // Run16 only has HT1's
-              if((DoComparison(arrHT1_Run16, sizeof(arrHT1_Run16)/sizeof(*arrHT1_Run16)))) { return kTRUE; }
-        }
-        break; // added May20
-
-  } // RunFlag switch
-
-  return kFALSE;
+  // HT selection of run flag
+  return ((mask & StPicoTriggerDecoder::GetHTBit(RunFlag, type)) != 0);
 }
 
 //________________________________________________________________________________________________________
 Bool_t StJetFrameworkPicoBase::GetMomentum(StThreeVectorF &mom, const StPicoBTowHit* tower, Double_t mass, StPicoEvent *PicoEvent) const {
   // initialize Emc position objects
-  StEmcPosition *Position = new StEmcPosition();
+  StEmcPositionCache *Position = StEmcPositionCache::Instance();
 
   // vertex components
   StThreeVectorF fVertex = PicoEvent->primaryVertex();
@@ -1039,7 +1086,7 @@ Bool_t StJetFrameworkPicoBase::GetMomentum(StThreeVectorF &mom, const StPicoBTow
   int towerID = tower->id();
 
   // get tower position
-  StThreeVectorF towerPosition = Position->getPosFromVertex(fVertex, towerID);
+  StThreeVectorF towerPosition = Position->GetPosFromVertex(fVertex, towerID);
   double posX = towerPosition.x();
   double posY = towerPosition.y();
   double posZ = towerPosition.z();
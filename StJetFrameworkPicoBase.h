@@ -30,9 +30,12 @@ class StPicoBTowHit;
 class StJetMakerTask;
 class StJet;
 class StRho;
+class StRhoBase;
 class StRhoParameter;
 //class StEventPoolManager;
 class StEventPlaneMaker;
+class StPicoTrackTableMaker;
+class StPicoEventHeaderMaker;
 
 class StJetFrameworkPicoBase : public StMaker {
   public:
@@ -233,6 +236,8 @@ class StJetFrameworkPicoBase : public StMaker {
     virtual void            SetRhoMakerName(const char *rn)           { fRhoMakerName = rn; }
     virtual void            SetRhoSparseMakerName(const char *rpn)    { fRhoSparseMakerName = rpn; }
     virtual void            SetEventPlaneMakerName(const char *epn)   { fEventPlaneMakerName = epn; }
+    virtual void            SetTrackTableMakerName(const char *ttn)   { fTrackTableMakerName = ttn; }
+    virtual void            SetEventHeaderMakerName(const char *ehn)  { fEventHeaderMakerName = ehn; }
 
     // add-to histogram name
     virtual void           AddToHistogramsName(TString add)           { fAddToHistogramsName = add  ; }
@@ -250,6 +255,10 @@ class StJetFrameworkPicoBase : public StMaker {
     Double_t               RelativePhi(Double_t mphi,Double_t vphi) const;               // relative jet track angle
     Double_t               RelativeEPJET(Double_t jetAng, Double_t EPAng) const;         // relative jet event plane angle
     Bool_t                 AcceptTrack(StPicoTrack *trk, Float_t B, StThreeVectorF Vert);// track accept cuts function
+    Bool_t                 GetAcceptedTrack(Int_t iTrk, StThreeVectorF &mom);           // track cuts + momentum, from track table when available
+    Bool_t                 InitTrackTable();                                            // find track table and register track cuts
+    Bool_t                 InitEventHeader(UInt_t triggerToUse = kTriggerANY, UInt_t mbEventType = 0, UInt_t emcTriggerEventType = 0); // find shared event header
+    void                   GetEventCentrality(Double_t zVertex, Int_t &cent16, Int_t &cent9, Double_t &refCorr2, Double_t &weight); // from event header when available
     //Bool_t                 AcceptTower(StPicoBTowHit *tower, StThreeVectorF Vertex);     // tower accept cuts function
     Double_t               GetReactionPlane(); // get reaction plane angle
     Int_t                  EventCounter();     // when called, provides Event #
@@ -323,8 +332,11 @@ class StJetFrameworkPicoBase : public StMaker {
     StPicoEvent    *mPicoEvent;
     StJetMakerTask *JetMaker;
     StJetMakerTask *JetMakerBG;
-    StRho          *RhoMaker;
+    StRhoBase      *RhoMaker;
     StEventPlaneMaker *EventPlaneMaker;
+    StPicoTrackTableMaker *fTrackTable;//! shared track table
+    Int_t          fTrackTableProfile;//! cut profile (bit) of track cuts in track table
+    StPicoEventHeaderMaker *fEventHeader;//! shared event header
 
     // centrality objects
     StRefMultCorr* grefmultCorr;
@@ -342,6 +354,8 @@ class StJetFrameworkPicoBase : public StMaker {
     TString        fRhoMakerName;
     TString        fRhoSparseMakerName;
     TString        fEventPlaneMakerName;
+    TString        fTrackTableMakerName;
+    TString        fEventHeaderMakerName;
 
     // Rho objects
     StRhoParameter        *GetRhoFromEvent(const char *name);
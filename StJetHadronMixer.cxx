@@ -0,0 +1,317 @@
+// $Id$
+//
+// Mixed-event jet-hadron correlation kernel, see StJetHadronMixer.h
+//
+
+#include "StJetHadronMixer.h"
+
+// ROOT includes
+#include "THnSparse.h"
+#include "TAxis.h"
+#include "TArrayD.h"
+#include "TMath.h"
+
+#include <iostream>
+
+using std::cout;
+using std::endl;
+
+//________________________________________________________________________
+StJetHadronMixer::StJetHadronMixer(THnSparse *hn, Int_t dimTrackPt, Int_t dimDEta, Int_t dimDPhi, Int_t dimCharge, Int_t maxSlices) :
+  fHn(hn),
+  fNDim(0),
+  fNDense(0),
+  fFixedBins(kFALSE),
+  fJets(),
+  fSlices(),
+  fMaxSlices(TMath::Max(maxSlices, 1)),
+  fTrkPt(),
+  fTrkEta(),
+  fTrkPhi(),
+  fTrkCharge(),
+  fTrkBin(),
+  fPairBin(),
+  fPairDEta(),
+  fPairDPhi(),
+  fCoord(),
+  fNPairs(0),
+  fNFlushes(0)
+{
+  // Constructor: sparse and its dimensions of the track axes
+  if(!fHn) {
+    cout<<"StJetHadronMixer: no THnSparse given!"<<endl;
+    return;
+  }
+
+  fNDim = fHn->GetNdimensions();
+  InitAxis(fAxisPt,     dimTrackPt);
+  InitAxis(fAxisDEta,   dimDEta);
+  InitAxis(fAxisDPhi,   dimDPhi);
+  InitAxis(fAxisCharge, dimCharge);
+
+  fFixedBins = (fAxisPt.fNBins > 0 && fAxisDEta.fNBins > 0 && fAxisDPhi.fNBins > 0 && fAxisCharge.fNBins > 0);
+  if(!fFixedBins) cout<<"StJetHadronMixer: track axes without fixed bin width, pairs are filled directly"<<endl;
+  fNDense = (fFixedBins) ? fAxisPt.fNBins * fAxisCharge.fNBins * fAxisDEta.fNBins * fAxisDPhi.fNBins : 0;
+
+  fCoord.resize(fNDim);
+  fSlices.reserve(fMaxSlices);
+}
+
+//________________________________________________________________________
+StJetHadronMixer::~StJetHadronMixer()
+{
+  // the counters are not flushed here: the sparse may already be gone
+}
+
+//________________________________________________________________________
+void StJetHadronMixer::InitAxis(StMixerAxis &axis, Int_t dim)
+{
+  // dense binning of a fixed-width axis, fNBins = 0 for variable bins
+  axis.fDim = dim;
+  axis.fNBins = 0;
+  axis.fMin = 0.;
+  axis.fMax = 0.;
+  if(dim < 0 || dim >= fNDim) return;
+
+  TAxis *ax = fHn->GetAxis(dim);
+  if(ax->GetXbins()->GetSize() != 0) return;
+  axis.fNBins = ax->GetNbins();
+  axis.fMin = ax->GetXmin();
+  axis.fMax = ax->GetXmax();
+}
+
+//________________________________________________________________________
+Int_t StJetHadronMixer::AddJet(const Double_t *entries, Double_t eta, Double_t phi, Double_t weight)
+{
+  // register a jet: <entries> is its full sparse entry, the values of the
+  // track axes are ignored, <weight> is applied to each pair
+  if(!fHn || weight <= 0) return -1;
+
+  StMixerJet jet;
+  jet.fEntries.assign(entries, entries + fNDim);
+  jet.fCoord.assign(fNDim, 0);
+  jet.fEta = eta;
+  jet.fPhi = phi;
+  jet.fWeight = weight;
+
+  // slice key: bins (incl. under- / overflow) of the non-track axes
+  jet.fKey = 0;
+  for(Int_t d = 0; d < fNDim; d++) {
+    if(d == fAxisPt.fDim || d == fAxisDEta.fDim || d == fAxisDPhi.fDim || d == fAxisCharge.fDim) continue;
+    TAxis *ax = fHn->GetAxis(d);
+    jet.fCoord[d] = ax->FindBin(entries[d]);
+    jet.fKey = jet.fKey * (ax->GetNbins() + 2) + jet.fCoord[d];
+  }
+
+  fJets.push_back(jet);
+  return fJets.size() - 1;
+}
+
+//________________________________________________________________________
+Int_t StJetHadronMixer::GetSlice(const StMixerJet &jet)
+{
+  // slice with the jet's bins and weight, all slices are flushed and
+  // reused if none is free
+  Int_t nSlices = fSlices.size();
+  Int_t iFree = -1;
+  for(Int_t i = 0; i < nSlices; i++) {
+    if(fSlices[i].fKey == jet.fKey && fSlices[i].fWeight == jet.fWeight) return i;
+    if(iFree < 0 && fSlices[i].fKey < 0) iFree = i;
+  }
+
+  if(iFree < 0) {
+    if(nSlices < fMaxSlices) {
+      fSlices.resize(nSlices + 1);
+      iFree = nSlices;
+      fSlices[iFree].fCounts.assign(fNDense, 0);
+      fSlices[iFree].fTouched.reserve(4096);
+    } else {
+      Flush();
+      iFree = 0;
+    }
+  }
+
+  StMixerSlice &slice = fSlices[iFree];
+  slice.fKey = jet.fKey;
+  slice.fWeight = jet.fWeight;
+  slice.fCoord = jet.fCoord;
+  slice.fNPairs = 0;
+  return iFree;
+}
+
+//________________________________________________________________________
+void StJetHadronMixer::FillEvent(Int_t ntrk, const Float_t *pt, const Float_t *eta, const Float_t *phi, const Char_t *charge)
+{
+  // pair the registered jets with the <ntrk> tracks of one pool event
+  if(!fHn || ntrk <= 0 || fJets.empty()) return;
+
+  const Double_t twopi = 2.*TMath::Pi();
+  ResizeBuffers(ntrk);
+  Double_t *tpt = &fTrkPt[0], *teta = &fTrkEta[0], *tphi = &fTrkPhi[0], *tq = &fTrkCharge[0];
+
+  // track part, once per pool event: shift phi to (0, 2pi)
+  for(Int_t i = 0; i < ntrk; i++) {
+    Double_t p = phi[i];
+    p = p + ((p < 0) ? twopi : 0.);
+    p = p - ((p > twopi) ? twopi : 0.);
+    tphi[i] = p;
+    tpt[i] = pt[i];
+    teta[i] = eta[i];
+    tq[i] = charge[i];
+  }
+  PairTracks(ntrk);
+}
+
+//________________________________________________________________________
+void StJetHadronMixer::FillEvent(Int_t ntrk, const UShort_t *pt, const UShort_t *eta, const UShort_t *phi, const Char_t *charge, const Double_t *range)
+{
+  // pair the registered jets with the <ntrk> quantized tracks of one pool
+  // event: value = min + code * (max - min) / 2^16 with <range> =
+  // {pt min, pt max, eta min, eta max, phi min, phi max}, phi in (0, 2pi)
+  // (StEventPool::fgQuantRange), decoded to float as StEventPool does
+  if(!fHn || ntrk <= 0 || fJets.empty()) return;
+
+  ResizeBuffers(ntrk);
+  Double_t *tpt = &fTrkPt[0], *teta = &fTrkEta[0], *tphi = &fTrkPhi[0], *tq = &fTrkCharge[0];
+  const Double_t ptStep = (range[1] - range[0])/65536., etaStep = (range[3] - range[2])/65536., phiStep = (range[5] - range[4])/65536.;
+  for(Int_t i = 0; i < ntrk; i++) {
+    tpt[i]  = (Float_t)(range[0] + pt[i]*ptStep);
+    teta[i] = (Float_t)(range[2] + eta[i]*etaStep);
+    tphi[i] = (Float_t)(range[4] + phi[i]*phiStep);
+    tq[i] = charge[i];
+  }
+  PairTracks(ntrk);
+}
+
+//________________________________________________________________________
+void StJetHadronMixer::ResizeBuffers(Int_t ntrk)
+{
+  // per pool event / per jet batch buffers
+  fTrkPt.resize(ntrk); fTrkEta.resize(ntrk); fTrkPhi.resize(ntrk); fTrkCharge.resize(ntrk);
+  fTrkBin.resize(ntrk); fPairBin.resize(ntrk); fPairDEta.resize(ntrk); fPairDPhi.resize(ntrk);
+}
+
+//________________________________________________________________________
+void StJetHadronMixer::PairTracks(Int_t ntrk)
+{
+  // pair the registered jets with the <ntrk> tracks in the track buffers
+  const Double_t pi = TMath::Pi();
+  const Double_t twopi = 2.*pi;
+  const Double_t phiLow = -0.5*pi;
+  const Double_t phiHigh = 3./2.*pi;
+
+  Double_t *tpt = &fTrkPt[0], *teta = &fTrkEta[0], *tphi = &fTrkPhi[0], *tq = &fTrkCharge[0];
+  Int_t *tbin = &fTrkBin[0], *pbin = &fPairBin[0];
+  Double_t *pdeta = &fPairDEta[0], *pdphi = &fPairDPhi[0];
+
+  // track part, once per pool event: pt and charge bins
+  const Int_t nPt = fAxisPt.fNBins, nQ = fAxisCharge.fNBins, nEta = fAxisDEta.fNBins, nPhi = fAxisDPhi.fNBins;
+  const Double_t ptMin = fAxisPt.fMin, ptMax = fAxisPt.fMax, qMin = fAxisCharge.fMin, qMax = fAxisCharge.fMax;
+  if(fFixedBins) {
+    for(Int_t i = 0; i < ntrk; i++) {
+      Double_t xpt = (tpt[i] >= ptMin) ? tpt[i] : ptMin;
+      xpt = (xpt < ptMax) ? xpt : ptMin;
+      Int_t in = (tpt[i] >= ptMin) & (tpt[i] < ptMax) & (tq[i] >= qMin) & (tq[i] < qMax);
+      Int_t ipt = (Int_t)(nPt*(xpt - ptMin)/(ptMax - ptMin));
+      Int_t iq  = (Int_t)(nQ*(tq[i] - qMin)/(qMax - qMin));
+      tbin[i] = in ? (ipt*nQ + iq)*nEta*nPhi : -1;
+    }
+  }
+
+  const Double_t etaMin = fAxisDEta.fMin, etaMax = fAxisDEta.fMax, dphiMin = fAxisDPhi.fMin, dphiMax = fAxisDPhi.fMax;
+  for(UInt_t ijet = 0; ijet < fJets.size(); ijet++) {
+    const StMixerJet &jet = fJets[ijet];
+    const Double_t jetEta = jet.fEta, jetPhi = jet.fPhi;
+
+    // delta eta, delta phi = RelativePhi(jet phi, track phi)
+    for(Int_t i = 0; i < ntrk; i++) {
+      Double_t dphi = jetPhi - tphi[i];
+      dphi = dphi + ((dphi < phiLow)  ? twopi : 0.);
+      dphi = dphi - ((dphi > phiHigh) ? twopi : 0.);
+      pdphi[i] = dphi;
+      pdeta[i] = jetEta - teta[i];
+    }
+
+    if(!fFixedBins) {
+      for(Int_t i = 0; i < ntrk; i++) FillPair(jet, tpt[i], pdeta[i], pdphi[i], tq[i]);
+      fNPairs += ntrk;
+      continue;
+    }
+
+    // dense bins
+    for(Int_t i = 0; i < ntrk; i++) {
+      Int_t in = (tbin[i] >= 0) & (pdeta[i] >= etaMin) & (pdeta[i] < etaMax) & (pdphi[i] >= dphiMin) & (pdphi[i] < dphiMax);
+      Double_t xeta = in ? pdeta[i] : etaMin;
+      Double_t xphi = in ? pdphi[i] : dphiMin;
+      Int_t ieta = (Int_t)(nEta*(xeta - etaMin)/(etaMax - etaMin));
+      Int_t iphi = (Int_t)(nPhi*(xphi - dphiMin)/(dphiMax - dphiMin));
+      pbin[i] = in ? tbin[i] + ieta*nPhi + iphi : -1;
+    }
+
+    // count
+    StMixerSlice &slice = fSlices[GetSlice(jet)];
+    UInt_t *counts = &slice.fCounts[0];
+    for(Int_t i = 0; i < ntrk; i++) {
+      Int_t b = pbin[i];
+      if(b < 0) { FillPair(jet, tpt[i], pdeta[i], pdphi[i], tq[i]); continue; }
+      if(counts[b]++ == 0) slice.fTouched.push_back(b);
+      slice.fNPairs++;
+    }
+    fNPairs += ntrk;
+  }
+}
+
+//________________________________________________________________________
+void StJetHadronMixer::FillPair(const StMixerJet &jet, Double_t pt, Double_t deta, Double_t dphi, Double_t charge)
+{
+  // single pair: direct fill of the sparse
+  Double_t x[32];
+  for(Int_t d = 0; d < fNDim && d < 32; d++) x[d] = jet.fEntries[d];
+  if(fAxisPt.fDim >= 0)     x[fAxisPt.fDim]     = pt;
+  if(fAxisDEta.fDim >= 0)   x[fAxisDEta.fDim]   = deta;
+  if(fAxisDPhi.fDim >= 0)   x[fAxisDPhi.fDim]   = dphi;
+  if(fAxisCharge.fDim >= 0) x[fAxisCharge.fDim] = charge;
+  fHn->Fill(x, jet.fWeight);
+}
+
+//________________________________________________________________________
+void StJetHadronMixer::FlushSlice(StMixerSlice &slice)
+{
+  // add counters of a slice to the sparse and reset them
+  if(slice.fKey < 0) return;
+
+  const Int_t nQ = fAxisCharge.fNBins, nEta = fAxisDEta.fNBins, nPhi = fAxisDPhi.fNBins;
+  const Double_t w = slice.fWeight;
+  const Bool_t doErrors = fHn->GetCalculateErrors();
+
+  for(Int_t d = 0; d < fNDim; d++) fCoord[d] = slice.fCoord[d];
+  for(UInt_t i = 0; i < slice.fTouched.size(); i++) {
+    Int_t b = slice.fTouched[i];
+    Double_t n = slice.fCounts[b];
+    slice.fCounts[b] = 0;
+
+    Int_t rest = b;
+    fCoord[fAxisDPhi.fDim]   = rest % nPhi + 1; rest /= nPhi;
+    fCoord[fAxisDEta.fDim]   = rest % nEta + 1; rest /= nEta;
+    fCoord[fAxisCharge.fDim] = rest % nQ   + 1; rest /= nQ;
+    fCoord[fAxisPt.fDim]     = rest + 1;
+
+    Long64_t bin = fHn->GetBin(&fCoord[0], kTRUE);
+    fHn->AddBinContent(bin, n*w);
+    if(doErrors) fHn->AddBinError2(bin, n*w*w);
+  }
+  fHn->SetEntries(fHn->GetEntries() + slice.fNPairs);
+
+  slice.fTouched.clear();
+  slice.fNPairs = 0;
+  slice.fKey = -1;
+  fNFlushes++;
+}
+
+//________________________________________________________________________
+void StJetHadronMixer::Flush()
+{
+  // add all counters to the sparse
+  if(!fHn) return;
+  for(UInt_t i = 0; i < fSlices.size(); i++) FlushSlice(fSlices[i]);
+}
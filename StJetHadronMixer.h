@@ -0,0 +1,127 @@
+#ifndef STJETHADRONMIXER_H
+#define STJETHADRONMIXER_H
+
+// $Id$
+//
+// Mixed-event jet-hadron correlation kernel.
+//
+// Replaces the per-pair THnSparse::Fill of the mixed-event loop: the jets of
+// the event are registered once (AddJet(): their full sparse entry, eta, phi
+// and weight), then each pool event is passed as contiguous track arrays
+// (FillEvent()). Track pt / charge bins and the wrapped track phi are
+// computed once per pool event, the jet - track delta eta / delta phi bins
+// per jet in loops over contiguous arrays. The pair values are computed in
+// double precision as in the per-pair loop, so that pairs at bin edges end
+// up in the same bins. Pairs are counted in dense pre-binned counters over
+// (track pt, charge, delta eta, delta phi) per slice, a slice being the bins
+// of the remaining (jet / event) axes plus the jet weight, e.g.
+// (centrality, jet pt, jet - EP angle, z-vertex).
+//
+// The counters are flushed into the THnSparse when all slices are in use
+// and by Flush(), which has to be called before the sparse is written.
+// Filled bins and entries are the same as when filling each pair, bin
+// contents and errors (Sumw2) up to rounding (n*w is added instead of n
+// times w), see macros/testJetHadronMixer.C. The weighted axis sums of
+// THnBase (GetMean / GetRMS) are not updated for flushed pairs. Pairs
+// outside of the axis ranges (under- / overflow) are filled directly.
+//
+// The sparse axes for track pt, delta eta, delta phi and charge need fixed
+// bin widths. The pair values follow the loop in StMyAnalysisMaker:
+//   track phi in [0, 2pi], delta eta = jet eta - track eta,
+//   delta phi = RelativePhi(jet phi, track phi) in [-0.5pi, 1.5pi]
+
+#include "Rtypes.h"
+#include <vector>
+
+class THnSparse;
+
+class StJetHadronMixer {
+
+ public:
+  StJetHadronMixer(THnSparse *hn, Int_t dimTrackPt = 2, Int_t dimDEta = 3, Int_t dimDPhi = 4, Int_t dimCharge = 7, Int_t maxSlices = 8);
+  virtual ~StJetHadronMixer();
+
+  // jets of the current event
+  void        ClearJets()                     { fJets.clear(); }
+  Int_t       AddJet(const Double_t *entries, Double_t eta, Double_t phi, Double_t weight);
+  Int_t       GetNumberOfJets() const         { return fJets.size(); }
+
+  // pair all jets with the tracks of one pool event
+  void        FillEvent(Int_t ntrk, const Float_t *pt, const Float_t *eta, const Float_t *phi, const Char_t *charge);
+  // same for 16 bit quantized tracks, <range>: pt, eta, phi [min, max) (StEventPool::fgQuantRange)
+  void        FillEvent(Int_t ntrk, const UShort_t *pt, const UShort_t *eta, const UShort_t *phi, const Char_t *charge, const Double_t *range);
+
+  // write counters to the sparse
+  void        Flush();
+
+  Long64_t    GetNumberOfPairs() const        { return fNPairs; }
+  Int_t       GetNumberOfFlushes() const      { return fNFlushes; }
+
+ protected:
+  // dense binning of one fixed-width sparse axis (without under- / overflow)
+  struct StMixerAxis {
+    Int_t     fDim;                              // sparse dimension
+    Int_t     fNBins;                            // number of bins
+    Double_t  fMin;                              // lower edge
+    Double_t  fMax;                              // upper edge
+  };
+
+  // registered jet
+  struct StMixerJet {
+    std::vector<Double_t> fEntries;              // sparse entry (track axes unused)
+    std::vector<Int_t>    fCoord;                // sparse bins of the slice axes
+    Long64_t              fKey;                  // slice key: bins of the slice axes
+    Double_t              fEta;                  // jet eta
+    Double_t              fPhi;                  // jet phi
+    Double_t              fWeight;               // pair weight
+  };
+
+  // dense counters of one slice
+  struct StMixerSlice {
+    Long64_t              fKey;                  // slice key (-1: unused)
+    Double_t              fWeight;               // pair weight
+    std::vector<Int_t>    fCoord;                // sparse bins of the slice axes
+    std::vector<UInt_t>   fCounts;               // pairs per dense bin
+    std::vector<Int_t>    fTouched;              // dense bins with counts
+    Long64_t              fNPairs;               // pairs since last flush
+  };
+
+  void        InitAxis(StMixerAxis &axis, Int_t dim);
+  void        ResizeBuffers(Int_t ntrk);
+  void        PairTracks(Int_t ntrk);
+  Int_t       GetSlice(const StMixerJet &jet);
+  void        FlushSlice(StMixerSlice &slice);
+  void        FillPair(const StMixerJet &jet, Double_t pt, Double_t deta, Double_t dphi, Double_t charge);
+
+  THnSparse                 *fHn;                // target sparse (not owned)
+  Int_t                      fNDim;              // sparse dimensions
+  StMixerAxis                fAxisPt;            // track pt axis
+  StMixerAxis                fAxisDEta;          // delta eta axis
+  StMixerAxis                fAxisDPhi;          // delta phi axis
+  StMixerAxis                fAxisCharge;        // track charge axis
+  Int_t                      fNDense;            // dense bins per slice
+  Bool_t                     fFixedBins;         // all track axes have fixed bin widths
+
+  std::vector<StMixerJet>    fJets;              // jets of current event
+  std::vector<StMixerSlice>  fSlices;            // dense slices
+  Int_t                      fMaxSlices;         // maximum number of slices before flush
+
+  // per pool event / per jet batch buffers
+  std::vector<Double_t>      fTrkPt;             // track pt
+  std::vector<Double_t>      fTrkEta;            // track eta
+  std::vector<Double_t>      fTrkPhi;            // track phi in [0, 2pi]
+  std::vector<Double_t>      fTrkCharge;         // track charge
+  std::vector<Int_t>         fTrkBin;            // dense offset of track pt / charge bin (-1: out of range)
+  std::vector<Int_t>         fPairBin;           // dense delta eta / delta phi bin (-1: out of range)
+  std::vector<Double_t>      fPairDEta;          // delta eta
+  std::vector<Double_t>      fPairDPhi;          // delta phi
+  std::vector<Int_t>         fCoord;             // sparse bins for flushes
+
+  Long64_t                   fNPairs;            // pairs counted
+  Int_t                      fNFlushes;          // slice flushes
+
+ private:
+  StJetHadronMixer(const StJetHadronMixer&);             // not implemented
+  StJetHadronMixer& operator=(const StJetHadronMixer&);  // not implemented
+};
+#endif
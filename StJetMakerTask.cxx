@@ -24,6 +24,7 @@
 
 #include <sstream>
 #include <fstream>
+#include <algorithm>
 
 // general StRoot classes
 #include "StThreeVectorF.hh"
@@ -52,6 +53,9 @@
 #include "StEmcUtil/projection/StEmcPosition.h"
 class StEmcPosition;
 class StEEmcCluster;
+#include "StEmcPositionCache.h"
+#include "StCorrectedTowerTable.h"
+#include "StPicoTriggerDecoder.h"
 
 // jet class and fastjet wrapper
 #include "StJet.h"
@@ -63,6 +67,11 @@ class StEEmcCluster;
 #include "StRoot/StRefMultCorr/CentralityMaker.h"
 
 #include "StJetPicoDefinitions.h"
+#include "StPicoTrackTableMaker.h"
+#include "StPicoEventHeaderMaker.h"
+#include "StRhoBase.h"
+#include "StRhoParameter.h"
+#include "StJetCacheMaker.h"
 
 class StMaker;
 class StChain;
@@ -71,6 +80,9 @@ class StPicoEvent;
 
 const Int_t StJetMakerTask::fgkConstIndexShift = 100000;
 
+// sort (pt, index) pairs of accepted jets by decreasing pt
+static bool SortJetPtDescending(const std::pair<Double_t, Int_t> &j1, const std::pair<Double_t, Int_t> &j2) { return j1.first > j2.first; }
+
 ClassImp(StJetMakerTask)
 
 //________________________________________________________________________
@@ -109,6 +121,8 @@ StJetMakerTask::StJetMakerTask() :
   fJetEtaMin(-0.6),
   fJetEtaMax(0.6),
   fGhostArea(0.005), 
+  fJetAreaType(fastjet::active_area_explicit_ghosts),
+  fGhostSeed(0),
   fMinJetTrackPt(0.2),
   fMaxJetTrackPt(20.0),
   fMinJetClusPt(0.15),
@@ -134,9 +148,29 @@ StJetMakerTask::StJetMakerTask() :
   fFillGhost(kFALSE),
   fJets(0x0),
   fConstituents(0),
+  fEventConstituents(0),
   fJetsConstit(0x0),
+  fJetDefs(),
+  fAcceptedJets(),
+  fJetTrackIndices(),
+  fJetTowerIndices(),
+  fFillJetQAHistos(kTRUE),
+  fTrackTableMakerName(""),
+  fTrackTable(0x0),
+  fTrackTableProfile(-1),
+  fEventHeaderMakerName(""),
+  fEventHeader(0x0),
+  doEventConstSub(kFALSE),
+  fRhoMakerName(""),
+  fJetCacheMakerName(""),
+  fCSMaxDeltaR(0.25),
+  fCSAlpha(0.),
+  fCSGhostArea(0.01),
   mGeom(StEmcGeom::instance("bemc")),
   mEmcCol(0),
+  mPosition(0x0),
+  fTowerTable(0x0),
+  fHadronicCorrSumTracks(kFALSE),
   mu(0x0),
   mPicoDstMaker(0x0),
   mPicoDst(0x0),
@@ -147,15 +181,6 @@ StJetMakerTask::StJetMakerTask() :
   // Default constructor.
   for(int i=0; i<8; i++) { fEmcTriggerArr[i] = kFALSE; }
 
-  for(int i=0; i<4801; i++) { 
-    fTowerToTriggerTypeHT1[i] = kFALSE;
-    fTowerToTriggerTypeHT2[i] = kFALSE;
-    fTowerToTriggerTypeHT3[i] = kFALSE; 
-
-    mTowerMatchTrkIndex[i] = 0;
-    mTowerStatusArr[i] = kFALSE;
-  }
-
 }
 
 //________________________________________________________________________
@@ -194,6 +219,8 @@ StJetMakerTask::StJetMakerTask(const char *name, double mintrackPt = 0.20, bool
   fJetEtaMin(-0.6), 
   fJetEtaMax(0.6),
   fGhostArea(0.005),
+  fJetAreaType(fastjet::active_area_explicit_ghosts),
+  fGhostSeed(0),
   fMinJetTrackPt(mintrackPt), //0.20
   fMaxJetTrackPt(20.0), 
   fMinJetClusPt(0.15),
@@ -219,9 +246,29 @@ StJetMakerTask::StJetMakerTask(const char *name, double mintrackPt = 0.20, bool
   fFillGhost(kFALSE),
   fJets(0x0),
   fConstituents(0),
+  fEventConstituents(0),
   fJetsConstit(0x0),
+  fJetDefs(),
+  fAcceptedJets(),
+  fJetTrackIndices(),
+  fJetTowerIndices(),
+  fFillJetQAHistos(kTRUE),
+  fTrackTableMakerName(""),
+  fTrackTable(0x0),
+  fTrackTableProfile(-1),
+  fEventHeaderMakerName(""),
+  fEventHeader(0x0),
+  doEventConstSub(kFALSE),
+  fRhoMakerName(""),
+  fJetCacheMakerName(""),
+  fCSMaxDeltaR(0.25),
+  fCSAlpha(0.),
+  fCSGhostArea(0.01),
   mGeom(StEmcGeom::instance("bemc")),
   mEmcCol(0),
+  mPosition(0x0),
+  fTowerTable(0x0),
+  fHadronicCorrSumTracks(kFALSE),
   mu(0x0),
   mPicoDstMaker(0x0),
   mPicoDst(0x0),
@@ -232,15 +279,6 @@ StJetMakerTask::StJetMakerTask(const char *name, double mintrackPt = 0.20, bool
   // Standard constructor.
   for(int i=0; i<8; i++) { fEmcTriggerArr[i] = kFALSE; }
 
-  for(int i=0; i<4801; i++) {
-    fTowerToTriggerTypeHT1[i] = kFALSE;
-    fTowerToTriggerTypeHT2[i] = kFALSE;
-    fTowerToTriggerTypeHT3[i] = kFALSE;
-
-    mTowerMatchTrkIndex[i] = 0;
-    mTowerStatusArr[i] = kFALSE;
-  }
-
   if (!name) return;
   SetName(name);
 }
@@ -274,6 +312,15 @@ StJetMakerTask::~StJetMakerTask()
 
   if(fHistQATowIDvsEta)        delete fHistQATowIDvsEta;
   if(fHistQATowIDvsPhi)        delete fHistQATowIDvsPhi;
+
+  if(fTowerTable)              delete fTowerTable;
+
+  // additional jet definitions
+  for(UInt_t idef = 0; idef < fJetDefs.size(); idef++) {
+    if(fJetDefs[idef].fFJWrapper) delete fJetDefs[idef].fFJWrapper;
+    if(fJetDefs[idef].fJets)      delete fJetDefs[idef].fJets;
+  }
+  fJetDefs.clear();
 }
 
 //
@@ -311,10 +358,23 @@ Int_t StJetMakerTask::Init() {
       AddDeadTowers("StRoot/StMyAnalysisMaker/towerLists/Empty_DeadTowers.txt");
   }
 
+  // shared BEMC tower geometry (built once per process)
+  mPosition = StEmcPositionCache::Instance();
+
+  // per-event corrected tower table
+  if(!fTowerTable) fTowerTable = new StCorrectedTowerTable();
+
   // Create user objects.
   fJets = new TClonesArray("StJet");
   fJets->SetName(fJetsName);
 
+  // reused per-event buffers of jet output
+  fAcceptedJets.reserve(200);
+  fConstituents.reserve(200);
+  fEventConstituents.reserve(2000);
+  fJetTrackIndices.reserve(100);
+  fJetTowerIndices.reserve(100);
+
   // may need array (name hard-coded, Feb20, 2018)
   fJetsConstit = new TClonesArray("StPicoTrack");
   fJetsConstit->SetName("JetConstituents");
@@ -322,39 +382,41 @@ Int_t StJetMakerTask::Init() {
   // ============================ set jet parameters for fastjet wrapper  =======================
   // recombination schemes:
   // E_scheme, pt_scheme, pt2_scheme, Et_scheme, Et2_scheme, BIpt_scheme, BIpt2_scheme, WTA_pt_scheme, WTA_modp_scheme
-  fastjet::RecombinationScheme    recombScheme;
-  if (fRecombScheme == 0)     recombScheme = fastjet::E_scheme;
-  if (fRecombScheme == 1)     recombScheme = fastjet::pt_scheme; 
-  if (fRecombScheme == 2)     recombScheme = fastjet::pt2_scheme;
-  if (fRecombScheme == 3)     recombScheme = fastjet::Et_scheme;
-  if (fRecombScheme == 4)     recombScheme = fastjet::Et2_scheme;
-  if (fRecombScheme == 5)     recombScheme = fastjet::BIpt_scheme;
-  if (fRecombScheme == 6)     recombScheme = fastjet::BIpt2_scheme;
-  if (fRecombScheme == 7)     recombScheme = fastjet::WTA_pt_scheme;
-  if (fRecombScheme == 8)     recombScheme = fastjet::WTA_modp_scheme;
-  if (fRecombScheme == 99)    recombScheme = fastjet::external_scheme;
+  fastjet::RecombinationScheme    recombScheme = GetFJRecombScheme(fRecombScheme);
 
   // jet algorithm
-  fastjet::JetAlgorithm          algorithm;
-  if (fJetAlgo == 1)      algorithm = fastjet::antikt_algorithm;
-  if (fJetAlgo == 0)      algorithm = fastjet::kt_algorithm;
-  // extra algorithms
-  if (fJetAlgo == 2)      algorithm = fastjet::cambridge_algorithm;
-  if (fJetAlgo == 3)      algorithm = fastjet::genkt_algorithm;
-  if (fJetAlgo == 11)     algorithm = fastjet::cambridge_for_passive_algorithm;
-  if (fJetAlgo == 13)     algorithm = fastjet::genkt_for_passive_algorithm;
-  if (fJetAlgo == 99)     algorithm = fastjet::plugin_algorithm;
-  if (fJetAlgo == 999)    algorithm = fastjet::undefined_jet_algorithm;
+  fastjet::JetAlgorithm          algorithm = GetFJJetAlgorithm(fJetAlgo);
   fastjet::Strategy               strategy = fastjet::Best;
 
   // setup fj wrapper
-  fjw.SetAreaType(fastjet::active_area_explicit_ghosts);
+  fjw.SetAreaType((fastjet::AreaType)fJetAreaType);
   fjw.SetStrategy(strategy);
   fjw.SetGhostArea(fGhostArea);
   fjw.SetR(fRadius);
   fjw.SetAlgorithm(algorithm);        //fJetAlgo);
   fjw.SetRecombScheme(recombScheme);  //fRecombScheme);
   fjw.SetMaxRap(1);
+  fjw.SetFixedGhosts(fGhostSeed);
+  fjw.SetEventSubtractionParameters(fCSMaxDeltaR, fCSAlpha, fCSGhostArea);
+
+  // additional jet definitions: same settings as main wrapper except algorithm, R, scheme and area type
+  for(UInt_t idef = 0; idef < fJetDefs.size(); idef++) {
+    StJetDefinition &def = fJetDefs[idef];
+    const char *defJetsName = def.fJetsName.Data();
+    def.fFJWrapper = new StFJWrapper(defJetsName, defJetsName);
+    def.fFJWrapper->CopySettingsFrom(fjw);
+    def.fFJWrapper->SetAlgorithm(GetFJJetAlgorithm(def.fJetAlgo));
+    def.fFJWrapper->SetR(def.fRadius);
+    def.fFJWrapper->SetRecombScheme(GetFJRecombScheme(def.fRecombScheme));
+    def.fFJWrapper->SetAreaType((fastjet::AreaType)def.fAreaType);
+
+    def.fJets = new TClonesArray("StJet");
+    def.fJets->SetName(defJetsName);
+  }
+
+  // build the jet, area and range definitions once: kept for all events
+  fjw.InitDefinitions();
+  for(UInt_t idef = 0; idef < fJetDefs.size(); idef++) fJetDefs[idef].fFJWrapper->InitDefinitions();
 
   // setting legacy mode
   //if(fLegacyMode) { fjw.SetLegacyMode(kTRUE); }
@@ -503,20 +565,21 @@ void StJetMakerTask::WriteHistograms() {
 void StJetMakerTask::Clear(Option_t *opt) {
   // clear or delete objects after running
   fJets->Clear();
+  for(UInt_t idef = 0; idef < fJetDefs.size(); idef++) {
+    if(fJetDefs[idef].fJets) fJetDefs[idef].fJets->Clear();
+  }
 }
 
 //________________________________________________________________________
 int StJetMakerTask::Make()
 {
   // Main loop, called for each event.
-  // ZERO's out the jet array
-  fJets->Delete();
+  // ZERO's out the jet array: StJet objects are kept and reused (see FillJetBranch())
+  fJets->Clear();
+  for(UInt_t idef = 0; idef < fJetDefs.size(); idef++) fJetDefs[idef].fJets->Clear();
 
-  // April9 test - ZERO these out for double checking they aren't set
-  for(int i = 0; i < 4801; i++) {
-    mTowerMatchTrkIndex[i] = 0;
-    mTowerStatusArr[i] = kFALSE;
-  }
+  // tower table is read by downstream makers: empty for skipped events
+  fTowerTable->Reset();
 
   // get PicoDstMaker 
   mPicoDstMaker = static_cast<StPicoDstMaker*>(GetMaker("picoDst"));
@@ -539,6 +602,10 @@ int StJetMakerTask::Make()
     return kStWarn;
   }
 
+  // shared event header (if set): event rejected for the whole chain
+  if(!InitEventHeader()) return kStWarn;
+  if(fEventHeader && !fEventHeader->IsEventSelected()) return kStOk;
+
   // get event B (magnetic) field
   Bfield = mPicoEvent->bField();
 
@@ -548,20 +615,23 @@ int StJetMakerTask::Make()
 
   // Z-vertex cut - - per the Aj analysis (-40, 40)
   // TEST: kStOk -> kStErr // Error, drop this and go to the next event
-  if((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut)) return kStOk; //Pico::kSkipThisEvent;
+  // (done once per event by the shared event header when set)
+  if(!fEventHeader && ((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut))) return kStOk; //Pico::kSkipThisEvent;
 
   // ============================ CENTRALITY ============================== //
   // 10 14 21 29 40 54 71 92 116 145 179 218 263 315 373 441  // RUN 14 AuAu binning
-  int RunId = mPicoEvent->runId();
-  double fBBCCoincidenceRate = mPicoEvent->BBCx();
-  double fZDCCoincidenceRate = mPicoEvent->ZDCx();
-  int grefMult = mPicoEvent->grefMult();
-  grefmultCorr->init(RunId);
-  if(doUseBBCCoincidenceRate) { grefmultCorr->initEvent(grefMult, zVtx, fBBCCoincidenceRate); } // default
-  else{ grefmultCorr->initEvent(grefMult, zVtx, fZDCCoincidenceRate); }
-  grefmultCorr->initEvent(grefMult, zVtx, fBBCCoincidenceRate);
-  grefmultCorr->getRefMultCorr(grefMult, zVtx, fBBCCoincidenceRate, 2);
-  int cent16 = grefmultCorr->getCentralityBin16();
+  int cent16 = -1;
+  if(fEventHeader) {
+    // centrality correction done once per event by the shared event header
+    cent16 = fEventHeader->GetEventRecord().fCent16;
+  } else {
+    int RunId = mPicoEvent->runId();
+    double fCoincidenceRate = (doUseBBCCoincidenceRate) ? mPicoEvent->BBCx() : mPicoEvent->ZDCx();
+    int grefMult = mPicoEvent->grefMult();
+    grefmultCorr->init(RunId);
+    grefmultCorr->initEvent(grefMult, zVtx, fCoincidenceRate);
+    cent16 = grefmultCorr->getCentralityBin16();
+  }
   if(cent16 == -1) return kStOk; // - this is for lowest multiplicity events 80%+ centrality, cut on them
   int centbin = GetCentBin(cent16, 16);
   double centralityScaled = centbin*5.0;
@@ -584,12 +654,71 @@ int StJetMakerTask::Make()
   if((fTriggerToUse == StJetFrameworkPicoBase::kTriggerHT) && (!fHaveEmcTrigger))return kStOK;  // HT triggered event
   // else fTriggerToUse is ANY and we still want to run analysis
 
+  // jets from the jet DST cache: no jet finding
+  if(fJetCacheMakerName != "") return FillJetsFromCache();
+
+  // shared track table (optional)
+  if(!InitTrackTable()) return kStWarn;
+
+  // event-wide constituent subtraction: rho and rho_m from the rho maker
+  if(doEventConstSub) {
+    StRhoBase *rhoMaker = static_cast<StRhoBase*>(GetMaker(fRhoMakerName));
+    const char *fRhoMakerNameCh = fRhoMakerName;
+    if(!rhoMaker || !rhoMaker->GetRho()) {
+      LOG_WARN << Form(" No %s! Skip! ", fRhoMakerNameCh) << endm;
+      return kStWarn;
+    }
+    Double_t rhom = (rhoMaker->GetRhoM()) ? rhoMaker->GetRhoM()->GetVal() : 0.;
+    fjw.SetRhoRhom(rhoMaker->GetRho()->GetVal(), rhom);
+  }
+
   // Find jets:  deprecated version -> FindJets(tracks, clus, fJetAlgo, fRadius);
   FindJets();
 
-  // Fill jet branch
+  // Fill jet branch (constituents of all jet definitions go to the event constituent table)
+  fEventConstituents.clear();
   FillJetBranch();
 
+  // Fill jet branches of additional jet definitions (no constituent QA histograms)
+  fFillJetQAHistos = kFALSE;
+  for(UInt_t idef = 0; idef < fJetDefs.size(); idef++) {
+    StJetDefinition &def = fJetDefs[idef];
+    FillJetBranch(*def.fFJWrapper, def.fJets, def.fRadius, (def.fMinJetPt < 0) ? fMinJetPt : def.fMinJetPt);
+  }
+  fFillJetQAHistos = kTRUE;
+
+  return kStOK;
+}
+
+/**
+ * Fills the jet collections (main and additional definitions) with the jets of the current
+ * event from the jet DST cache maker (StJetCacheMaker in kRead mode), matched by collection name.
+ * The jets have no constituent four-momenta and the FastJet wrappers are not run.
+ */
+Int_t StJetMakerTask::FillJetsFromCache()
+{
+  StJetCacheMaker *cache = static_cast<StJetCacheMaker*>(GetMaker(fJetCacheMakerName));
+  const char *fJetCacheMakerNameCh = fJetCacheMakerName;
+  if(!cache) {
+    LOG_WARN << Form(" No %s! Skip! ", fJetCacheMakerNameCh) << endm;
+    return kStWarn;
+  }
+
+  // event not in cache: no jets
+  if(!cache->LoadEvent(mPicoEvent->runId(), mPicoEvent->eventId())) return kStOk;
+
+  for(Int_t idef = -1; idef < (Int_t)fJetDefs.size(); idef++) {
+    TClonesArray *jets = (idef < 0) ? fJets : fJetDefs[idef].fJets;
+    TClonesArray *cachedJets = cache->GetCachedJets(jets->GetName());
+    if(!cachedJets) continue;
+
+    const Int_t njets = cachedJets->GetEntriesFast();
+    for(Int_t ij = 0; ij < njets; ij++) {
+      StJet *jet = static_cast<StJet*>(jets->ConstructedAt(ij, "C"));
+      *jet = *static_cast<StJet*>(cachedJets->At(ij));
+    }
+  }
+
   return kStOK;
 }
 
@@ -612,33 +741,17 @@ void StJetMakerTask::FindJets()
   // clear out existing wrapper object
   fjw.Clear();
 
-  // initialize Emc position objects
-  StEmcPosition *mPosition = new StEmcPosition();
-
   // assume neutral pion mass
   // additional parameters constructed
-  double pi = 1.0*TMath::Pi();
   double pi0mass = Pico::mMass[0]; // GeV
   unsigned int ntracks = mPicoDst->numberOfTracks();
 
   // loop over ALL tracks in PicoDst and add to jet, after acceptance and quality cuts 
   if((fJetType == kFullJet) || (fJetType == kChargedJet)) {
     for(unsigned short iTracks = 0; iTracks < ntracks; iTracks++){
-      StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(iTracks));
-      if(!trk){ continue; }
-
-      // acceptance and kinematic quality cuts
-      if(!AcceptJetTrack(trk, Bfield, mVertex)) { continue; }
-
-      // get momentum vector of track - global or primary track
+      // acceptance and kinematic quality cuts, get momentum vector of track - global or primary track
       StThreeVectorF mTrkMom;
-      if(doUsePrimTracks) { 
-        // get primary track vector
-        mTrkMom = trk->pMom(); 
-      } else { 
-        // get global track vector
-        mTrkMom = trk->gMom(mVertex, Bfield); 
-      }
+      if(!GetAcceptedJetTrack(iTracks, mTrkMom)) { continue; }
 
       // track variables
       //double pt = mTrkMom.perp();
@@ -659,151 +772,49 @@ void StJetMakerTask::FindJets()
 
   // full or neutral jets - get towers and apply hadronic correction
   if((fJetType == kFullJet) || (fJetType == kNeutralJet)) {
-    // ==================== March 6th, 2018
-    // towerStatus array
-    //float mTowerMatchTrkIndex[4801] = { 0 };
-    //bool mTowerStatusArr[4801] = { 0 };
-    int matchedTowerTrackCounter = 0;
-
-    // print
-    //int nTracks = mPicoDst->numberOfTracks();
-    //int nTrigs = mPicoDst->numberOfEmcTriggers();
-    //int nBTowHits = mPicoDst->numberOfBTOWHits();
-    int nBEmcPidTraits = mPicoDst->numberOfBEmcPidTraits();
-    //cout<<"nTracks = "<<nTracks<<"  nTrigs = "<<nTrigs<<"  nBTowHits = "<<nBTowHits<<"  nBEmcPidTraits = "<<nBEmcPidTraits<<endl;
-  
-    // loop over ALL clusters in PicoDst to get track<->tower matches saved to arrays for hadronic correction
-    for(unsigned short iClus = 0; iClus < nBEmcPidTraits; iClus++){
-      StPicoBEmcPidTraits* cluster = static_cast<StPicoBEmcPidTraits*>(mPicoDst->bemcPidTraits(iClus));
-      if(!cluster){ cout<<"Cluster pointer does not exist.. iClus = "<<iClus<<endl; continue; }
-
-      // cluster and tower ID
-      // ID's are calculated as such:
-      // mBtowId       = (ntow[0] <= 0 || ntow[0] > 4800) ? -1 : (Short_t)ntow[0];
-      // mBtowId23 = (ntow[1] < 0 || ntow[1] >= 9 || ntow[2] < 0 || ntow[2] >= 9) ? -1 : (Char_t)(ntow[1] * 10 + ntow[2]);
-      // commented out clusID, towID2, towID3 on May20
-      //int clusID = cluster->bemcId();  // index in bemc point array
-      int towID = cluster->btowId();   // projected tower Id: 1 - 4800
-      //int towID2 = cluster->btowId2(); // emc 2nd and 3rd closest tower local id  ( 2nd X 10 + 3rd), each id 0-8
-      //int towID3 = cluster->btowId3(); // emc 2nd and 3rd closest tower local id  ( 2nd X 10 + 3rd), each id 0-8
-      if(towID < 0) continue;
-
-      // cluster and tower position - from vertex and ID - shouldn't need to correct via this method
-      ///StThreeVectorF towPosition = mPosition->getPosFromVertex(mVertex, towID);
-      ///double towPhi = towPosition.phi();
-      ///double towEta = towPosition.pseudoRapidity();
-
-      // matched track index
-      int trackIndex = cluster->trackIndex();
-      StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(trackIndex));
-      if(!trk) { cout<<"No trk pointer...."<<endl; continue; }
-
-      // TODO should check this FIXME
-      //if(!AcceptJetTrack(trk, Bfield, mVertex)) { continue; } // FIXME - do I want to apply quality cuts to matched track?
-      if(AcceptJetTrack(trk, Bfield, mVertex)) {
-
-        // tower status set - towerID is matched to track passing quality cuts
-        mTowerMatchTrkIndex[towID] = trackIndex;
-        mTowerStatusArr[towID] = kTRUE;
-        matchedTowerTrackCounter++;
-      } // when tracks meet cuts, save matching to arrays
-    } // PIDTraits loop
-
-    // loop over towers and add input vectors to fastjet
-    int nTowers = mPicoDst->numberOfBTOWHits();
-    for(int itow = 0; itow < nTowers; itow++) {
-      StPicoBTowHit *tower = static_cast<StPicoBTowHit*>(mPicoDst->btowHit(itow));
-      if(!tower) { cout<<"No tower pointer... iTow = "<<itow<<endl; continue; }
-
-      // tower ID
-      int towerID = tower->id();
-      if(towerID < 0) continue; // double check these aren't still in the event list
-
-      // cluster and tower position - from vertex and ID: shouldn't need additional eta correction
-      StThreeVectorF towerPosition = mPosition->getPosFromVertex(mVertex, towerID);
-      double towerPhi = towerPosition.phi();
-      if(towerPhi < 0)    towerPhi += 2.0*pi;
-      if(towerPhi > 2*pi) towerPhi -= 2.0*pi;
-      double towerEta = towerPosition.pseudoRapidity();
-      //int towerADC = tower->adc();
-      double towerEunCorr = tower->energy();  // uncorrected energy
-      double towerE = tower->energy();        // corrected energy (hadronically - done below)
-
-      // tower matched to firing trigger - TODO
-      //if(fTowerToTriggerTypeHT1[emcTrigID])
-      //if(fTowerToTriggerTypeHT2[emcTrigID])
-      //if(fTowerToTriggerTypeHT3[emcTrigID])
-
-      // perform tower cuts
-      // if tower was not matched to an accepted track, use it for jet by itself if > 0.2 GeV
-      if(mTowerStatusArr[towerID]) {
-        //if(mTowerMatchTrkIndex[towerID] > 0) 
-        StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track( mTowerMatchTrkIndex[towerID] ));
-        if(!trk) { cout<<"No trk pointer...."<<endl; continue; }
-
-        // TODO want to process tower on its own if track did not meet quality cut
-        // this should already be done above
-        //if(!AcceptJetTrack(trk, Bfield, mVertex)) { continue; }
-        if(AcceptJetTrack(trk, Bfield, mVertex)) {
-
-          // get track variables to matched tower
-          StThreeVectorF mTrkMom;
-          if(doUsePrimTracks) { 
-            // get primary track vector
-            mTrkMom = trk->pMom(); 
-          } else { 
-            // get global track vector
-            mTrkMom = trk->gMom(mVertex, Bfield); 
-          }
-
-          // track variables
-          //double pt = mTrkMom.perp();
-          //double phi = mTrkMom.phi();
-          //double eta = mTrkMom.pseudoRapidity();
-          double p = mTrkMom.mag();
-          double E = 1.0*TMath::Sqrt(p*p + pi0mass*pi0mass);
-
-          // apply hadronic correction to tower
-          towerE = towerEunCorr - (mHadronicCorrFrac * E);
-        }  
-      } 
-      // else - no match so treat towers on their own
-
-      // cut on transverse tower energy
-      double towerEt = towerE / (1.0*TMath::CosH(towerEta));
-      if(towerEt < 0) towerEt = 0.0;
-      if(towerEt < mTowerEnergyMin) continue;
-
-      // check for bad (and dead) towers
-      bool TowerOK = IsTowerOK(towerID);
-      bool TowerDead = IsTowerDead(towerID);
-      if(!TowerOK) {  //cout<<"towerID bad = "<<towerID<<endl;
-        continue;
-      }
-      //if(TowerDead) continue;
+    // corrected tower table: hadronic correction and tower cuts done once for the event
+    PrepareTowers();
+
+    // loop over fired towers and add input vectors to fastjet
+    for(int row = 0; row < fTowerTable->GetNumberOfTowers(); row++) {
+      // tower passes Et cut and is not on bad tower list
+      if(!fTowerTable->TestStatusBit(row, StCorrectedTowerTable::kAccepted)) continue;
 
-      //if(towerID == 796 || towerID == 1427 || towerID == 1984 || towerID == 2214 || towerID == 3488 || towerID == 3692 || towerID == 1125 || towerID == 1221) cout<<"towerID = "<<towerID<<"  E = "<<towerE<<"  eta = "<<towerEta<<"  phi = "<<towerPhi<<"  zVtx = "<<zVtx<<endl;
+      // corrected energy
+      double towerE = fTowerTable->GetE(row);
 
       // get components from Energy (p - momentum)
-      // the below lines 'converts' the tower energy to momentum
-      StThreeVectorF mom;
-      GetMomentum(mom, tower, pi0mass);
-      double towerPx = mom.x();
-      double towerPy = mom.y();
-      double towerPz = mom.z();
+      // the below lines 'converts' the (uncorrected) tower energy to momentum along the tower direction
+      double towerEunCorr = fTowerTable->GetRawE(row);
+      double p = 1.0*TMath::Sqrt(towerEunCorr*towerEunCorr - pi0mass*pi0mass);
+      double coshEta = fTowerTable->GetCoshEta(row);
+      double sinhEta = 1.0*TMath::SinH(fTowerTable->GetEta(row));
+      double towerPx = p * TMath::Cos(fTowerTable->GetPhi(row)) / coshEta;
+      double towerPy = p * TMath::Sin(fTowerTable->GetPhi(row)) / coshEta;
+      double towerPz = p * sinhEta / coshEta;
 
       // add towers to fastjet
       // shift tower index (tracks 0+, ghosts = -1, towers < -1)
-      int uidTow = -(itow + 2);  
+      int uidTow = -(fTowerTable->GetHitIndex(row) + 2);
       fjw.AddInputVector(towerPx, towerPy, towerPz, towerE, uidTow); // includes E
     } // tower loop
 
-// ====================
   } // neutral/full jets
 
+  // event-wide constituent subtraction: subtracted particles are clustered
+  if(doEventConstSub) fjw.SubtractEventConstituents();
+
   // run jet finder
   fjw.Run();
 
+  // run additional jet definitions on the same input vectors (user index is kept)
+  for(UInt_t idef = 0; idef < fJetDefs.size(); idef++) {
+    StFJWrapper *wrapper = fJetDefs[idef].fFJWrapper;
+    wrapper->Clear();
+    wrapper->AddInputVectors(fjw.GetInputVectors());
+    wrapper->Run();
+  }
+
 }
 
 /**
@@ -813,55 +824,68 @@ void StJetMakerTask::FindJets()
  */
 void StJetMakerTask::FillJetBranch()
 {
-  std::vector<fastjet::PseudoJet> jets_incl = fjw.GetInclusiveJets();
-  // sort jets according to jet pt
-  static Int_t indexes[9999] = {-1};
-  GetSortedArray(indexes, jets_incl);
+  // main jet definition
+  FillJetBranch(fjw, fJets, fRadius, fMinJetPt);
+}
+
+/**
+ * Fills the jet collection 'jets' with the jets found by the FastJet wrapper 'wrapper':
+ * used for the main and the additional jet definitions.
+ */
+void StJetMakerTask::FillJetBranch(StFJWrapper &wrapper, TClonesArray *jets, Double_t radius, Double_t minJetPt)
+{
+  const std::vector<fastjet::PseudoJet> &jets_incl = wrapper.GetInclusiveJets();
+  const Double_t minJetArea = fMinJetArea*TMath::Pi()*radius*radius;
 
-  // loop over FastJet jets
+  // PERFORM CUTS ON inclusive JETS before building any StJet
+  // accepted jets: (pt, index) pairs, buffer reused between events
+  fAcceptedJets.clear();
   __DEBUG(StJetFrameworkPicoBase::kDebugFillJets, Form("%d jets found", (Int_t)jets_incl.size()));
-  //for(UInt_t ij = 0, jetCount = 0; ij < jets_incl.size(); ++ij) {
-  for(UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
-    Int_t ij = indexes[ijet];
-    __DEBUG(StJetFrameworkPicoBase::kDebugFillJets,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fjw.GetJetArea(ij)));
+  for(UInt_t ij = 0; ij < jets_incl.size(); ++ij) {
+    const fastjet::PseudoJet &jet_incl = jets_incl[ij];
+    Double_t jetPt = jet_incl.perp();
+    __DEBUG(StJetFrameworkPicoBase::kDebugFillJets,Form("Jet pt = %f, area = %f", jetPt, wrapper.GetJetArea(ij)));
 
-    // PERFORM CUTS ON inclusive JETS before saving
     // cut on min jet pt
-    if(jets_incl[ij].perp() < fMinJetPt) continue;
-    // cut on min jet area
-    if(fjw.GetJetArea(ij) < fMinJetArea*TMath::Pi()*fRadius*fRadius) continue;
+    if(jetPt < minJetPt) continue;
     // cut on eta acceptance
-    if((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax)) continue;
+    if((jet_incl.eta() < fJetEtaMin) || (jet_incl.eta() > fJetEtaMax)) continue;
     // cut on phi acceptance 
-    if((jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax)) continue;
+    if((jet_incl.phi() < fJetPhiMin) || (jet_incl.phi() > fJetPhiMax)) continue;
+    // cut on min jet area
+    if(wrapper.GetJetArea(ij) < minJetArea) continue;
+
+    fAcceptedJets.push_back(std::make_pair(jetPt, (Int_t)ij));
+  }
+
+  // sort accepted jets according to jet pt (decreasing)
+  std::sort(fAcceptedJets.begin(), fAcceptedJets.end(), SortJetPtDescending);
+
+  // loop over accepted FastJet jets
+  for(UInt_t jetCount = 0; jetCount < fAcceptedJets.size(); ++jetCount) {
+    Int_t ij = fAcceptedJets[jetCount].second;
+    const fastjet::PseudoJet &jet_incl = jets_incl[ij];
 
+    // reuse StJet object from previous events: cleared and set here
     // need to figure out how to get m or E from STAR tracks
-    //StJet *jet = new ((*fJets)[jetCount]) 
-    //  StJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
-    StJet *jet = new ((*fJets)[jetCount])
-      StJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
+    StJet *jet = static_cast<StJet*>(jets->ConstructedAt(jetCount, "C"));
+    jet->SetPtEtaPhiM(jet_incl.perp(), jet_incl.eta(), jet_incl.phi(), jet_incl.m());
 
     jet->SetLabel(ij);
 
     // area vector and components
-    fastjet::PseudoJet area(fjw.GetJetAreaVector(ij));
-    jet->SetArea(area.perp());  // same as fjw.GetJetArea(ij)
+    fastjet::PseudoJet area(wrapper.GetJetAreaVector(ij));
+    jet->SetArea(area.perp());  // same as wrapper.GetJetArea(ij)
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
     jet->SetAreaE(area.E());
 
-    // March 8, 2018 - probably don't need this anymore after coming up with method to pass and extract constituents via index!
-    // get constituents of jets
-    fConstituents = fjw.GetJetConstituents(ij);
-    jet->SetJetConstituents(fConstituents);
-
-    // fill jet constituents
-    vector<fastjet::PseudoJet> constituents = fjw.GetJetConstituents(ij);
-    FillJetConstituents(jet, constituents, constituents);
+    // get constituents of jets (buffer reused) and fill jet constituents:
+    // constituents are stored in StJet by index (tracks: track index, towers: tower index)
+    wrapper.GetJetConstituents(ij, fConstituents);
+    FillJetConstituents(jet, fConstituents, fConstituents);
 
     __DEBUG(StJetFrameworkPicoBase::kDebugFillJets, Form("Added jet n. %d, pt = %f, area = %f, constituents = %d", jetCount, jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
-
-    jetCount++;
   } // jet loop 
 
 }
@@ -884,14 +908,11 @@ void StJetMakerTask::FillJetConstituents(StJet *jet, std::vector<fastjet::Pseudo
   Int_t nc = 0; // cluster counter
   Int_t ng = 0; // ghost counter  
   double pi = 1.0*TMath::Pi();
-  double pi0mass = Pico::mMass[0]; // GeV
-
-  // get EMCal position
-  StEmcPosition *mPosition = new StEmcPosition();
 
-  // initially set track and cluster constituent sizes
-  jet->SetNumberOfTracks(constituents.size());
-  jet->SetNumberOfClusters(constituents.size());
+  // accepted track and tower indices: set to jet once at the end (buffers reused)
+  fJetTrackIndices.clear();
+  fJetTowerIndices.clear();
+  Int_t firstConstit = fEventConstituents.size();
 
   // loop over constituents for ij'th jet
   for(UInt_t ic = 0; ic < constituents.size(); ++ic) {
@@ -900,23 +921,10 @@ void StJetMakerTask::FillJetConstituents(StJet *jet, std::vector<fastjet::Pseudo
 
     // CHARGED COMPONENT (tracks)
     if(uid >= 0) {
-      jet->AddTrackAt(uid, nt);
-      StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(uid));
-      if(!trk) continue;
-
       // acceptance and kinematic quality cuts - probably not needed (done before passing to fastjet) FIXME
-      if(!AcceptJetTrack(trk, Bfield, mVertex)) { continue; }
-
-      // primary track switch
       // get momentum vector of track - global or primary track
       StThreeVectorF mTrkMom;
-      if(doUsePrimTracks) {
-        // get primary track vector
-        mTrkMom = trk->pMom();
-      } else {
-        // get global track vector
-        mTrkMom = trk->gMom(mVertex, Bfield);
-      }
+      if(!GetAcceptedJetTrack(uid, mTrkMom)) { continue; }
 
       // track variables
       double pt = mTrkMom.perp();
@@ -931,12 +939,16 @@ void StJetMakerTask::FillJetConstituents(StJet *jet, std::vector<fastjet::Pseudo
       if(pt > maxTrack) maxTrack = pt;
 
       // fill some QA histograms
-      fHistJetNTrackvsPt->Fill(pt);
-      fHistJetNTrackvsPhi->Fill(phi);
-      fHistJetNTrackvsEta->Fill(eta);
-      fHistJetNTrackvsPhivsEta->Fill(phi, eta);
+      if(fFillJetQAHistos) {
+        fHistJetNTrackvsPt->Fill(pt);
+        fHistJetNTrackvsPhi->Fill(phi);
+        fHistJetNTrackvsEta->Fill(eta);
+        fHistJetNTrackvsPhivsEta->Fill(phi, eta);
+      }
 
-      // increase track counter
+      // add track index and increase track counter
+      fJetTrackIndices.push_back(uid);
+      fEventConstituents.push_back(constituents[ic]);
       nt++;
     } else { // uid < 0
 
@@ -951,78 +963,42 @@ void StJetMakerTask::FillJetConstituents(StJet *jet, std::vector<fastjet::Pseudo
       if(uid < -1) {
         // convert uid to tower index (index of tower)
         Int_t towIndex = -(uid + 2);   // 1 less than towerID
-        jet->AddClusterAt(towIndex, nc);
-        StPicoBTowHit *tower = static_cast<StPicoBTowHit*>(mPicoDst->btowHit(towIndex));
-        if(!tower) continue;
-
-        // cluster and tower position - from vertex and ID: shouldn't need additional eta correction
-        int towerID = tower->id();
-        StThreeVectorF towerPosition = mPosition->getPosFromVertex(mVertex, towerID);
-        double towerPhi = towerPosition.phi();
-        double towerEta = towerPosition.pseudoRapidity();
-        double towEuncorr = tower->energy();
-        double towE = tower->energy();
-
-        // shift tower phi (0, 2*pi)
-        if(towerPhi < 0)    towerPhi += 2*pi;
-        if(towerPhi > 2*pi) towerPhi -= 2*pi;
-
-        // April9, need to perform hadronic correction again since StBTowHit object is not updated
-        // if tower was not matched to an accepted track, use it for jet by itself if > 0.2 GeV
-        if(mTowerStatusArr[towerID]) {
-          //if(mTowerMatchTrkIndex[towerID] > 0) 
-          StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track( mTowerMatchTrkIndex[towerID] ));
-          if(!trk) { cout<<"No trk pointer...."<<endl; continue; }
-
-          // TODO - want to check if pass cuts, but if not then don't correct tower, but use it
-          //if(!AcceptJetTrack(trk, Bfield, mVertex)) { continue; }  // comment in April10
-          if(AcceptJetTrack(trk, Bfield, mVertex)) {
-
-            // get track variables to matched tower
-            StThreeVectorF mTrkMom;
-            if(doUsePrimTracks) {
-              // get primary track vector
-              mTrkMom = trk->pMom();
-            } else {
-              // get global track vector
-              mTrkMom = trk->gMom(mVertex, Bfield);
-            }
-
-            // track variables
-            double p = mTrkMom.mag();
-            double E = 1.0*TMath::Sqrt(p*p + pi0mass*pi0mass);
-
-            // apply hadronic correction to tower
-            towE = towEuncorr - (mHadronicCorrFrac * E);
-          }
-
-        }
-        // else - no match so treat towers on their own
 
-        // cut on tower transverse energy - should of already been done before adding them to fastjet
-        double towEt = towE / (1.0*TMath::CosH(towerEta)); // - FIXME should we cut on tower Et or E?
-        if(towEt < 0) towEt = 0.0; 
-        if(towEt < mTowerEnergyMin) continue;  // should make this Et TODO
+        // corrected tower: position from vertex and ID and hadronic correction done in PrepareTowers()
+        Int_t row = fTowerTable->GetRowOfHit(towIndex);
+        if(row < 0) continue;
+        int towerID = fTowerTable->GetTowerID(row);
+        double towerPhi = fTowerTable->GetPhi(row);     // (0, 2*pi)
+        double towerEta = fTowerTable->GetEta(row);
+        double towE = fTowerTable->GetE(row);
+        double towEt = fTowerTable->GetEt(row);
+
+        // tower cuts - should of already been done before adding them to fastjet
+        if(!fTowerTable->TestStatusBit(row, StCorrectedTowerTable::kAccepted)) continue;
         // =================================================================
 
         // find max tower E and neutral E total
         if(towE > maxTower) maxTower = towE;
         neutralE += towE;
 
-        //if(fTowerToTriggerTypeHT1[towerID]) cout<<"firedTrigger TowerId = "<<towerID<<endl;
+        //if(StPicoTriggerDecoder::Instance()->IsTowerHT1(towerID)) cout<<"firedTrigger TowerId = "<<towerID<<endl;
         //if(towerID == 796 || towerID == 1427 || towerID == 1984 || towerID == 2214 || toweirID == 3488 || towerID == 3692 || towerID == 1125 || towerID == 1221) cout<<"Adding to jet now.. towerID = "<<towerID<<"  E = "<<towE<<"  eta = "<<towerEta<<"  phi = "<<towerPhi<<"  zVtx = "<<zVtx<<endl;
 
         // fill QA histos for jet towers
-        fHistJetNTowervsID->Fill(towerID);
-        fHistJetNTowervsE->Fill(towE);
-        fHistJetNTowervsEt->Fill(towEt);
-        fHistJetNTowervsPhi->Fill(towerPhi);
-        fHistJetNTowervsEta->Fill(towerEta);
-        fHistJetNTowervsPhivsEta->Fill(towerPhi, towerEta);
-        fHistQATowIDvsEta->Fill(towerID, towerEta);
-        fHistQATowIDvsPhi->Fill(towerID, towerPhi);
-
-        // increase tower counter
+        if(fFillJetQAHistos) {
+          fHistJetNTowervsID->Fill(towerID);
+          fHistJetNTowervsE->Fill(towE);
+          fHistJetNTowervsEt->Fill(towEt);
+          fHistJetNTowervsPhi->Fill(towerPhi);
+          fHistJetNTowervsEta->Fill(towerEta);
+          fHistJetNTowervsPhivsEta->Fill(towerPhi, towerEta);
+          fHistQATowIDvsEta->Fill(towerID, towerEta);
+          fHistQATowIDvsPhi->Fill(towerID, towerPhi);
+        }
+
+        // add tower index and increase tower counter
+        fJetTowerIndices.push_back(towIndex);
+        fEventConstituents.push_back(constituents[ic]);
         nc++;
       } // towers
 
@@ -1033,13 +1009,17 @@ void StJetMakerTask::FillJetConstituents(StJet *jet, std::vector<fastjet::Pseudo
   // set some jet properties
   jet->SetNumberOfTracks(nt);
   jet->SetNumberOfClusters(nc);
+  for(Int_t it = 0; it < nt; it++) jet->AddTrackAt(fJetTrackIndices[it], it);
+  for(Int_t ic = 0; ic < nc; ic++) jet->AddClusterAt(fJetTowerIndices[ic], ic);
   jet->SetMaxTrackPt(maxTrack);
   jet->SetMaxClusterPt(maxTower);
   jet->SetMaxTowerE(maxTower);     // should this be Et? FIXME
   jet->SetNEF(neutralE/jet->E());  // should this be Et? FIXME
-  //jet->SortConstituents(); // TODO see how this works - sorts ClusterIds() and TrackIds() by index (increasing)
+  jet->SortConstituents();         // sorts TrackIDs and ClusterIDs by index (increasing): binary search in Contains*()
+  jet->SetJetConstituents(&fEventConstituents, firstConstit, fEventConstituents.size() - firstConstit);
 
-  // fill jets histograms
+  // fill jets histograms (main jet definition only)
+  if(!fFillJetQAHistos) return;
   fHistNJetsvsPt->Fill(jet->Pt()); 
   fHistNJetsvsPhi->Fill(jet->Phi());
   fHistNJetsvsEta->Fill(jet->Eta());
@@ -1088,6 +1068,101 @@ Bool_t StJetMakerTask::IsLocked() const
   }
 }
 
+/**
+ * Adds a jet definition which is clustered from the same input vectors (tracks + corrected towers)
+ * as the main jet definition of this task, so event selection, track/tower loops and hadronic
+ * correction are done once for all of them. The jets are published in their own collection.
+ * @param jetsName Name of the jet collection, see GetJets(const char*)
+ * @param algo Jet algorithm flag, as SetJetAlgo()
+ * @param radius Jet resolution parameter R
+ * @param recombScheme Recombination scheme flag, as SetRecombScheme()
+ * @param areaType fastjet::AreaType (default: active_area_explicit_ghosts)
+ * @param minJetPt Min jet pt to keep jet in output, < 0: same as main jet definition
+ * @return Index of jet definition, -1 if it could not be added
+ */
+Int_t StJetMakerTask::AddJetDefinition(const char *jetsName, Int_t algo, Double_t radius, Int_t recombScheme,
+    Int_t areaType, Double_t minJetPt)
+{
+  if(fJets) {
+    LOG_WARN << Form(" %s: jet definitions must be added before Init()! ", GetName()) << endm;
+    return -1;
+  }
+
+  // names must be unique
+  TString name(jetsName);
+  if(name.IsNull() || (name == fJetsName)) {
+    LOG_WARN << Form(" %s: invalid jet collection name %s! ", GetName(), jetsName) << endm;
+    return -1;
+  }
+  for(UInt_t idef = 0; idef < fJetDefs.size(); idef++) {
+    if(fJetDefs[idef].fJetsName == name) {
+      LOG_WARN << Form(" %s: jet collection %s already exists! ", GetName(), jetsName) << endm;
+      return -1;
+    }
+  }
+
+  StJetDefinition def;
+  def.fJetsName = name;
+  def.fJetAlgo = algo;
+  def.fRadius = radius;
+  def.fRecombScheme = recombScheme;
+  def.fAreaType = areaType;
+  def.fMinJetPt = minJetPt;
+  def.fFJWrapper = 0x0;
+  def.fJets = 0x0;
+  fJetDefs.push_back(def);
+
+  return (Int_t)fJetDefs.size() - 1;
+}
+
+//________________________________________________________________________
+TClonesArray* StJetMakerTask::GetJets(const char *jetsName)
+{
+  // main or additional jet collection by name
+  if(fJetsName == jetsName) return fJets;
+  for(UInt_t idef = 0; idef < fJetDefs.size(); idef++) {
+    if(fJetDefs[idef].fJetsName == jetsName) return fJetDefs[idef].fJets;
+  }
+
+  return 0x0;
+}
+
+//________________________________________________________________________
+fastjet::JetAlgorithm StJetMakerTask::GetFJJetAlgorithm(Int_t algo)
+{
+  // jet algorithm flag (see SetJetAlgo()) to fastjet
+  switch(algo) {
+    case 0  : return fastjet::kt_algorithm;
+    case 1  : return fastjet::antikt_algorithm;
+    // extra algorithms
+    case 2  : return fastjet::cambridge_algorithm;
+    case 3  : return fastjet::genkt_algorithm;
+    case 11 : return fastjet::cambridge_for_passive_algorithm;
+    case 13 : return fastjet::genkt_for_passive_algorithm;
+    case 99 : return fastjet::plugin_algorithm;
+    default : return fastjet::undefined_jet_algorithm;
+  }
+}
+
+//________________________________________________________________________
+fastjet::RecombinationScheme StJetMakerTask::GetFJRecombScheme(Int_t scheme)
+{
+  // recombination scheme flag (see SetRecombScheme()) to fastjet
+  // E_scheme, pt_scheme, pt2_scheme, Et_scheme, Et2_scheme, BIpt_scheme, BIpt2_scheme, WTA_pt_scheme, WTA_modp_scheme
+  switch(scheme) {
+    case 0  : return fastjet::E_scheme;
+    case 1  : return fastjet::pt_scheme;
+    case 2  : return fastjet::pt2_scheme;
+    case 3  : return fastjet::Et_scheme;
+    case 4  : return fastjet::Et2_scheme;
+    case 5  : return fastjet::BIpt_scheme;
+    case 6  : return fastjet::BIpt2_scheme;
+    case 7  : return fastjet::WTA_pt_scheme;
+    case 8  : return fastjet::WTA_modp_scheme;
+    default : return fastjet::external_scheme;
+  }
+}
+
 /**
  * Converts the internal enum values representing jet algorithms in
  * the corresponding values accepted by the FastJet wrapper.
@@ -1208,27 +1283,111 @@ Bool_t StJetMakerTask::AcceptJetTrack(StPicoTrack *trk, Float_t B, StThreeVector
 }
 
 //
-// Tower Quality Cuts
+// jet track cuts and momentum vector (global or primary) for PicoDst track index iTrk
+// taken from the shared track table when available, computed here otherwise
 //________________________________________________________________________
-Bool_t StJetMakerTask::AcceptJetTower(StPicoBTowHit *tower) {
-  // get EMCal position
-  StEmcPosition *mPosition = new StEmcPosition();
+Bool_t StJetMakerTask::GetAcceptedJetTrack(Int_t iTrk, StThreeVectorF &mom) {
+  // track table: cuts and helix momentum were done once for the event
+  if(fTrackTable) {
+    if((iTrk < 0) || (iTrk >= fTrackTable->GetNumberOfTracks())) return kFALSE;
+    if(!fTrackTable->PassCuts(iTrk, fTrackTableProfile)) return kFALSE;
+    mom = StThreeVectorF(fTrackTable->GetPx(iTrk), fTrackTable->GetPy(iTrk), fTrackTable->GetPz(iTrk));
+    return kTRUE;
+  }
 
-  // constants:
-  double pi = 1.0*TMath::Pi();
+  StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(iTrk));
+  if(!trk) return kFALSE;
+
+  // acceptance and kinematic quality cuts
+  if(!AcceptJetTrack(trk, Bfield, mVertex)) return kFALSE;
+
+  // get momentum vector of track - global or primary track
+  if(doUsePrimTracks) {
+    // get primary track vector
+    mom = trk->pMom();
+  } else {
+    // get global track vector
+    mom = trk->gMom(mVertex, Bfield);
+  }
+
+  return kTRUE;
+}
+
+//
+// get shared track table (if requested) and register jet track cuts with it
+//________________________________________________________________________
+Bool_t StJetMakerTask::InitTrackTable() {
+  // not used
+  if(fTrackTableMakerName.IsNull()) return kTRUE;
+  if(fTrackTable) return kTRUE;
+
+  fTrackTable = static_cast<StPicoTrackTableMaker*>(GetMaker(fTrackTableMakerName));
+  const char *fTrackTableMakerNameCh = fTrackTableMakerName;
+  if(!fTrackTable) {
+    LOG_WARN << Form(" No %s! Skip! ", fTrackTableMakerNameCh) << endm;
+    return kFALSE;
+  }
+
+  // the table must be filled with the same type of tracks
+  if(fTrackTable->GetUsePrimaryTracks() != doUsePrimTracks) {
+    LOG_WARN << Form(" %s primary track setting differs from %s, not using track table! ", fTrackTableMakerNameCh, GetName()) << endm;
+    fTrackTable = 0x0;
+    fTrackTableMakerName = "";
+    return kTRUE;
+  }
+
+  // register jet track cuts
+  fTrackTableProfile = fTrackTable->AddCutProfile(GetName(), fMinJetTrackPt, fMaxJetTrackPt,
+      fJetTrackEtaMin, fJetTrackEtaMax, fJetTrackPhiMin, fJetTrackPhiMax,
+      fJetTrackDCAcut, fJetTracknHitsFit, fJetTracknHitsRatio);
+  if(fTrackTableProfile < 0) {
+    fTrackTable = 0x0;
+    fTrackTableMakerName = "";
+  }
+
+  return kTRUE;
+}
+
+//
+// get shared event header (if requested)
+//________________________________________________________________________
+Bool_t StJetMakerTask::InitEventHeader() {
+  // not used
+  if(fEventHeaderMakerName.IsNull()) return kTRUE;
+  if(fEventHeader) return kTRUE;
+
+  fEventHeader = static_cast<StPicoEventHeaderMaker*>(GetMaker(fEventHeaderMakerName));
+  const char *fEventHeaderMakerNameCh = fEventHeaderMakerName;
+  if(!fEventHeader) {
+    LOG_WARN << Form(" No %s! Skip! ", fEventHeaderMakerNameCh) << endm;
+    return kFALSE;
+  }
+
+  // centrality and event selection must be the same: the header rejects events for the whole chain
+  const char *diff = fEventHeader->CompareSettings(fRunFlag, fCentralityDef, doUseBBCCoincidenceRate,
+      fEventZVtxMinCut, fEventZVtxMaxCut, fTriggerToUse, fMBEventType, fEmcTriggerEventType);
+  if(diff) {
+    LOG_WARN << Form(" %s %s setting differs from %s, not using event header! ", fEventHeaderMakerNameCh, diff, GetName()) << endm;
+    fEventHeader = 0x0;
+    fEventHeaderMakerName = "";
+  }
+
+  return kTRUE;
+}
 
+//
+// Tower Quality Cuts
+//________________________________________________________________________
+Bool_t StJetMakerTask::AcceptJetTower(StPicoBTowHit *tower) {
   // tower ID
   int towerID = tower->id();
 
   // make sure some of these aren't still in event array
   if(towerID < 0) return kFALSE; 
 
-  // cluster and tower position - from vertex and ID: shouldn't need additional eta correction
-  StThreeVectorF towerPosition = mPosition->getPosFromVertex(mVertex, towerID);
-  double phi = towerPosition.phi();
-  if(phi < 0)    phi += 2.0*pi;
-  if(phi > 2*pi) phi -= 2.0*pi;
-  double eta = towerPosition.pseudoRapidity();
+  // cluster and tower position - from vertex and ID: shouldn't need additional eta correction, phi in (0, 2pi)
+  double eta, phi, coshEta;
+  mPosition->GetEtaPhiFromVertex(mVertex, towerID, eta, phi, coshEta);
 
   // check for bad (and dead) towers
   bool TowerOK = IsTowerOK(towerID);      // kTRUE means GOOD
@@ -1238,8 +1397,6 @@ Bool_t StJetMakerTask::AcceptJetTower(StPicoBTowHit *tower) {
 
   // jet track acceptance cuts now - after getting 3vector - hardcoded
   if((eta < fJetTowerEtaMin) || (eta > fJetTowerEtaMax)) return kFALSE;
-  if(phi < 0)    phi+= 2*pi;
-  if(phi > 2*pi) phi-= 2*pi;
   if((phi < fJetTowerPhiMin) || (phi > fJetTowerPhiMax)) return kFALSE;
 
   // passed all above cuts - keep tower and fill input vector to fastjet
@@ -1367,9 +1524,6 @@ Bool_t StJetMakerTask::SelectAnalysisCentralityBin(Int_t centbin, Int_t fCentral
 
 //________________________________________________________________________________________________________
 Bool_t StJetMakerTask::GetMomentum(StThreeVectorF &mom, const StPicoBTowHit* tower, Double_t mass) const {
-  // initialize Emc position objects
-  StEmcPosition *Position = new StEmcPosition();
-
   // vertex components - only need if below method is used
   // mGeom3->getEtaPhi(towerID,tEta,tPhi);
   //double xVtx = mVertex.x();
@@ -1383,7 +1537,7 @@ Bool_t StJetMakerTask::GetMomentum(StThreeVectorF &mom, const StPicoBTowHit* tow
   int towerID = tower->id();
 
   // get tower position
-  StThreeVectorF towerPosition = Position->getPosFromVertex(mVertex, towerID);
+  StThreeVectorF towerPosition = mPosition->GetPosFromVertex(mVertex, towerID);
   double posX = towerPosition.x();
   double posY = towerPosition.y();
   double posZ = towerPosition.z();
@@ -1403,6 +1557,92 @@ Bool_t StJetMakerTask::GetMomentum(StThreeVectorF &mom, const StPicoBTowHit* tow
   return kTRUE;
 }
 
+//
+// fill vertex corrected eta, phi and cosh(eta) for all tower hits of the event (index = tower hit index)
+//________________________________________________________________________________________________________
+void StJetMakerTask::FillTowerPositions(Int_t nTowers) {
+  // re-use storage from previous events
+  fTowerHitID.resize(nTowers);
+  fTowerHitEta.resize(nTowers);
+  fTowerHitPhi.resize(nTowers);
+  fTowerHitCoshEta.resize(nTowers);
+  if(nTowers < 1) return;
+
+  // get tower ID's
+  for(int itow = 0; itow < nTowers; itow++) {
+    StPicoBTowHit *tower = static_cast<StPicoBTowHit*>(mPicoDst->btowHit(itow));
+    fTowerHitID[itow] = (tower) ? tower->id() : -1;
+  }
+
+  // single batch call to geometry cache
+  mPosition->GetEtaPhiFromVertex(mVertex, nTowers, &fTowerHitID[0], &fTowerHitEta[0], &fTowerHitPhi[0], &fTowerHitCoshEta[0]);
+}
+
+//
+// tower pre-processing: table of fired towers with vertex corrected position,
+// hadronic correction (matched tracks passing jet track cuts) and tower cuts
+//____________________________________________________________________________________________
+void StJetMakerTask::PrepareTowers() {
+  // assume neutral pion mass
+  double pi0mass = Pico::mMass[0]; // GeV
+
+  // start new event
+  fTowerTable->Reset();
+
+  // get vertex corrected position of all towers in one go
+  int nTowers = mPicoDst->numberOfBTOWHits();
+  FillTowerPositions(nTowers);
+
+  // fired towers
+  for(int itow = 0; itow < nTowers; itow++) {
+    StPicoBTowHit *tower = static_cast<StPicoBTowHit*>(mPicoDst->btowHit(itow));
+    if(!tower) { cout<<"No tower pointer... iTow = "<<itow<<endl; continue; }
+
+    // tower ID
+    int towerID = tower->id();
+    if(towerID < 0) continue; // double check these aren't still in the event list
+
+    // tower was not fired
+    double towerE = tower->energy();
+    if(towerE <= 0) continue;
+
+    fTowerTable->AddTower(itow, towerID, towerE, fTowerHitEta[itow], fTowerHitPhi[itow], fTowerHitCoshEta[itow]);
+  }
+
+  // loop over ALL clusters in PicoDst to get track<->tower matches for hadronic correction
+  int nBEmcPidTraits = mPicoDst->numberOfBEmcPidTraits();
+  for(int iClus = 0; iClus < nBEmcPidTraits; iClus++) {
+    StPicoBEmcPidTraits* cluster = static_cast<StPicoBEmcPidTraits*>(mPicoDst->bemcPidTraits(iClus));
+    if(!cluster){ cout<<"Cluster pointer does not exist.. iClus = "<<iClus<<endl; continue; }
+
+    // projected tower Id: 1 - 4800
+    int towID = cluster->btowId();
+    if(towID < 0) continue;
+
+    // matched track index - only tracks passing jet track quality cuts are used
+    int trackIndex = cluster->trackIndex();
+    StThreeVectorF mTrkMom;
+    if(!GetAcceptedJetTrack(trackIndex, mTrkMom)) continue;
+
+    // track energy
+    double p = mTrkMom.mag();
+    double E = 1.0*TMath::Sqrt(p*p + pi0mass*pi0mass);
+    fTowerTable->AddMatchedTrack(towID, trackIndex, E);
+  } // PIDTraits loop
+
+  // apply hadronic correction to towers
+  fTowerTable->ApplyHadronicCorrection(mHadronicCorrFrac, fHadronicCorrSumTracks);
+
+  // tower cuts: bad and dead towers, min transverse energy
+  for(int row = 0; row < fTowerTable->GetNumberOfTowers(); row++) {
+    int towerID = fTowerTable->GetTowerID(row);
+    bool TowerOK = IsTowerOK(towerID);
+    if(!TowerOK)            fTowerTable->SetStatusBit(row, StCorrectedTowerTable::kBad);
+    if(IsTowerDead(towerID)) fTowerTable->SetStatusBit(row, StCorrectedTowerTable::kDead);
+    if(TowerOK && (fTowerTable->GetEt(row) >= mTowerEnergyMin)) fTowerTable->SetStatusBit(row, StCorrectedTowerTable::kAccepted);
+  }
+}
+
 //____________________________________________________________________________________________
 Bool_t StJetMakerTask::IsTowerOK( Int_t mTowId ){
   //if( badTowers.size()==0 ){
@@ -1515,165 +1755,31 @@ void StJetMakerTask::ResetDeadTowerList( ){
 
 //_________________________________________________________________________
 Bool_t StJetMakerTask::CheckForMB(int RunFlag, int type) {
-  // Run14 triggers:
-  int arrMB_Run14[] = {450014};
-  int arrMB30_Run14[] = {450010, 450020};
-  int arrMB5_Run14[] = {450005, 450008, 450009, 450014, 450015, 450018, 450024, 450025, 450050, 450060};
-  // additional 30: 4, 5, 450201, 450202, 450211, 450212
-  // 1: VPDMB-5   Run:            15075055 - 15076099
-  // 1: VPDMB-5-p-nobsmd-hlt Run: 15081020 - 15090048
-  // 4: VPDMB-5-p-nobsmd-hlt Run: 15090049 - 15167007
-
-  // Run16 triggers:
-  int arrMB_Run16[] = {520021};
-  int arrMB5_Run16[] = {520001, 520002, 520003, 520011, 520012, 520013, 520021, 520022, 520023, 520031, 520033, 520041, 520042, 520043, 520051, 520822, 520832, 520842, 570702};
-  int arrMB10_Run16[] = {520007, 520017, 520027, 520037, 520201, 520211, 520221, 520231, 520241, 520251, 520261, 520601, 520611, 520621, 520631, 520641};
-
-  // run flag selection to check for MB firing
-  switch(RunFlag) {
-    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
-        switch(type) { 
-          case StJetFrameworkPicoBase::kRun14main :
-              if((DoComparison(arrMB_Run14, sizeof(arrMB_Run14)/sizeof(*arrMB_Run14)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kVPDMB5 :
-              if((DoComparison(arrMB5_Run14, sizeof(arrMB5_Run14)/sizeof(*arrMB5_Run14)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kVPDMB30 :
-              if((DoComparison(arrMB30_Run14, sizeof(arrMB30_Run14)/sizeof(*arrMB30_Run14)))) { return kTRUE; }
-              break;
-          default :
-              if((DoComparison(arrMB_Run14, sizeof(arrMB_Run14)/sizeof(*arrMB_Run14)))) { return kTRUE; }
-        }
-        break; // added May20
-
-    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
-        switch(type) {
-          case StJetFrameworkPicoBase::kRun16main :
-              if((DoComparison(arrMB_Run16, sizeof(arrMB_Run16)/sizeof(*arrMB_Run16)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kVPDMB5 :
-              if((DoComparison(arrMB5_Run16, sizeof(arrMB5_Run16)/sizeof(*arrMB5_Run16)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kVPDMB10 :
-              if((DoComparison(arrMB10_Run16, sizeof(arrMB10_Run16)/sizeof(*arrMB10_Run16)))) { return kTRUE; }
-              break;
-          default :
-              if((DoComparison(arrMB_Run16, sizeof(arrMB_Run16)/sizeof(*arrMB_Run16)))) { return kTRUE; }
-        }
-        break; // added May20
-
-  } // RunFlag switch
+  // trigger bits are decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, RunFlag);
 
-  // return status
-  return kFALSE;
+  // MB selection of run flag
+  return ((mask & StPicoTriggerDecoder::GetMBBit(RunFlag, type)) != 0);
 } // MB function
 
 //
 // check to see if the event was EMC triggered for High Towers
 //____________________________________________________________________________
 Bool_t StJetMakerTask::CheckForHT(int RunFlag, int type) {
+  // trigger bits are decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, RunFlag);
 
-  // Run14 triggers:
-  int arrHT1_Run14[] = {450201, 450211, 460201};
-  int arrHT2_Run14[] = {450202, 450212, 460202, 460212};
-  int arrHT3_Run14[] = {450203, 450213, 460203};
-
-  // Run16 triggers:
-  int arrHT1_Run16[] = {520201, 520211, 520221, 520231, 520241, 520251, 520261, 520605, 520615, 520625, 520635, 520645, 520655, 550201, 560201, 560202, 530201, 540201};
-  int arrHT2_Run16[] = {530202, 540203};
-  int arrHT3_Run16[] = {520203, 530213};
-
-  // run flag selection to check for MB firing
-  switch(RunFlag) {
-    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
-        switch(type) {
-          case StJetFrameworkPicoBase::kIsHT1 :
-              if((DoComparison(arrHT1_Run14, sizeof(arrHT1_Run14)/sizeof(*arrHT1_Run14)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kIsHT2 :
-              if((DoComparison(arrHT2_Run14, sizeof(arrHT2_Run14)/sizeof(*arrHT2_Run14)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kIsHT3 :
-              if((DoComparison(arrHT3_Run14, sizeof(arrHT3_Run14)/sizeof(*arrHT3_Run14)))) { return kTRUE; }
-              break;
-          default :  // default to HT2
-              if((DoComparison(arrHT2_Run14, sizeof(arrHT2_Run14)/sizeof(*arrHT2_Run14)))) { return kTRUE; }
-        }
-        break; // added May20
-
-    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
-        switch(type) {
-          case StJetFrameworkPicoBase::kIsHT1 :
-              if((DoComparison(arrHT1_Run16, sizeof(arrHT1_Run16)/sizeof(*arrHT1_Run16)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kIsHT2 :
-              if((DoComparison(arrHT2_Run16, sizeof(arrHT2_Run16)/sizeof(*arrHT2_Run16)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kIsHT3 :
-              if((DoComparison(arrHT3_Run16, sizeof(arrHT3_Run16)/sizeof(*arrHT3_Run16)))) { return kTRUE; }
-              break;
-          default :  // Run16 only has HT1's
-              if((DoComparison(arrHT1_Run16, sizeof(arrHT1_Run16)/sizeof(*arrHT1_Run16)))) { return kTRUE; }
-        }
-        break; // added May20
-
-  } // RunFlag switch
-
-  return kFALSE;
-}
-
-//________________________________________________________________________
-Bool_t StJetMakerTask::DoComparison(int myarr[], int elems) {
-  //std::cout << "Length of array = " << (sizeof(myarr)/sizeof(*myarr)) << std::endl;
-  bool match = kFALSE;
-
-  // loop over specific physics selection array and compare to specific event trigger
-  for(int i = 0; i < elems; i++) {
-    if(mPicoEvent->isTrigger(myarr[i])) match = kTRUE;
-    if(match) break;
-  }
-  //cout<<"elems: "<<elems<<"  match: "<<match<<endl;
-
-  return match;
+  // HT selection of run flag
+  return ((mask & StPicoTriggerDecoder::GetHTBit(RunFlag, type)) != 0);
 }
 
 //_________________________________________________________________________
 void StJetMakerTask::FillEmcTriggersArr() {
-  // zero out trigger array and get number of Emcal Triggers
-  for(int i = 0; i < 8; i++) { fEmcTriggerArr[i] = kFALSE; }
-  int nEmcTrigger = mPicoDst->numberOfEmcTriggers();
-
-  // tower - HT trigger types array
-  // zero these out - so they are refreshed for each event
-  for(int i = 0; i < 4801; i++) {
-    fTowerToTriggerTypeHT1[i] = kFALSE;
-    fTowerToTriggerTypeHT2[i] = kFALSE;
-    fTowerToTriggerTypeHT3[i] = kFALSE;
-  }
-
-  // loop over valid EmcalTriggers
-  for(int i = 0; i < nEmcTrigger; i++) {
-    StPicoEmcTrigger *emcTrig = static_cast<StPicoEmcTrigger*>(mPicoDst->emcTrigger(i));
-    if(!emcTrig) continue;
-
-    // emc trigger parameters
-    int emcTrigID = emcTrig->id();
-
-    // check if i'th trigger fired HT triggers by meeting threshold
-    bool isHT1 = emcTrig->isHT1();
-    bool isHT2 = emcTrig->isHT2();
-    bool isHT3 = emcTrig->isHT3();
-    if(isHT1) fTowerToTriggerTypeHT1[emcTrigID] = kTRUE;
-    if(isHT2) fTowerToTriggerTypeHT2[emcTrigID] = kTRUE;
-    if(isHT3) fTowerToTriggerTypeHT3[emcTrigID] = kTRUE;
-
-    // fill for valid triggers
-    if(isHT1) fEmcTriggerArr[StJetFrameworkPicoBase::kIsHT1] = kTRUE;
-    if(isHT2) fEmcTriggerArr[StJetFrameworkPicoBase::kIsHT2] = kTRUE;
-    if(isHT3) fEmcTriggerArr[StJetFrameworkPicoBase::kIsHT3] = kTRUE;
-  }
-
+  // fired EMC triggers of event: decoded once per event by the shared trigger decoder
+  // per-tower HT trigger bits: StPicoTriggerDecoder::Instance()->IsTowerHT1(towerID), etc
+  StPicoTriggerDecoder *mTrigger = StPicoTriggerDecoder::Instance();
+  mTrigger->Decode(mPicoDst, fRunFlag);
+  for(int i = 0; i < 8; i++) { fEmcTriggerArr[i] = mTrigger->HasEmcTrigger(i); }
 }
 //========
 /*
@@ -13,6 +13,8 @@
 #include "StEmcUtil/projection/StEmcPosition.h"
 #include "StMuDSTMaker/COMMON/StMuDst.h"
 class StEmcGeom;
+class StEmcPositionCache;
+class StCorrectedTowerTable;
 class StEmcCluster;
 class StEmcCollection;
 class StBemcTables; //v3.14
@@ -31,6 +33,10 @@ class StPicoDstMaker;
 // Jet classes
 class StFJWrapper;
 class StJetUtility;
+class StPicoTrackTableMaker;
+class StPicoEventHeaderMaker;
+class StRhoBase;
+class StJetCacheMaker;
 
 // Centrality class
 class StRefMultCorr;
@@ -137,6 +143,8 @@ class StJetMakerTask : public StMaker {
   void         SetMinJetPt(Double_t j)                    { fMinJetPt         = j     ; }
   void         SetRadius(Double_t r)                      { fRadius        = r;  }
   void         SetGhostArea(Double_t gharea)              { fGhostArea        = gharea; }
+  void         SetJetAreaType(Int_t a)                    { fJetAreaType      = a     ; } // fastjet::AreaType, voronoi_area: cheapest for kt
+  void         SetFixedGhostSeed(Int_t seed)              { fGhostSeed        = seed  ; } // > 0: same seeded ghosts every event
   void         SetJetEtaRange(Double_t emi, Double_t ema) { fJetEtaMin        = emi   ; fJetEtaMax = ema; }
   void         SetJetPhiRange(Double_t pmi, Double_t pma) { fJetPhiMin        = pmi   ; fJetPhiMax = pma; }
 
@@ -154,6 +162,25 @@ class StJetMakerTask : public StMaker {
   void         SetMinJetClusPt(Double_t min)              { fMinJetClusPt  = min;}
   void         SetMinJetClusE(Double_t min)               { fMinJetClusE   = min;}
 
+  // additional jet definitions: clustered from the same input vectors as the main definition,
+  // each published in its own jet collection (area type: fastjet::AreaType, min jet pt < 0: use SetMinJetPt())
+  Int_t        AddJetDefinition(const char *jetsName, Int_t algo, Double_t radius, Int_t recombScheme = 6,
+                 Int_t areaType = 1, Double_t minJetPt = -1.0);
+  Int_t        GetNumberOfJetDefinitions() const          { return (Int_t)fJetDefs.size(); }
+
+  // shared track table: when set, jet track kinematics and cuts are taken from it
+  void         SetTrackTableMakerName(const char *n)      { fTrackTableMakerName = n; }
+  void         SetEventHeaderMakerName(const char *n)     { fEventHeaderMakerName = n; }
+
+  // event-wide constituent subtraction before clustering, with rho and rho_m of the rho maker
+  // (the rho maker has to run before this jet maker)
+  void         SetEventConstituentSubtraction(Bool_t b, const char *rhoMakerName = "") { doEventConstSub = b; fRhoMakerName = rhoMakerName; }
+  void         SetEventSubtractionParameters(Double_t maxDeltaR, Double_t alpha = 0., Double_t ghostArea = 0.01)
+                 { fCSMaxDeltaR = maxDeltaR; fCSAlpha = alpha; fCSGhostArea = ghostArea; }
+
+  // jets (all definitions) served from the jet DST cache maker in kRead mode instead of clustering
+  void         SetJetCacheMakerName(const char *n)        { fJetCacheMakerName = n; }
+
   void         SetLocked()                                { fLocked = kTRUE;}
   void         SetTrackEfficiency(Double_t t)             { fTrackEfficiency  = t     ; }
   void         SetLegacyMode(Bool_t mode)                 { fLegacyMode       = mode  ; }
@@ -165,10 +192,19 @@ class StJetMakerTask : public StMaker {
 
   // jets
   TClonesArray*          GetJets()                        { return fJets; }
+  TClonesArray*          GetJets(const char *jetsName);     // main or additional jet collection by name
+  TClonesArray*          GetJets(Int_t idef)              { return ((idef < 0) || (idef >= (Int_t)fJetDefs.size())) ? 0x0 : fJetDefs[idef].fJets; }
+  const char*            GetJetsName(Int_t idef)          { return ((idef < 0) || (idef >= (Int_t)fJetDefs.size())) ? "" : fJetDefs[idef].fJetsName.Data(); }
   TClonesArray*          GetJetConstit()                  { return fJetsConstit; }
+
+  // fastjet wrapper of main (or additional) jet definition: StJet::GetLabel() is the inclusive jet index,
+  // e.g. GetFJWrapper()->GetSoftDrop(jet->GetLabel(), zcut, beta, result) - valid until the next event
+  StFJWrapper*           GetFJWrapper()                   { return &fjw; }
+  StFJWrapper*           GetFJWrapper(Int_t idef)         { return ((idef < 0) || (idef >= (Int_t)fJetDefs.size())) ? 0x0 : fJetDefs[idef].fFJWrapper; }
  
   // getters
   Double_t               GetGhostArea()                   { return fGhostArea         ; }
+  Int_t                  GetJetAreaType()                 { return fJetAreaType       ; }
   const char*            GetJetsName()                    { return fJetsName.Data()   ; }
   const char*            GetJetsTag()                     { return fJetsTag.Data()    ; }
   Double_t               GetJetEtaMin()                   { return fJetEtaMin         ; }
@@ -203,26 +239,39 @@ class StJetMakerTask : public StMaker {
 
   // set hadronic correction fraction for matched tracks to towers
   void                   SetHadronicCorrFrac(float frac)    { mHadronicCorrFrac = frac; }
+  // subtract sum of all matched tracks (kTRUE) or only the last matched track (kFALSE, default)
+  void                   SetHadronicCorrSumTracks(Bool_t s) { fHadronicCorrSumTracks = s; }
+
+  // per-event corrected tower table (hadronic correction, tower cuts): filled for full and neutral jets, 0 for charged jets
+  const StCorrectedTowerTable* GetTowerTable() const        { return (fJetType == kChargedJet) ? 0x0 : fTowerTable; }
+  // per-event constituent table of all jet definitions: StJet::JetConstituentAt() points into it
+  const std::vector<fastjet::PseudoJet>& GetEventConstituents() const { return fEventConstituents; }
 
  protected:
   // this 1st version is deprecated as the parameters are global for the class and already set
   void                   FindJets(TObjArray *tracks, TObjArray *clus, Int_t algo, Double_t radius);
   void                   FindJets();
   //Int_t FindJets(); // use this if want to return NJets found
+  Int_t                  FillJetsFromCache();
   void                   FillJetConstituents(StJet *jet, std::vector<fastjet::PseudoJet>& constituents,
                             std::vector<fastjet::PseudoJet>& constituents_sub, Int_t flag = 0, TString particlesSubName = "");
   Bool_t                 AcceptJetTrack(StPicoTrack *trk, Float_t B, StThreeVectorF Vert);// track accept cuts function
   Bool_t                 AcceptJetTower(StPicoBTowHit *tower);                            // tower accept cuts function
+  Bool_t                 GetAcceptedJetTrack(Int_t iTrk, StThreeVectorF &mom);            // jet track cuts + momentum, from track table when available
+  Bool_t                 InitTrackTable();                                                // find track table and register jet track cuts
+  Bool_t                 InitEventHeader();                                               // find shared event header
   Int_t                  GetCentBin(Int_t cent, Int_t nBin) const;                        // centrality bin
   Bool_t                 SelectAnalysisCentralityBin(Int_t centbin, Int_t fCentralitySelectionCut); // centrality bin to cut on for analysis
   Bool_t                 GetMomentum(StThreeVectorF &mom, const StPicoBTowHit* tower, Double_t mass) const;
+  void                   FillTowerPositions(Int_t nTowers);                               // vertex corrected tower eta/phi for event
+  void                   PrepareTowers();                                                 // fill corrected tower table for event
   Bool_t                 CheckForMB(int RunFlag, int type);
   Bool_t                 CheckForHT(int RunFlag, int type);
-  Bool_t                 DoComparison(int myarr[], int elems);
   void                   FillEmcTriggersArr();
 
   // may not need any of these except fill jet branch if I want 2 different functions
   void                   FillJetBranch();
+  void                   FillJetBranch(StFJWrapper &wrapper, TClonesArray *jets, Double_t radius, Double_t minJetPt);
   void                   InitUtilities();
   void                   PrepareUtilities();
   void                   ExecuteUtilities(StJet* jet, Int_t ij);
@@ -230,6 +279,23 @@ class StJetMakerTask : public StMaker {
 
   Bool_t                 GetSortedArray(Int_t indexes[], std::vector<fastjet::PseudoJet> array) const;
 
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+  static fastjet::JetAlgorithm        GetFJJetAlgorithm(Int_t algo);        // jet algorithm flag -> fastjet
+  static fastjet::RecombinationScheme GetFJRecombScheme(Int_t scheme);      // recombination scheme flag -> fastjet
+#endif
+
+  // additional jet definition sharing the input vectors of the main one
+  struct StJetDefinition {
+    TString              fJetsName;               // name of jet collection
+    Int_t                fJetAlgo;                // jet algorithm (kt, akt, etc)
+    Double_t             fRadius;                 // jet radius
+    Int_t                fRecombScheme;           // recombination scheme used by fastjet
+    Int_t                fAreaType;               // fastjet::AreaType
+    Double_t             fMinJetPt;               // min jet pt to keep jet in output
+    StFJWrapper         *fFJWrapper;              // fastjet wrapper
+    TClonesArray        *fJets;                   // jet collection
+  };
+
   // switches
   Bool_t                 doWriteHistos;           // write QA histos
   Bool_t                 doUsePrimTracks;         // primary track switch
@@ -256,11 +322,6 @@ class StJetMakerTask : public StMaker {
   UInt_t                 fBadTowerListVers;       // version of bad tower file list to use
   Int_t                  fEmcTriggerArr[8];       // EMCal triggers array: used to select signal and do QA
 
-  // tower to firing trigger type matched array
-  Bool_t                 fTowerToTriggerTypeHT1[4801];// Tower with corresponding HT1 trigger type array
-  Bool_t                 fTowerToTriggerTypeHT2[4801];// Tower with corresponding HT2 trigger type array
-  Bool_t                 fTowerToTriggerTypeHT3[4801];// Tower with corresponding HT3 trigger type array
-
   // output file name string
   TString                mOutName;
   TString                fTracksName;             // name of track collection
@@ -289,6 +350,8 @@ class StJetMakerTask : public StMaker {
   Double_t               fJetEtaMin;              // minimum eta to keep jet in output
   Double_t               fJetEtaMax;              // maximum eta to keep jet in output
   Double_t               fGhostArea;              // ghost area
+  Int_t                  fJetAreaType;            // fastjet::AreaType of main jet definition
+  Int_t                  fGhostSeed;              // seed of fixed ghosts, <= 0: new random ghosts every event
 
   // track attributes
   Double_t               fMinJetTrackPt;          // min jet track transverse momentum cut
@@ -324,12 +387,44 @@ class StJetMakerTask : public StMaker {
 
   // jet and jet constituent objects
   TClonesArray          *fJets;                   //!jet collection
-  vector<fastjet::PseudoJet> fConstituents;       //!jet constituents
+  vector<fastjet::PseudoJet> fConstituents;       //!jet constituents of current jet, reused buffer
+  vector<fastjet::PseudoJet> fEventConstituents;  //!accepted constituents of all jets of the event, StJet's keep an index span
   TClonesArray          *fJetsConstit;            //!jet constituents ClonesArray
+  std::vector<StJetDefinition> fJetDefs;          //!additional jet definitions
+  std::vector<std::pair<Double_t, Int_t> > fAcceptedJets; //!(pt, index) of jets passing cuts, reused buffer
+  std::vector<Int_t>     fJetTrackIndices;        //!accepted track indices of current jet, reused buffer
+  std::vector<Int_t>     fJetTowerIndices;        //!accepted tower indices of current jet, reused buffer
+  Bool_t                 fFillJetQAHistos;        //!fill jet constituent QA histograms (main definition only)
   
+  // shared track table
+  TString                fTrackTableMakerName;    // name of track table maker, "" = not used
+  StPicoTrackTableMaker *fTrackTable;             //!track table maker
+  Int_t                  fTrackTableProfile;      //!cut profile (bit) of jet track cuts in track table
+  TString                fEventHeaderMakerName;   // name of event header maker, "" = not used
+  StPicoEventHeaderMaker *fEventHeader;           //!event header maker
+
+  // event-wide constituent subtraction
+  Bool_t                 doEventConstSub;         // subtract the event (input vectors) before clustering
+  TString                fRhoMakerName;           // name of rho maker providing rho and rho_m
+  TString                fJetCacheMakerName;      // name of jet cache maker (kRead), "" = jet finding
+  Double_t               fCSMaxDeltaR;            // max particle-ghost distance
+  Double_t               fCSAlpha;                // distance weight pt^alpha
+  Double_t               fCSGhostArea;            // area of ghost grid cells
+
   // TEST ---
   StEmcGeom       *mGeom;
   StEmcCollection *mEmcCol;
+
+  // shared BEMC tower geometry and per-event vertex corrected tower positions (index = tower hit index)
+  StEmcPositionCache    *mPosition;               //!tower geometry cache
+  std::vector<Int_t>     fTowerHitID;             //!tower ID of each tower hit
+  std::vector<Float_t>   fTowerHitEta;            //!vertex corrected tower eta
+  std::vector<Float_t>   fTowerHitPhi;            //!vertex corrected tower phi (0, 2pi)
+  std::vector<Float_t>   fTowerHitCoshEta;        //!cosh(eta) of tower, for Et
+
+  // per-event corrected tower table
+  StCorrectedTowerTable *fTowerTable;             //!fired towers with hadronic correction
+  Bool_t                 fHadronicCorrSumTracks;  // subtract sum of all matched tracks from tower
   
   static const Int_t     fgkConstIndexShift;      //!contituent index shift
 
@@ -342,8 +437,6 @@ class StJetMakerTask : public StMaker {
   // centrality objects
   StRefMultCorr* grefmultCorr;
 
-  Float_t        mTowerMatchTrkIndex[4801];
-  Bool_t         mTowerStatusArr[4801];
 
   // histograms
   TH1F           *fHistCentrality;//!
@@ -222,43 +222,35 @@ Double32_t StJetShapeSigma2::result(const fastjet::PseudoJet &jet) const {
   return sigma2;
 }
 
+//________________________________________________________________________
+// one wrapper shared by the subjettiness functors: tau_1, tau_2, tau_3 and the opening
+// angle of the same jet are then taken from one exclusive kt reclustering
+static StFJWrapper *SubjettinessWrapper() {
+  static StFJWrapper wrapper("FJWrapperSubjettiness", "FJWrapperSubjettiness");
+  return &wrapper;
+}
+
 Double32_t StJetShape1subjettiness_kt::result(const fastjet::PseudoJet &jet) const {
   if (!jet.has_constituents()) 
     return 0;
-  StFJWrapper *fFastjetWrapper = new StFJWrapper("FJWrapper", "FJWrapper");
-  Double32_t Result = fFastjetWrapper->StFJWrapper::NSubjettinessDerivativeSub(1,0,0.2,1.0,0.4,jet,0);
-  fFastjetWrapper->Clear();
-  delete fFastjetWrapper;
-  return Result;
+  return SubjettinessWrapper()->NSubjettinessDerivativeSub(1,0,0.2,1.0,0.4,jet,0);
 }
 
 Double32_t StJetShape2subjettiness_kt::result(const fastjet::PseudoJet &jet) const {
   if (!jet.has_constituents()) 
     return 0;
-  StFJWrapper *fFastjetWrapper = new StFJWrapper("FJWrapper", "FJWrapper");
-  Double32_t Result = fFastjetWrapper->StFJWrapper::NSubjettinessDerivativeSub(2,0,0.2,1.0,0.4,jet,0);
-  fFastjetWrapper->Clear();
-  delete fFastjetWrapper;
-  return Result;
+  return SubjettinessWrapper()->NSubjettinessDerivativeSub(2,0,0.2,1.0,0.4,jet,0);
 }
 
 Double32_t StJetShape3subjettiness_kt::result(const fastjet::PseudoJet &jet) const {
   if (!jet.has_constituents()) 
     return 0;
-  StFJWrapper *fFastjetWrapper = new StFJWrapper("FJWrapper", "FJWrapper");
-  Double32_t Result = fFastjetWrapper->StFJWrapper::NSubjettinessDerivativeSub(3,0,0.2,1.0,0.4,jet,0);
-  fFastjetWrapper->Clear();
-  delete fFastjetWrapper;
-  return Result;
+  return SubjettinessWrapper()->NSubjettinessDerivativeSub(3,0,0.2,1.0,0.4,jet,0);
 }
 
 Double32_t StJetShapeOpeningAngle_kt::result(const fastjet::PseudoJet &jet) const {
   if (!jet.has_constituents()) 
     return 0;
-  StFJWrapper *fFastjetWrapper = new StFJWrapper("FJWrapper", "FJWrapper");
-  Double32_t Result = fFastjetWrapper->StFJWrapper::NSubjettinessDerivativeSub(2,0,0.2,1.0,0.4,jet,1);
-  fFastjetWrapper->Clear();
-  delete fFastjetWrapper;
-  return Result;
+  return SubjettinessWrapper()->NSubjettinessDerivativeSub(2,0,0.2,1.0,0.4,jet,1);
 }
 #endif
@@ -48,9 +48,13 @@
 #include "StRhoParameter.h"
 #include "StRho.h"
 #include "StJetMakerTask.h"
+#include "StPicoTrackTableMaker.h"
+#include "StPicoEventHeaderMaker.h"
+#include "StPicoTriggerDecoder.h"
 #include "StEventPoolManager.h"
 #include "StPicoTrk.h"
 #include "StFemtoTrack.h"
+#include "StJetHadronMixer.h"
 #include "StEPFlattener.h"
 #include "StCalibContainer.h"
 #include "runlistP16ij.h"
@@ -171,6 +175,10 @@ StMyAnalysisMaker::StMyAnalysisMaker(const char* name, StPicoDstMaker *picoMaker
   fTowerPhiMinCut = 0.0;  fTowerPhiMaxCut = 2.0*TMath::Pi();
   fDoEventMixing = 0; fMixingTracks = 50000; fNMIXtracks = 5000; fNMIXevents = 5;
   fCentBinSize = 5; fReduceStatsCent = -1;
+  doWritePoolMgr = kFALSE;
+  fPoolSnapshotIn = ""; fPoolSnapshotOut = ""; fPoolSnapshotLock = kTRUE;
+  fPoolMemoryBudget = 0; fPoolQuantized = kFALSE;
+  fMixSampleEvents = 0; fMixSampleTracks = 0; fMixSeed = 0;
   fCentralityScaled = 0.;
   ref16 = -99; ref9 = -99;
   Bfield = 0.0;
@@ -181,6 +189,8 @@ StMyAnalysisMaker::StMyAnalysisMaker(const char* name, StPicoDstMaker *picoMaker
   doComments = mDoComments;
   fhnJH = 0x0;
   fhnMixedEvents = 0x0;
+  fMixer = 0x0;
+  fMixRandom = 0x0;
   fhnCorr = 0x0;
   fhnEP = 0x0;
   fRho = 0x0;
@@ -383,6 +393,8 @@ StMyAnalysisMaker::~StMyAnalysisMaker()
 
   delete fhnJH;
   delete fhnMixedEvents;
+  delete fMixer;
+  delete fMixRandom;
   delete fhnCorr;
   delete fhnEP;
 
@@ -459,6 +471,9 @@ Int_t StMyAnalysisMaker::Finish() {
   if(fCalibFile->IsOpen()) fCalibFile->Close();
   if(fCalibFile2->IsOpen()) fCalibFile2->Close();
 
+  // export filled pools (input of later jobs, SetPoolSnapshotInput)
+  if(fPoolSnapshotOut != "" && fPoolMgr) fPoolMgr->WritePoolSnapshot(fPoolSnapshotOut.Data());
+
   //  Write histos to file and close it.
   if(mOutName!="") {
     TFile *fout = new TFile(mOutName.Data(), "UPDATE");
@@ -918,11 +933,19 @@ void StMyAnalysisMaker::DeclareHistograms() {
   //fPoolMgr = new StEventPoolManager(poolsize, trackDepth, nCentralityBinspp, centralityBinspp, nZvtxBins, zvtxbin);
   //fPoolMgr = new StEventPoolManager(poolsize, trackDepth, nCentralityBinsAuAu, centralityBinsAuAu, nZvtxBins, zvtxbin);
   fPoolMgr = new StEventPoolManager(poolsize, trackDepth, nCentBins, (Double_t*)centralityBin, nZvBins, (Double_t*)zvbin);
+  fPoolMgr->SetUseRingBuffer(kTRUE); // float pt, eta, phi + charge arrays instead of StFemtoTrack objects
+  if(fPoolQuantized) fPoolMgr->SetQuantizedStorage(kTRUE);
+  if(fPoolMemoryBudget > 0) fPoolMgr->SetMemoryBudget(fPoolMemoryBudget);
+
+  // pre-filled pools from a snapshot: mixing from the first event
+  if(fPoolSnapshotIn != "") fPoolMgr->ReadPoolSnapshot(fPoolSnapshotIn.Data(), fPoolSnapshotLock);
 
   // set up event mixing sparse
   //if(fDoEventMixing){
     bitcodeMESE = 1<<0 | 1<<1 | 1<<2 | 1<<3 | 1<<4 | 1<<5 | 1<<6 | 1<<7; // | 1<<8 | 1<<9;
     fhnMixedEvents = NewTHnSparseF("fhnMixedEvents", bitcodeMESE);
+    fMixer = new StJetHadronMixer(fhnMixedEvents); // track pt, deta, dphi, charge: axes 2, 3, 4, 7
+    fMixRandom = new TRandom3(1); // reseeded per event for sampled mixing
   //} // end of do-eventmixing
 
   UInt_t bitcodeCorr = 0; // bit coded, see GetDimparamsCorr() below
@@ -1041,10 +1064,17 @@ void StMyAnalysisMaker::WriteHistograms() {
 
   // jet sparse
   fhnJH->Write();
+  if(fMixer) fMixer->Flush(); // pending mixed-event pairs
   fhnMixedEvents->Write();
   fhnCorr->Write();
   //fhnEP->Write();
 
+  // event pools: merged between output files (e.g. parallel workers) by StEventPoolManager::Merge()
+  if(doWritePoolMgr && fPoolMgr) {
+    fPoolMgr->DetachSnapshot(); // snapshot pools are streamed from own storage
+    fPoolMgr->Write("EventPoolManager");
+  }
+
   // (perhaps temp - save resolution hists to main output file instead of event plane calibration file)
   if(doEventPlaneRes){
     for(Int_t i=0; i<9; i++){
@@ -1201,16 +1231,25 @@ Int_t StMyAnalysisMaker::Make() {
     return kStWarn;
   }
 
+  // shared event header (if set): event rejected for the whole chain,
+  // 80-100% centrality events go on to the cent16 cut below (kStWarn)
+  if(!InitEventHeader()) return kStWarn;
+  if(fEventHeader && (fEventHeader->GetRejection() & ~StPicoEventHeaderMaker::kRejectCentrality)) return kStOk;
+
   // get event B (magnetic) field
   Bfield = mPicoEvent->bField(); 
 
   // get vertex 3-vector and z-vertex component
   mVertex = mPicoEvent->primaryVertex();
   zVtx = mVertex.z();
+
+  // get shared track table (if set) and register track cuts
+  if(!InitTrackTable()) return kStWarn;
   
   // Z-vertex cut 
   // the Aj analysis cut on (-40, 40) for reference
-  if((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut)) return kStOk; //kStWarn;
+  // (done once per event by the shared event header when set)
+  if(!fEventHeader && ((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut))) return kStOk; //kStWarn;
   hEventZVertex->Fill(zVtx);
 
   // let me know the Run #, fill, and event ID
@@ -1218,7 +1257,7 @@ Int_t StMyAnalysisMaker::Make() {
   fRunNumber = mPicoEvent->runId();
   int fillId = mPicoEvent->fillId();
   int eventId = mPicoEvent->eventId();
-  double fBBCCoincidenceRate = mPicoEvent->BBCx();
+  //double fBBCCoincidenceRate = mPicoEvent->BBCx();
   //double fZDCCoincidenceRate = mPicoEvent->ZDCx();
   if(fDebugLevel == kDebugGeneralEvt) cout<<"RunID = "<<RunId<<"  fillID = "<<fillId<<"  eventID = "<<eventId<<endl; // what is eventID?i
 
@@ -1236,21 +1275,15 @@ Int_t StMyAnalysisMaker::Make() {
   // for only 14.5 GeV collisions from 2014 and earlier runs: refMult, for AuAu run14 200 GeV: grefMult 
   // https://github.com/star-bnl/star-phys/blob/master/StRefMultCorr/Centrality_def_refmult.txt
   // https://github.com/star-bnl/star-phys/blob/master/StRefMultCorr/Centrality_def_grefmult.txt
-  int grefMult = mPicoEvent->grefMult();
-  //int refMult = mPicoEvent->refMult();
-  grefmultCorr->init(RunId);
-  grefmultCorr->initEvent(grefMult, zVtx, fBBCCoincidenceRate);
+  // centrality correction done once per event by the shared event header when set
 //  if(grefmultCorr->isBadRun(RunId)) cout << "Run is bad" << endl; 
-//  if(grefmultCorr->isIndexOk()) cout << "Index Ok" << endl;
-//  if(grefmultCorr->isZvertexOk()) cout << "Zvertex Ok" << endl;
-//  if(grefmultCorr->isRefMultOk()) cout << "RefMult Ok" << endl;
   // 10 14 21 29 40 54 71 92 116 145 179 218 263 315 373 441  // RUN 14 AuAu binning
-  int cent16 = grefmultCorr->getCentralityBin16();
-  int cent9 = grefmultCorr->getCentralityBin9();
+  Int_t cent16, cent9;
+  Double_t refCorr2, eventWeight;
+  GetEventCentrality(zVtx, cent16, cent9, refCorr2, eventWeight);
   ref9 = GetCentBin(cent9, 9);
   ref16 = GetCentBin(cent16, 16);  
   Int_t centbin = GetCentBin(cent16, 16);
-  Double_t refCorr2 = grefmultCorr->getRefMultCorr(grefMult, zVtx, fBBCCoincidenceRate, 2);
   //Double_t refCorr1 = grefmultCorr->getRefMultCorr(grefMult, zVtx, fBBCCoincidenceRate, 1);
   //Double_t refCorr0 = grefmultCorr->getRefMultCorr(grefMult, zVtx, fBBCCoincidenceRate, 0);
 
@@ -1340,7 +1373,7 @@ Int_t StMyAnalysisMaker::Make() {
 
   // ============== RhoMaker =============== //
   // get RhoMaker from event: old names "StRho_JetsBG", "OutRho", "StMaker#0"
-  RhoMaker = static_cast<StRho*>(GetMaker(fRhoMakerName));
+  RhoMaker = static_cast<StRhoBase*>(GetMaker(fRhoMakerName));
   const char *fRhoMakerNameCh = fRhoMakerName;
   if(!RhoMaker) {
     LOG_WARN << Form(" No %s! Skip! ", fRhoMakerNameCh) << endm;
@@ -1369,7 +1402,7 @@ Int_t StMyAnalysisMaker::Make() {
   double rpAngle = GetReactionPlane();
   hEventPlane->Fill(rpAngle);
 
-  double eventWeight = grefmultCorr->getWeight();
+  // eventWeight: centrality correction weight, see GetEventCentrality()
   hEventPlaneWeighted->Fill(rpAngle, eventWeight);
 
   // switch to require specific trigger (for Event Plane corrections + Resolution)
@@ -1604,28 +1637,16 @@ Int_t StMyAnalysisMaker::Make() {
     // track loop inside jet loop - loop over ALL tracks in PicoDst
     for(int itrack = 0; itrack < ntracks; itrack++){
       // get tracks
-      StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(itrack));
-      if(!trk){ continue; }
-
       // acceptance and kinematic quality cuts
-      if(!AcceptTrack(trk, Bfield, mVertex)) { continue; }
-
-      // primary track switch
-      // get momentum vector of track - global or primary track
+      // get momentum vector of track - global or primary track (from track table when available)
       StThreeVectorF mTrkMom;
-      if(doUsePrimTracks) {
-        // get primary track vector
-        mTrkMom = trk->pMom();
-      } else {
-        // get global track vector
-        mTrkMom = trk->gMom(mVertex, Bfield);
-      }
+      if(!GetAcceptedTrack(itrack, mTrkMom)) { continue; }
 
       // track variables
       double pt = mTrkMom.perp();
       double phi = mTrkMom.phi();
       double eta = mTrkMom.pseudoRapidity();
-      short charge = trk->charge();
+      short charge = (fTrackTable) ? fTrackTable->GetCharge(itrack) : static_cast<StPicoTrack*>(mPicoDst->track(itrack))->charge();
 
       // get jet - track relations
       //deta = eta - jetEta;               // eta betweeen hadron and jet
@@ -1690,16 +1711,31 @@ Int_t StMyAnalysisMaker::Make() {
 
     if(fDebugLevel == kDebugMixedEvents) cout<<"NtracksInPool = "<<pool->NTracksInPool()<<"  CurrentNEvents = "<<pool->GetCurrentNEvents()<<endl;
 
-    // initialize background tracks array
-    TObjArray* bgTracks;
+    // background tracks of pool event: contiguous arrays in pool ring buffer
+    const Float_t *bgPt, *bgEta, *bgPhi;
+    const UShort_t *bgQPt, *bgQEta, *bgQPhi; // quantized pools
+    const Char_t  *bgCharge;
 
   // do event mixing when Signal Jet is part of event with a HT1 or HT2 or HT3 trigger firing
   if(doJetAnalysis) { // trigger type requested was fired for this event - do mixing
     if(pool->IsReady() || pool->NTracksInPool() > fNMIXtracks || pool->GetCurrentNEvents() >= fNMIXevents) {
 
+      // pool events to mix with this event: the whole pool, or sampled
+      // (SetMixSampling(): fixed number of events and / or track budget) with
+      // a random stream seeded from run and event id, so reruns and split jobs
+      // draw the same events. All jets of the event are mixed with the same
+      // events, the jet weight 1/nMix uses the number actually drawn
+      if(fMixSampleEvents > 0 || fMixSampleTracks > 0) {
+        UInt_t mixSeed = fMixSeed + 1000003u*(UInt_t)RunId + 7919u*(UInt_t)eventId;
+        fMixRandom->SetSeed(mixSeed ? mixSeed : 1); // 0: seed from time
+      }
+      int nMix = pool->GetRandomEvents(fMixEvents, fMixSampleEvents, fMixSampleTracks, fMixRandom);
+      if(fDebugLevel == kDebugMixedEvents) cout<<"nMix = "<<nMix<<" of "<<pool->GetCurrentNEvents()<<endl;
+
       // loop over Jets in the event
       //double Mixmaxtrackpt, MixNtrackConstit;
       // loop over jets (passing cuts - set by jet maker)
+      fMixer->ClearJets();
       for(int ijet = 0; ijet < njets; ijet++) {
         // leading jet
         Double_t leadjet = 0;
@@ -1726,66 +1762,38 @@ Int_t StMyAnalysisMaker::Make() {
         //if(jet->GetMaxTrackPt() < fTrackBias) continue; 
    	//TODO if (!AcceptJet(jet)) continue;  // acceptance cuts done to jet in JetMaker
 
-        // get number of current events in pool
-        int nMix = pool->GetCurrentNEvents();
-        //cout<<"nMix = "<<nMix<<endl;
-
         // Fill for biased jet triggers only
         //if ((jet->MaxTrackPt()>fTrkBias) || (jet->MaxClusterPt()>fClusBias)) {  // && jet->Pt() > fJetPtcut) {
         ///if(jet->GetMaxTrackPt() > fTrackBias) {  // update May14, 2018
         if((jet->GetMaxTrackPt() > fTrackBias) || (jet->GetMaxTowerE() > fTowerBias)) {
-          // Fill mixed-event histos here: loop over nMix events
-          for(int jMix = 0; jMix < nMix; jMix++) {
- 
-            // get jMix'th event
-            bgTracks = pool->GetEvent(jMix);
-            //TObjArray* bgTracks = pool->GetEvent(jMix);
-            const Int_t Nbgtrks = bgTracks->GetEntries();
-
-            // loop over background (mixed event) tracks
-            for(int ibg = 0; ibg < Nbgtrks; ibg++) {
-              // trying new slimmed PicoTrack class
-              //StPicoTrk* trk = (StPicoTrk*)bgTracks->At(ibg);
-              StFemtoTrack* trk = static_cast<StFemtoTrack*>(bgTracks->At(ibg));
-              if(!trk){ continue; }
-              double Mixphi = trk->Phi();
-              double Mixeta = trk->Eta();
-              double Mixpt = trk->Pt();
-              short Mixcharge = trk->Charge();
-
-              // shift angle (0, 2*pi) 
-              if(Mixphi < 0)    Mixphi += 2*pi;
-              if(Mixphi > 2*pi) Mixphi -= 2*pi;
-
-              //cout<<"itrack = "<<ibg<<"  phi = "<<Mixphi<<"  eta = "<<Mixeta<<"  pt = "<<Mixpt<<"  q = "<<Mixcharge<<endl;
-
-              // get jet - track relations
-              //double deta = eta - jetEta;               // eta betweeen hadron and jet
-              double dMixeta = MixjetEta - Mixeta;               // eta betweeen jet and hadron
-              double dMixphijh = RelativePhi(MixjetPhi, Mixphi); // angle between jet and hadron
-              //double dMixphijh = StJetFrameworkPicoBase::RelativePhi(MixjetPhi, Mixphi);
-
-              // print tracks outside of acceptance somehow
-              if(fDebugLevel == kDebugMixedEvents) if((dMixeta > 1.6) || (dMixeta < -1.6)) cout<<"DELTA ETA is somehow out of bounds...  deta = "<<dMixeta<<"   iTrack = "<<ibg<<"  jetEta = "<<MixjetEta<<"  trk eta = "<<Mixeta<<endl;
-
-              // calculate single particle tracking efficiency of mixed events for correlations
-              double mixefficiency = 1.0;
-              //FIXME mixefficiency = EffCorrection(part->Eta(), part->Pt(), fDoEffCorr);                           
-
-              double Mixjetptselected;
-              if(fCorrJetPt) { Mixjetptselected = Mixcorrjetpt;
-              } else { Mixjetptselected = Mixjetpt; }
-
-              // create / fill mixed event sparse
-              double triggerEntries[8] = {centbin*5.0, Mixjetptselected, Mixpt, dMixeta, dMixphijh, dMixEP, zVtx, (double)Mixcharge}; //array for ME sparse
-              if(fReduceStatsCent > 0) {
-                if(cbin == fReduceStatsCent) fhnMixedEvents->Fill(triggerEntries,1./(nMix*mixefficiency));   // fill Sparse histo of mixed events
-              } else fhnMixedEvents->Fill(triggerEntries,1./(nMix*mixefficiency));   // fill Sparse histo of mixed events
-
-            } // end of background track loop
-          } // end of filling mixed-event histo's:  jth mix event loop
+          // calculate single particle tracking efficiency of mixed events for correlations
+          double mixefficiency = 1.0;
+          //FIXME mixefficiency = EffCorrection(part->Eta(), part->Pt(), fDoEffCorr);                           
+
+          double Mixjetptselected;
+          if(fCorrJetPt) { Mixjetptselected = Mixcorrjetpt;
+          } else { Mixjetptselected = Mixjetpt; }
+
+          // register jet with the mixing kernel: track pt, deta, dphi and charge are set per pool track
+          double triggerEntries[8] = {centbin*5.0, Mixjetptselected, 0., 0., 0., dMixEP, zVtx, 0.}; //array for ME sparse
+          if((fReduceStatsCent <= 0) || (cbin == fReduceStatsCent)) fMixer->AddJet(triggerEntries, MixjetEta, MixjetPhi, 1./(nMix*mixefficiency));
         } // end of check for biased jet triggers
       } // end of jet loop
+
+      // Fill mixed-event histos here: loop over nMix events, each pool event is paired with all jets
+      if(fMixer->GetNumberOfJets() > 0) {
+        for(int jMix = 0; jMix < nMix; jMix++) {
+          // get jMix'th mixed event (quantized pools: decoded in the kernel)
+          const int iMix = fMixEvents[jMix];
+          if(pool->IsQuantized()) {
+            const Int_t Nbgtrks = pool->GetEventTracks(iMix, bgQPt, bgQEta, bgQPhi, bgCharge);
+            fMixer->FillEvent(Nbgtrks, bgQPt, bgQEta, bgQPhi, bgCharge, StEventPool::fgQuantRange);
+          } else {
+            const Int_t Nbgtrks = pool->GetEventTracks(iMix, bgPt, bgEta, bgPhi, bgCharge);
+            fMixer->FillEvent(Nbgtrks, bgPt, bgEta, bgPhi, bgCharge);
+          }
+        } // end of jth mix event loop
+      }
     } // end of check for pool being ready
   } // end EMC triggered loop
 
@@ -1796,7 +1804,7 @@ Int_t StMyAnalysisMaker::Make() {
 
       // create a list of reduced objects. This speeds up processing and reduces memory consumption for the event pool
       // update pool if jet in event or not
-      pool->UpdatePool(CloneAndReduceTrackList());
+      UpdatePoolWithReducedTracks(pool);
 
       // fill QA histo's
       hMixEvtStatZVtx->Fill(zVtx);
@@ -2251,34 +2259,20 @@ TClonesArray* StMyAnalysisMaker::CloneAndReduceTrackList()
 
   // loop over tracks
   for(int i = 0; i < nMixTracks; i++) { 
-    StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(i));
-    if(!trk){ continue; }
-
     // acceptance and kinematic quality cuts
-    if(!AcceptTrack(trk, Bfield, mVertex)) { continue; }
-
-    // primary track switch
-    // get momentum vector of track - global or primary track
+    // get momentum vector of track - global or primary track (from track table when available)
     StThreeVectorF mTrkMom;
-    if(doUsePrimTracks) {
-      if(!(trk->isPrimary())) continue; // check if primary
-      
-      // get primary track vector
-      mTrkMom = trk->pMom();
-    } else {
-      // get global track vector
-      mTrkMom = trk->gMom(mVertex, Bfield);
-    }
+    if(!GetAcceptedTrack(i, mTrkMom)) { continue; }
 
-    // track variables - used with alt method below
-    //double pt = mTrkMom.perp();
-    //double phi = mTrkMom.phi();
-    //double eta = mTrkMom.pseudoRapidity();
-    //short charge = trk->charge();
+    // track variables
+    double pt = mTrkMom.perp();
+    double phi = mTrkMom.phi();
+    double eta = mTrkMom.pseudoRapidity();
+    short charge = (fTrackTable) ? fTrackTable->GetCharge(i) : static_cast<StPicoTrack*>(mPicoDst->track(i))->charge();
 
     // create StFemtoTracks out of accepted tracks - light-weight object for mixing
-    //  StFemtoTrack *t = new StFemtoTrack(pt, eta, phi, charge);
-    StFemtoTrack* t = new StFemtoTrack(trk, Bfield, mVertex, doUsePrimTracks);
+    //  StFemtoTrack* t = new StFemtoTrack(trk, Bfield, mVertex, doUsePrimTracks);
+    StFemtoTrack *t = new StFemtoTrack(pt, eta, phi, charge);
     if(!t) continue;
 
     // add light-weight tracks passing cuts to TClonesArray
@@ -2291,6 +2285,36 @@ TClonesArray* StMyAnalysisMaker::CloneAndReduceTrackList()
   return tracksClone;
 }
 
+//_________________________________________________
+// Fill the pool with the accepted tracks of the event as contiguous float arrays
+Int_t StMyAnalysisMaker::UpdatePoolWithReducedTracks(StEventPool *pool)
+{
+  // reuse buffers, no per-track objects
+  fMixTrackPt.clear(); fMixTrackEta.clear(); fMixTrackPhi.clear(); fMixTrackCharge.clear();
+
+  // construct variables, get # of tracks
+  int nMixTracks = mPicoDst->numberOfTracks();
+
+  // loop over tracks
+  for(int i = 0; i < nMixTracks; i++) {
+    // acceptance and kinematic quality cuts
+    // get momentum vector of track - global or primary track (from track table when available)
+    StThreeVectorF mTrkMom;
+    if(!GetAcceptedTrack(i, mTrkMom)) { continue; }
+
+    // track variables
+    short charge = (fTrackTable) ? fTrackTable->GetCharge(i) : static_cast<StPicoTrack*>(mPicoDst->track(i))->charge();
+    fMixTrackPt.push_back(mTrkMom.perp());
+    fMixTrackEta.push_back(mTrkMom.pseudoRapidity());
+    fMixTrackPhi.push_back(mTrkMom.phi());
+    fMixTrackCharge.push_back((Char_t)charge);
+  } // end of looping through tracks
+
+  Int_t nAccTracks = fMixTrackPt.size();
+  if(nAccTracks == 0) return pool->UpdatePool(0, 0, 0, 0, 0);
+  return pool->UpdatePool(nAccTracks, &fMixTrackPt[0], &fMixTrackEta[0], &fMixTrackPhi[0], &fMixTrackCharge[0]);
+}
+
 //________________________________________________________________________
 Bool_t StMyAnalysisMaker::AcceptTrack(StPicoTrack *trk, Float_t B, StThreeVectorF Vert) {
   // constants: assume neutral pion mass
@@ -2427,108 +2451,14 @@ TH1* StMyAnalysisMaker::FillEmcTriggersHist(TH1* h) {
 //_____________________________________________________________________________
 // Trigger QA histogram, label bins 
 TH1* StMyAnalysisMaker::FillEventTriggerQA(TH1* h) {
-  // check and fill a Event Selection QA histogram for different trigger selections after cuts
-
-  // Run14 AuAu 200 GeV
-  if(fRunFlag == StJetFrameworkPicoBase::Run14_AuAu200) {
-    int arrHT1[] = {450201, 450211, 460201};
-    int arrHT2[] = {450202, 450212, 460202, 460212};
-    int arrHT3[] = {460203, 450213, 460203};
-    int arrMB[] = {450014};
-    int arrMB30[] = {450010, 450020};
-    int arrMB5[] = {450005, 450008, 450009, 450014, 450015, 450018, 450024, 450025, 450050, 450060};
-    int arrCentral5[] = {450010, 450020};
-    int arrCentral[] = {460101, 460111};
-
-    int bin = 0;
-    if(DoComparison(arrHT1, sizeof(arrHT1)/sizeof(*arrHT1))) { bin = 2; h->Fill(bin); } // HT1
-    if(DoComparison(arrHT2, sizeof(arrHT2)/sizeof(*arrHT2))) { bin = 3; h->Fill(bin); } // HT2
-    if(DoComparison(arrHT3, sizeof(arrHT3)/sizeof(*arrHT3))) { bin = 4; h->Fill(bin); } // HT3 
-    if(DoComparison(arrMB, sizeof(arrMB)/sizeof(*arrMB))) { bin = 5; h->Fill(bin); } // MB 
-    //if() { bin = 6; h->Fill(bin); } 
-    if(DoComparison(arrCentral5, sizeof(arrCentral5)/sizeof(*arrCentral5))) { bin = 7; h->Fill(bin); }// Central-5
-    if(DoComparison(arrCentral, sizeof(arrCentral)/sizeof(*arrCentral))) { bin = 8; h->Fill(bin); } // Central & Central-mon
-    if(DoComparison(arrMB5, sizeof(arrMB5)/sizeof(*arrMB5))) { bin = 10; h->Fill(bin); }// VPDMB-5 
-    if(DoComparison(arrMB30, sizeof(arrMB30)/sizeof(*arrMB30))) { bin = 11; h->Fill(bin); } // VPDMB-30
- 
-    // label bins of the analysis trigger selection summary
-    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
-    h->GetXaxis()->SetBinLabel(2, "BHT1*VPDMB-30");
-    h->GetXaxis()->SetBinLabel(3, "BHT2*VPDMB-30");
-    h->GetXaxis()->SetBinLabel(4, "BHT3");
-    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-nobsmd");
-    h->GetXaxis()->SetBinLabel(6, "");
-    h->GetXaxis()->SetBinLabel(7, "Central-5");
-    h->GetXaxis()->SetBinLabel(8, "Central or Central-mon");
-    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
-    h->GetXaxis()->SetBinLabel(11, "VPDMB-30");
-  }
+  // check and fill a Event Selection QA histogram for different trigger selections:
+  // trigger bits of the event, decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, fRunFlag);
+  StPicoTriggerDecoder::FillEventTriggerQA(h, mask, fRunFlag);
 
-  // Run16 AuAu
-  if(fRunFlag == StJetFrameworkPicoBase::Run16_AuAu200) {
-    int bin = 0;
-
-    // hard-coded trigger Ids for run16
-    //int arrHT0[] = {520606, 520616, 520626, 520636, 520646, 520656};
-    int arrHT1[] = {520201, 520211, 520221, 520231, 520241, 520251, 520261, 520605, 520615, 520625, 520635, 520645, 520655, 550201, 560201, 560202, 530201, 540201};
-    int arrHT2[] = {530202, 540203};
-    int arrHT3[] = {520203, 530213};
-    int arrMB[] = {520021};
-    int arrMB5[] = {520001, 520002, 520003, 520011, 520012, 520013, 520021, 520022, 520023, 520031, 520033, 520041, 520042, 520043, 520051, 520822, 520832, 520842, 570702};
-    int arrMB10[] = {520007, 520017, 520027, 520037, 520201, 520211, 520221, 520231, 520241, 520251, 520261, 520601, 520611, 520621, 520631, 520641};
-    int arrCentral[] = {520101, 520111, 520121, 520131, 520141, 520103, 520113, 520123};
-
-    // fill for kAny
-    bin = 1; h->Fill(bin);
-
-    // check if event triggers meet certain criteria and fill histos
-    if(DoComparison(arrHT1, sizeof(arrHT1)/sizeof(*arrHT1))) { bin = 2; h->Fill(bin); } // HT1
-    if(DoComparison(arrHT2, sizeof(arrHT2)/sizeof(*arrHT2))) { bin = 3; h->Fill(bin); } // HT2
-    if(DoComparison(arrHT3, sizeof(arrHT3)/sizeof(*arrHT3))) { bin = 4; h->Fill(bin); } // HT3
-    if(DoComparison(arrMB, sizeof(arrMB)/sizeof(*arrMB))) { bin = 5; h->Fill(bin); }  // MB
-    //if(mytriggers[i] == 999999) { bin = 6; h->Fill(bin); }
-    if(DoComparison(arrCentral, sizeof(arrCentral)/sizeof(*arrCentral))) { bin = 7; h->Fill(bin); }// Central-5 & Central-novtx
-    //if(mytriggers[i] == 999999) { bin = 8; h->Fill(bin); } 
-    if(DoComparison(arrMB5, sizeof(arrMB5)/sizeof(*arrMB5))) { bin = 10; h->Fill(bin); } // VPDMB-5 
-    if(DoComparison(arrMB10, sizeof(arrMB10)/sizeof(*arrMB10))) { bin = 11; h->Fill(bin); }// VPDMB-10
-
-    // label bins of the analysis trigger selection summary
-    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
-    h->GetXaxis()->SetBinLabel(2, "BHT1");
-    h->GetXaxis()->SetBinLabel(3, "BHT2");
-    h->GetXaxis()->SetBinLabel(4, "BHT3");
-    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-p-sst");
-    h->GetXaxis()->SetBinLabel(6, "");
-    h->GetXaxis()->SetBinLabel(7, "Central");
-    h->GetXaxis()->SetBinLabel(8, "");
-    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
-    h->GetXaxis()->SetBinLabel(11, "VPDMB-10");
-  }
-
-  // set x-axis labels vertically
-  h->LabelsOption("v");
-  //h->LabelsDeflate("X");
-  
   return h;
 }
 
-// elems: sizeof(myarr)/sizeof(*myarr) prior to passing to function
-// upon passing the array collapses to a pointer and can not get size anymore
-//________________________________________________________________________
-Bool_t StMyAnalysisMaker::DoComparison(int myarr[], int elems) {
-  //std::cout << "Length of array = " << (sizeof(myarr)/sizeof(*myarr)) << std::endl;
-  bool match = kFALSE;
-
-  // loop over specific physics selection array and compare to specific event trigger
-  for(int i = 0; i < elems; i++) {
-    if(mPicoEvent->isTrigger(myarr[i])) match = kTRUE;
-    if(match) break;
-  }
-  //cout<<"elems: "<<elems<<"  match: "<<match<<endl;
-
-  return match;
-}
-
 //________________________________________________________________________
 Double_t StMyAnalysisMaker::GetReactionPlane() { 
   //if(mVerbose)cout << "----------- In GetReactionPlane() -----------------" << endl;
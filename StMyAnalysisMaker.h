@@ -7,6 +7,7 @@
 #include "StMaker.h"
 #include "StRoot/StPicoEvent/StPicoEvent.h"
 #include "StJetFrameworkPicoBase.h"
+#include <vector>
 class StJetFrameworkPicoBase;
 
 // ROOT classes
@@ -34,6 +35,9 @@ class StJet;
 class StRho;
 class StRhoParameter;
 class StEventPoolManager;
+class StEventPool;
+class StJetHadronMixer;
+class TRandom3;
 class StCalibContainer;
 class StEPFlattener;
 
@@ -140,6 +144,13 @@ class StMyAnalysisMaker : public StJetFrameworkPicoBase {
     virtual void            SetMixingTracks(Int_t tracks)      { fMixingTracks = tracks; }
     virtual void            SetNMixedTr(Int_t nmt)             { fNMIXtracks = nmt; }
     virtual void            SetNMixedEvt(Int_t nme)            { fNMIXevents = nme; }
+    virtual void            SetWritePoolManager(Bool_t w)      { doWritePoolMgr = w; } // save event pools: merged with the output (StEventPoolManager::Merge)
+    virtual void            SetPoolSnapshotInput(const char *f, Bool_t lock = kTRUE) { fPoolSnapshotIn = f; fPoolSnapshotLock = lock; } // pre-filled pools, memory mapped at Init
+    virtual void            SetPoolSnapshotOutput(const char *f) { fPoolSnapshotOut = f; } // export filled pools at Finish
+    virtual void            SetPoolMemoryBudget(Long64_t bytes)  { fPoolMemoryBudget = bytes; } // track memory of all pools, shared by demand (0: no limit)
+    virtual void            SetPoolQuantized(Bool_t q)           { fPoolQuantized = q; } // 16 bit pt, eta, phi in the pools
+    virtual void            SetMixSampling(Int_t nev, Int_t ntrk = 0) { fMixSampleEvents = nev; fMixSampleTracks = ntrk; } // pool events / track budget mixed per trigger event (0: whole pool)
+    virtual void            SetMixSeed(UInt_t seed)              { fMixSeed = seed; } // sampled mixing: random stream seeded per run / event id
     virtual void            SetCentBinSize(Int_t centbins)       { fCentBinSize = centbins; }
     virtual void            SetReduceStatsCent(Int_t red)        { fReduceStatsCent = red; }
 
@@ -191,7 +202,6 @@ class StMyAnalysisMaker : public StJetFrameworkPicoBase {
     void                   GetEventPlane(Bool_t flattenEP, Int_t n, Int_t method, Double_t ptcut, Int_t ptbin);// get event plane / flatten and fill histos 
     Bool_t                 AcceptTrack(StPicoTrack *trk, Float_t B, StThreeVectorF Vert);  // track accept cuts function
     Bool_t                 AcceptJet(StJet *jet);           // jets accept cuts function
-    Bool_t                 DoComparison(int myarr[], int elems);
     void                   SetSumw2(); // set errors weights 
     void                   SetEPSumw2(); // set errors weights for event plane histograms
     //Double_t               EffCorrection(Double_t trkETA, Double_t trkPT, Int_t effswitch) const; // efficiency correction function
@@ -226,6 +236,15 @@ class StMyAnalysisMaker : public StJetFrameworkPicoBase {
     Int_t          fNMIXevents;                 // MIN # of mixing events in pool before performing mixing
     Int_t          fCentBinSize;                // centrality bin size of mixed event pools
     Int_t          fReduceStatsCent;            // bins to use for reduced statistics of sparse
+    Bool_t         doWritePoolMgr;              // write event pool manager to output
+    TString        fPoolSnapshotIn;             // pool snapshot to import (StEventPoolManager::ReadPoolSnapshot)
+    TString        fPoolSnapshotOut;            // pool snapshot to export (StEventPoolManager::WritePoolSnapshot)
+    Bool_t         fPoolSnapshotLock;           // imported pools are locked (not updated, shared read-only)
+    Long64_t       fPoolMemoryBudget;           // memory budget of the event pools in bytes (0: no limit)
+    Bool_t         fPoolQuantized;              // quantized (16 bit) track storage of the event pools
+    Int_t          fMixSampleEvents;            // sampled mixing: MAX # of pool events per trigger event (0: all)
+    Int_t          fMixSampleTracks;            // sampled mixing: track budget per trigger event (0: no budget)
+    UInt_t         fMixSeed;                    // sampled mixing: seed of the random stream
 
     // event selection types
     UInt_t         fEmcTriggerEventType;        // Physics selection of event used for signal
@@ -282,7 +301,12 @@ class StMyAnalysisMaker : public StJetFrameworkPicoBase {
 
     // event pool
     TClonesArray          *CloneAndReduceTrackList();
+    Int_t                  UpdatePoolWithReducedTracks(StEventPool *pool);
     StEventPoolManager    *fPoolMgr;//!  // event pool Manager object
+    std::vector<Float_t>   fMixTrackPt;//!     // reduced tracks of current event for pool update
+    std::vector<Float_t>   fMixTrackEta;//!
+    std::vector<Float_t>   fMixTrackPhi;//!
+    std::vector<Char_t>    fMixTrackCharge;//!
 
   private:
     //void                   GetVZEROEventPlane(Bool_t isFlatten);
@@ -484,6 +508,9 @@ class StMyAnalysisMaker : public StJetFrameworkPicoBase {
     // THn Sparse's jet sparse
     THnSparse             *fhnJH;//!           // jet hadron events matrix
     THnSparse             *fhnMixedEvents;//!  // mixed events matrix
+    StJetHadronMixer      *fMixer;//!          // mixed-event kernel filling fhnMixedEvents
+    TRandom3              *fMixRandom;//!      // random stream of sampled mixing
+    std::vector<Int_t>     fMixEvents;//!      // pool events mixed with the current event
     THnSparse             *fhnCorr;//!         // sparse to get # jet triggers
 
     THnSparse             *fhnEP;//!           // event plane sparse
@@ -51,6 +51,8 @@
 #include "StEventPoolManager.h"
 #include "StPicoTrk.h"
 #include "StFemtoTrack.h"
+#include "StJetHadronMixer.h"
+#include "StPicoTriggerDecoder.h"
 #include "runlistP16ij.h"
 #include "runlistP17id.h" // SL17i - Run14, now SL18b (March20)
 
@@ -158,6 +160,9 @@ StMyAnalysisMaker3::StMyAnalysisMaker3(const char* name, StPicoDstMaker *picoMak
   fTowerPhiMinCut = 0.0; fTowerPhiMaxCut = 2.0*TMath::Pi();
   fDoEventMixing = 0; fMixingTracks = 50000; fNMIXtracks = 5000; fNMIXevents = 5;
   fCentBinSize = 5; fReduceStatsCent = -1;
+  fPoolSnapshotIn = ""; fPoolSnapshotOut = ""; fPoolSnapshotLock = kTRUE;
+  fPoolMemoryBudget = 0; fPoolQuantized = kFALSE;
+  fMixSampleEvents = 0; fMixSampleTracks = 0; fMixSeed = 0;
   fCentralityScaled = 0.;
   ref16 = -99; ref9 = -99;
   Bfield = 0.0;
@@ -169,6 +174,8 @@ StMyAnalysisMaker3::StMyAnalysisMaker3(const char* name, StPicoDstMaker *picoMak
   doComments = mDoComments;
   fhnJH = 0x0;
   fhnMixedEvents = 0x0;
+  fMixer = 0x0;
+  fMixRandom = 0x0;
   fhnCorr = 0x0;
   fAnalysisMakerName = name;
   fJetMakerName = jetMakerName;
@@ -264,6 +271,8 @@ StMyAnalysisMaker3::~StMyAnalysisMaker3()
 
   delete fhnJH;
   delete fhnMixedEvents;
+  delete fMixer;
+  delete fMixRandom;
   delete fhnCorr;
 
 //  fJets->Clear(); delete fJets;
@@ -326,6 +335,9 @@ Int_t StMyAnalysisMaker3::Finish() {
   //cout << "\tWithout PV cuts: "<< mAllPVEventCounter << " events"<<endl;
   //cout << "\tInput events: "<<mInputEventCounter<<endl;
 
+  // export filled pools (input of later jobs, SetPoolSnapshotInput)
+  if(fPoolSnapshotOut != "" && fPoolMgr) fPoolMgr->WritePoolSnapshot(fPoolSnapshotOut.Data());
+
   //  Write histos to file and close it.
   if(mOutName!="") {
     TFile *fout = new TFile(mOutName.Data(), "UPDATE");
@@ -616,11 +628,19 @@ void StMyAnalysisMaker3::DeclareHistograms() {
   //fPoolMgr = new StEventPoolManager(poolsize, trackDepth, nCentralityBinspp, centralityBinspp, nZvtxBins, zvtxbin);
   //fPoolMgr = new StEventPoolManager(poolsize, trackDepth, nCentralityBinsAuAu, centralityBinsAuAu, nZvtxBins, zvtxbin);
   fPoolMgr = new StEventPoolManager(poolsize, trackDepth, nCentBins, (Double_t*)centralityBin, nZvBins, (Double_t*)zvbin);
+  fPoolMgr->SetUseRingBuffer(kTRUE); // float pt, eta, phi + charge arrays instead of StFemtoTrack objects
+  if(fPoolQuantized) fPoolMgr->SetQuantizedStorage(kTRUE);
+  if(fPoolMemoryBudget > 0) fPoolMgr->SetMemoryBudget(fPoolMemoryBudget);
+
+  // pre-filled pools from a snapshot: mixing from the first event
+  if(fPoolSnapshotIn != "") fPoolMgr->ReadPoolSnapshot(fPoolSnapshotIn.Data(), fPoolSnapshotLock);
 
   // set up event mixing sparse
   //if(fDoEventMixing){
     bitcodeMESE = 1<<0 | 1<<1 | 1<<2 | 1<<3 | 1<<4 | 1<<5 | 1<<6 | 1<<7; // | 1<<8 | 1<<9;
     fhnMixedEvents = NewTHnSparseF("fhnMixedEvents", bitcodeMESE);
+    fMixer = new StJetHadronMixer(fhnMixedEvents); // track pt, deta, dphi, charge: axes 2, 3, 4, 7
+    fMixRandom = new TRandom3(1); // reseeded per event for sampled mixing
   //} // end of do-eventmixing
 
   UInt_t bitcodeCorr = 0; // bit coded, see GetDimparamsCorr() below
@@ -719,6 +739,7 @@ void StMyAnalysisMaker3::WriteHistograms() {
 
   // jet sparse
   fhnJH->Write();
+  if(fMixer) fMixer->Flush(); // pending mixed-event pairs
   fhnMixedEvents->Write();
   fhnCorr->Write();
 
@@ -902,7 +923,7 @@ Int_t StMyAnalysisMaker3::Make() {
 
   // ============== RhoMaker =============== //
   // get RhoMaker from event: old names "StRho_JetsBG", "OutRho", "StMaker#0"
-  RhoMaker = static_cast<StRho*>(GetMaker(fRhoMakerName));
+  RhoMaker = static_cast<StRhoBase*>(GetMaker(fRhoMakerName));
   const char *fRhoMakerNameCh = fRhoMakerName;
   if(!RhoMaker) {
     LOG_WARN << Form(" No %s! Skip! ", fRhoMakerNameCh) << endm;
@@ -1312,15 +1333,30 @@ Int_t StMyAnalysisMaker3::Make() {
 
     if(fDebugLevel == kDebugMixedEvents) cout<<"NtracksInPool = "<<pool->NTracksInPool()<<"  CurrentNEvents = "<<pool->GetCurrentNEvents()<<endl;
 
-    // initialize background tracks array
-    TObjArray* bgTracks;
+    // background tracks of pool event: contiguous arrays in pool ring buffer
+    const Float_t *bgPt, *bgEta, *bgPhi;
+    const UShort_t *bgQPt, *bgQEta, *bgQPhi; // quantized pools
+    const Char_t  *bgCharge;
 
   // do event mixing when Signal Jet is part of event with a HT1 or HT2 or HT3 trigger firing
   if(doJetAnalysis) { // trigger type requested was fired for this event - do mixing
     if(pool->IsReady() || pool->NTracksInPool() > fNMIXtracks || pool->GetCurrentNEvents() >= fNMIXevents) {
 
+      // pool events to mix with this event: the whole pool, or sampled
+      // (SetMixSampling(): fixed number of events and / or track budget) with
+      // a random stream seeded from run and event id, so reruns and split jobs
+      // draw the same events. All jets of the event are mixed with the same
+      // events, the jet weight 1/nMix uses the number actually drawn
+      if(fMixSampleEvents > 0 || fMixSampleTracks > 0) {
+        UInt_t mixSeed = fMixSeed + 1000003u*(UInt_t)RunId + 7919u*(UInt_t)eventId;
+        fMixRandom->SetSeed(mixSeed ? mixSeed : 1); // 0: seed from time
+      }
+      int nMix = pool->GetRandomEvents(fMixEvents, fMixSampleEvents, fMixSampleTracks, fMixRandom);
+      if(fDebugLevel == kDebugMixedEvents) cout<<"nMix = "<<nMix<<" of "<<pool->GetCurrentNEvents()<<endl;
+
       //double Mixmaxtrackpt, MixNtrackConstit;
       // loop over jets (passing cuts - set by jet maker)
+      fMixer->ClearJets();
       for(int ijet = 0; ijet < njets; ijet++) {
         // leading jet - why was this a double?
         Double_t leadjet = 0;
@@ -1362,79 +1398,37 @@ Int_t StMyAnalysisMaker3::Make() {
         //if((jet->GetMaxTrackPt() < fTrackBias) && (jet->GetMaxTowerE() < fTowerBias)) continue;
    	//TODO if (!AcceptJet(jet)) continue;  // acceptance cuts done to jet in JetMaker
 
-        // get number of current events in pool
-        int nMix = pool->GetCurrentNEvents();
-
         // Fill for biased jet triggers only
         if((jet->GetMaxTrackPt() > fTrackBias) || (jet->GetMaxTowerE() > fTowerBias)) {
-          // Fill mixed-event histos here: loop over nMix events
-          for(int jMix = 0; jMix < nMix; jMix++) {
- 
-            // get jMix'th event
-            bgTracks = pool->GetEvent(jMix);
-            //TObjArray* bgTracks = pool->GetEvent(jMix);
-            const Int_t Nbgtrks = bgTracks->GetEntries();
-
-            // loop over background (mixed event) tracks
-            for(int ibg = 0; ibg < Nbgtrks; ibg++) {
-              // trying new slimmed PicoTrack class: StFemtoTrack
-              StFemtoTrack* trk = static_cast<StFemtoTrack*>(bgTracks->At(ibg));
-              if(!trk) continue;
-              double Mixphi = trk->Phi();
-              double Mixeta = trk->Eta();
-              double Mixpt = trk->Pt();
-              short Mixcharge = trk->Charge();
-
-              // shift angle (0, 2*pi) 
-              if(Mixphi < 0)    Mixphi += 2*pi;
-              if(Mixphi > 2*pi) Mixphi -= 2*pi;
-              //cout<<"itrack = "<<ibg<<"  phi = "<<Mixphi<<"  eta = "<<Mixeta<<"  pt = "<<Mixpt<<"  q = "<<Mixcharge<<endl;
-
-              // get jet - track relations
-              //double deta = eta - jetEta;               // eta betweeen hadron and jet
-              double dMixeta = MixjetEta - Mixeta;               // eta betweeen jet and hadron
-              double dMixphijh = RelativePhi(MixjetPhi, Mixphi); // angle between jet and hadron
-
-              // print tracks outside of acceptance somehow
-              if(fDebugLevel == kDebugMixedEvents) if((dMixeta > 1.6) || (dMixeta < -1.6)) cout<<"DELTA ETA is somehow out of bounds...  deta = "<<dMixeta<<"   iTrack = "<<ibg<<"  jetEta = "<<MixjetEta<<"  trk eta = "<<Mixeta<<endl;
-
-              // calculate single particle tracking efficiency of mixed events for correlations (-999)
-              double mixefficiency = 1.0;
-              //FIXME mixefficiency = EffCorrection(part->Eta(), part->Pt(), fDoEffCorr);                           
-
-              // select which jet pt to use for filling
-              double Mixjetptselected;
-              if(fCorrJetPt) { Mixjetptselected = Mixcorrjetpt;
-              } else { Mixjetptselected = Mixjetpt; }
-
-              // === June 1, 2018 - these cuts should not be here!
-/*
-              // 0.25-0.5, 0.5-1.0, 1.0-1.5, 1.5-2.0    - also added 2.0-3.0, 3.0-4.0, 4.0-5.0
-              // when doing event plane calculation via pt assoc bin
-              if(doTPCptassocBin) {
-                if(fTPCptAssocBin == 0) { if((Mixpt > 0.25) && (Mixpt <= 0.5)) continue; }  // 0.25 - 0.5 GeV assoc bin used for correlations
-                if(fTPCptAssocBin == 1) { if((Mixpt > 0.50) && (Mixpt <= 1.0)) continue; }  // 0.50 - 1.0 GeV assoc bin used for correlations
-                if(fTPCptAssocBin == 2) { if((Mixpt > 1.00) && (Mixpt <= 1.5)) continue; }  // 1.00 - 1.5 GeV assoc bin used for correlations
-                if(fTPCptAssocBin == 3) { if((Mixpt > 1.50) && (Mixpt <= 2.0)) continue; }  // 1.50 - 2.0 GeV assoc bin used for correlations
-                if(fTPCptAssocBin == 4) { if((Mixpt > 2.00) && (Mixpt <= 20.)) continue; }  // 2.00 - MAX GeV assoc bin used for correlations
-                if(fTPCptAssocBin == 5) { if((Mixpt > 2.00) && (Mixpt <= 3.0)) continue; }  // 2.00 - 3.0 GeV assoc bin used for correlations
-                if(fTPCptAssocBin == 6) { if((Mixpt > 3.00) && (Mixpt <= 4.0)) continue; }  // 3.00 - 4.0 GeV assoc bin used for correlations
-                if(fTPCptAssocBin == 7) { if((Mixpt > 4.00) && (Mixpt <= 5.0)) continue; }  // 4.00 - 5.0 GeV assoc bin used for correlations
-              }
-*/
-
-              // create / fill mixed event sparse
-              //double triggerEntries[8]; //i = {centbin*5.0, Mixjetptselected, Mixpt, dMixeta, dMixphijh, dMixEP, zVtx, (double)Mixcharge};
-              double triggerEntries[8] = {centbin*5.0, Mixjetptselected, Mixpt, dMixeta, dMixphijh, dMixEP, zVtx, (double)Mixcharge};
-
-              if(fReduceStatsCent > 0) {
-                if(cbin == fReduceStatsCent) fhnMixedEvents->Fill(triggerEntries,1./(nMix*mixefficiency));
-              } else fhnMixedEvents->Fill(triggerEntries,1./(nMix*mixefficiency));   // fill Sparse histo of mixed events
-
-            } // end of background track loop
-          } // end of filling mixed-event histo's:  jth mix event loop
+          // calculate single particle tracking efficiency of mixed events for correlations (-999)
+          double mixefficiency = 1.0;
+          //FIXME mixefficiency = EffCorrection(part->Eta(), part->Pt(), fDoEffCorr);                           
+
+          // select which jet pt to use for filling
+          double Mixjetptselected;
+          if(fCorrJetPt) { Mixjetptselected = Mixcorrjetpt;
+          } else { Mixjetptselected = Mixjetpt; }
+
+          // register jet with the mixing kernel: track pt, deta, dphi and charge are set per pool track
+          double triggerEntries[8] = {centbin*5.0, Mixjetptselected, 0., 0., 0., dMixEP, zVtx, 0.};
+          if((fReduceStatsCent <= 0) || (cbin == fReduceStatsCent)) fMixer->AddJet(triggerEntries, MixjetEta, MixjetPhi, 1./(nMix*mixefficiency));
         } // end of check for biased jet triggers
       } // end of jet loop
+
+      // Fill mixed-event histos here: loop over nMix events, each pool event is paired with all jets
+      if(fMixer->GetNumberOfJets() > 0) {
+        for(int jMix = 0; jMix < nMix; jMix++) {
+          // get jMix'th mixed event (quantized pools: decoded in the kernel)
+          const int iMix = fMixEvents[jMix];
+          if(pool->IsQuantized()) {
+            const Int_t Nbgtrks = pool->GetEventTracks(iMix, bgQPt, bgQEta, bgQPhi, bgCharge);
+            fMixer->FillEvent(Nbgtrks, bgQPt, bgQEta, bgQPhi, bgCharge, StEventPool::fgQuantRange);
+          } else {
+            const Int_t Nbgtrks = pool->GetEventTracks(iMix, bgPt, bgEta, bgPhi, bgCharge);
+            fMixer->FillEvent(Nbgtrks, bgPt, bgEta, bgPhi, bgCharge);
+          }
+        } // end of jth mix event loop
+      }
     } // end of check for pool being ready
   } // end EMC triggered loop
 
@@ -1445,7 +1439,7 @@ Int_t StMyAnalysisMaker3::Make() {
 
       // create a list of reduced objects. This speeds up processing and reduces memory consumption for the event pool
       // update pool if jet in event or not
-      pool->UpdatePool(CloneAndReduceTrackList());
+      UpdatePoolWithReducedTracks(pool);
 
       // fill QA histo's
       hMixEvtStatZVtx->Fill(zVtx);
@@ -1743,6 +1737,62 @@ TClonesArray* StMyAnalysisMaker3::CloneAndReduceTrackList()
   return tracksClone;
 }
 
+//_________________________________________________
+// Fill the pool with the accepted tracks of the event as contiguous float arrays
+Int_t StMyAnalysisMaker3::UpdatePoolWithReducedTracks(StEventPool *pool)
+{
+  // reuse buffers, no per-track objects
+  fMixTrackPt.clear(); fMixTrackEta.clear(); fMixTrackPhi.clear(); fMixTrackCharge.clear();
+
+  // construct variables, get # of tracks
+  int nMixTracks = mPicoDst->numberOfTracks();
+
+  // loop over tracks
+  for(int i = 0; i < nMixTracks; i++) {
+    StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(i));
+    if(!trk){ continue; }
+
+    // acceptance and kinematic quality cuts
+    if(!AcceptTrack(trk, Bfield, mVertex)) { continue; }
+
+    // primary track switch
+    // get momentum vector of track - global or primary track
+    StThreeVectorF mTrkMom;
+    if(doUsePrimTracks) {
+      if(!(trk->isPrimary())) continue; // check if primary
+      // get primary track vector
+      mTrkMom = trk->pMom();
+    } else {
+      // get global track vector
+      mTrkMom = trk->gMom(mVertex, Bfield);
+    }
+
+    // track variables
+    double pt = mTrkMom.perp();
+
+    // this is TEMP, it will filter track by the pt bin used for analysis
+    if(doTPCptassocBin && fDoFilterPtMixEvents) {
+      if(fTPCptAssocBin == 0) { if((pt > 0.25) && (pt <= 0.5)) continue; }  // 0.25 - 0.5 GeV assoc bin used for correlations
+      if(fTPCptAssocBin == 1) { if((pt > 0.50) && (pt <= 1.0)) continue; }  // 0.50 - 1.0 GeV assoc bin used for correlations
+      if(fTPCptAssocBin == 2) { if((pt > 1.00) && (pt <= 1.5)) continue; }  // 1.00 - 1.5 GeV assoc bin used for correlations
+      if(fTPCptAssocBin == 3) { if((pt > 1.50) && (pt <= 2.0)) continue; }  // 1.50 - 2.0 GeV assoc bin used for correlations
+      if(fTPCptAssocBin == 4) { if((pt > 2.00) && (pt <= 20.)) continue; }  // 2.00 - MAX GeV assoc bin used for correlations
+      if(fTPCptAssocBin == 5) { if((pt > 2.00) && (pt <= 3.0)) continue; }  // 2.00 - 3.0 GeV assoc bin used for correlations
+      if(fTPCptAssocBin == 6) { if((pt > 3.00) && (pt <= 4.0)) continue; }  // 3.00 - 4.0 GeV assoc bin used for correlations
+      if(fTPCptAssocBin == 7) { if((pt > 4.00) && (pt <= 5.0)) continue; }  // 4.00 - 5.0 GeV assoc bin used for correlations
+    }
+
+    fMixTrackPt.push_back(pt);
+    fMixTrackEta.push_back(mTrkMom.pseudoRapidity());
+    fMixTrackPhi.push_back(mTrkMom.phi());
+    fMixTrackCharge.push_back((Char_t)trk->charge());
+  } // end of looping through tracks
+
+  Int_t nAccTracks = fMixTrackPt.size();
+  if(nAccTracks == 0) return pool->UpdatePool(0, 0, 0, 0, 0);
+  return pool->UpdatePool(nAccTracks, &fMixTrackPt[0], &fMixTrackEta[0], &fMixTrackPhi[0], &fMixTrackCharge[0]);
+}
+
 /*
 //________________________________________________________________________
 Bool_t StMyAnalysisMaker3::AcceptJet(StJet *jet) { // for jets
@@ -1823,88 +1873,11 @@ TH1* StMyAnalysisMaker3::FillEmcTriggersHist(TH1* h) {
 //_____________________________________________________________________________
 // Trigger QA histogram, label bins 
 TH1* StMyAnalysisMaker3::FillEventTriggerQA(TH1* h) {
-  // check and fill a Event Selection QA histogram for different trigger selections after cuts
-
-  // Run14 AuAu 200 GeV
-  if(fRunFlag == StJetFrameworkPicoBase::Run14_AuAu200) {
-    int arrBHT1[] = {450201, 450211, 460201};
-    int arrBHT2[] = {450202, 450212, 460202, 460212};
-    int arrBHT3[] = {460203, 450213, 460203};
-    int arrMB[] = {450014};
-    int arrMB30[] = {450010, 450020};
-    int arrCentral5[] = {450010, 450020};
-    int arrCentral[] = {460101, 460111};
-    int arrMB5[] = {450005, 450008, 450009, 450014, 450015, 450018, 450024, 450025, 450050, 450060};
-
-    int bin = 0;
-    if(DoComparison(arrBHT1, sizeof(arrBHT1)/sizeof(*arrBHT1))) { bin = 2; h->Fill(bin); } // HT1
-    if(DoComparison(arrBHT2, sizeof(arrBHT2)/sizeof(*arrBHT2))) { bin = 3; h->Fill(bin); } // HT2
-    if(DoComparison(arrBHT3, sizeof(arrBHT3)/sizeof(*arrBHT3))) { bin = 4; h->Fill(bin); } // HT3 
-    if(DoComparison(arrMB, sizeof(arrMB)/sizeof(*arrMB))) { bin = 5; h->Fill(bin); } // MB 
-    //if() { bin = 6; h->Fill(bin); } 
-    if(DoComparison(arrCentral5, sizeof(arrCentral5)/sizeof(*arrCentral5))) { bin = 7; h->Fill(bin); }// Central-5
-    if(DoComparison(arrCentral, sizeof(arrCentral)/sizeof(*arrCentral))) { bin = 8; h->Fill(bin); } // Central & Central-mon
-    if(DoComparison(arrMB5, sizeof(arrMB5)/sizeof(*arrMB5))) { bin = 10; h->Fill(bin); }// VPDMB-5 
-    if(DoComparison(arrMB30, sizeof(arrMB30)/sizeof(*arrMB30))) { bin = 11; h->Fill(bin); } // VPDMB-30
- 
-    // label bins of the analysis trigger selection summary
-    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
-    h->GetXaxis()->SetBinLabel(2, "BHT1*VPDMB-30");
-    h->GetXaxis()->SetBinLabel(3, "BHT2*VPDMB-30");
-    h->GetXaxis()->SetBinLabel(4, "BHT3");
-    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-nobsmd");
-    h->GetXaxis()->SetBinLabel(6, "");
-    h->GetXaxis()->SetBinLabel(7, "Central-5");
-    h->GetXaxis()->SetBinLabel(8, "Central or Central-mon");
-    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
-    h->GetXaxis()->SetBinLabel(11, "VPDMB-30");
-  }
+  // check and fill a Event Selection QA histogram for different trigger selections:
+  // trigger bits of the event, decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, fRunFlag);
+  StPicoTriggerDecoder::FillEventTriggerQA(h, mask, fRunFlag);
 
-  // Run16 AuAu
-  if(fRunFlag == StJetFrameworkPicoBase::Run16_AuAu200) {
-    int bin = 0;
-
-    // hard-coded trigger Ids for run16
-    //int arrBHT0[] = {520606, 520616, 520626, 520636, 520646, 520656};
-    int arrBHT1[] = {520201, 520211, 520221, 520231, 520241, 520251, 520261, 520605, 520615, 520625, 520635, 520645, 520655, 550201, 560201, 560202, 530201, 540201};
-    int arrBHT2[] = {530202, 540203};
-    int arrBHT3[] = {520203, 530213};
-    int arrMB[] = {520021};
-    int arrMB5[] = {520001, 520002, 520003, 520011, 520012, 520013, 520021, 520022, 520023, 520031, 520033, 520041, 520042, 520043, 520051, 520822, 520832, 520842, 570702};
-    int arrMB10[] = {520007, 520017, 520027, 520037, 520201, 520211, 520221, 520231, 520241, 520251, 520261, 520601, 520611, 520621, 520631, 520641};
-    int arrCentral[] = {520101, 520111, 520121, 520131, 520141, 520103, 520113, 520123};
-
-    // fill for kAny
-    bin = 1; h->Fill(bin);
-
-    // check if event triggers meet certain criteria and fill histos
-    if(DoComparison(arrBHT1, sizeof(arrBHT1)/sizeof(*arrBHT1))) { bin = 2; h->Fill(bin); } // HT1
-    if(DoComparison(arrBHT2, sizeof(arrBHT2)/sizeof(*arrBHT2))) { bin = 3; h->Fill(bin); } // HT2
-    if(DoComparison(arrBHT3, sizeof(arrBHT3)/sizeof(*arrBHT3))) { bin = 4; h->Fill(bin); } // HT3
-    if(DoComparison(arrMB, sizeof(arrMB)/sizeof(*arrMB))) { bin = 5; h->Fill(bin); }  // MB
-    //if(mytriggers[i] == 999999) { bin = 6; h->Fill(bin); }
-    if(DoComparison(arrCentral, sizeof(arrCentral)/sizeof(*arrCentral))) { bin = 7; h->Fill(bin); }// Central-5 & Central-novtx
-    //if(mytriggers[i] == 999999) { bin = 8; h->Fill(bin); } 
-    if(DoComparison(arrMB5, sizeof(arrMB5)/sizeof(*arrMB5))) { bin = 10; h->Fill(bin); } // VPDMB-5 
-    if(DoComparison(arrMB10, sizeof(arrMB10)/sizeof(*arrMB10))) { bin = 11; h->Fill(bin); }// VPDMB-10
-
-    // label bins of the analysis trigger selection summary
-    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
-    h->GetXaxis()->SetBinLabel(2, "BHT1");
-    h->GetXaxis()->SetBinLabel(3, "BHT2");
-    h->GetXaxis()->SetBinLabel(4, "BHT3");
-    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-p-sst");
-    h->GetXaxis()->SetBinLabel(6, "");
-    h->GetXaxis()->SetBinLabel(7, "Central");
-    h->GetXaxis()->SetBinLabel(8, "");
-    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
-    h->GetXaxis()->SetBinLabel(11, "VPDMB-10");
-  }
-
-  // set x-axis labels vertically
-  h->LabelsOption("v");
-  //h->LabelsDeflate("X");
-  
   return h;
 }
 
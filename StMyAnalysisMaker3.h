@@ -4,6 +4,7 @@
 #include "StMaker.h"
 #include "StRoot/StPicoEvent/StPicoEvent.h"
 #include "StJetFrameworkPicoBase.h"
+#include <vector>
 class StJetFrameworkPicoBase;
 
 // ROOT classes
@@ -31,6 +32,9 @@ class StJet;
 class StRho;
 class StRhoParameter;
 class StEventPoolManager;
+class StEventPool;
+class StJetHadronMixer;
+class TRandom3;
 //class StEventPlaneMaker;
 
 //class StMyAnalysisMaker3 : public StMaker {
@@ -124,6 +128,12 @@ class StMyAnalysisMaker3 : public StJetFrameworkPicoBase {
     virtual void            SetCentBinSize(Int_t centbins)     { fCentBinSize = centbins; }
     virtual void            SetReduceStatsCent(Int_t red)      { fReduceStatsCent = red; }
     virtual void            SetDoFilterPtMixEvents(Int_t fil)  { fDoFilterPtMixEvents = fil; }
+    virtual void            SetPoolSnapshotInput(const char *f, Bool_t lock = kTRUE) { fPoolSnapshotIn = f; fPoolSnapshotLock = lock; } // pre-filled pools, memory mapped at Init
+    virtual void            SetPoolSnapshotOutput(const char *f) { fPoolSnapshotOut = f; } // export filled pools at Finish
+    virtual void            SetPoolMemoryBudget(Long64_t bytes)  { fPoolMemoryBudget = bytes; } // track memory of all pools, shared by demand (0: no limit)
+    virtual void            SetPoolQuantized(Bool_t q)           { fPoolQuantized = q; } // 16 bit pt, eta, phi in the pools
+    virtual void            SetMixSampling(Int_t nev, Int_t ntrk = 0) { fMixSampleEvents = nev; fMixSampleTracks = ntrk; } // pool events / track budget mixed per trigger event (0: whole pool)
+    virtual void            SetMixSeed(UInt_t seed)              { fMixSeed = seed; } // sampled mixing: random stream seeded per run / event id
 
     // event selection - setters
     virtual void            SetEmcTriggerEventType(UInt_t te)  { fEmcTriggerEventType = te; }
@@ -206,6 +216,14 @@ class StMyAnalysisMaker3 : public StJetFrameworkPicoBase {
     Int_t          fCentBinSize;                // centrality bin size of mixed event pools
     Int_t          fReduceStatsCent;            // bins to use for reduced statistics of sparse
     Bool_t         fDoFilterPtMixEvents;        // filter mixed event pool by pt (reduce memory) switch
+    TString        fPoolSnapshotIn;             // pool snapshot to import (StEventPoolManager::ReadPoolSnapshot)
+    TString        fPoolSnapshotOut;            // pool snapshot to export (StEventPoolManager::WritePoolSnapshot)
+    Bool_t         fPoolSnapshotLock;           // imported pools are locked (not updated, shared read-only)
+    Long64_t       fPoolMemoryBudget;           // memory budget of the event pools in bytes (0: no limit)
+    Bool_t         fPoolQuantized;              // quantized (16 bit) track storage of the event pools
+    Int_t          fMixSampleEvents;            // sampled mixing: MAX # of pool events per trigger event (0: all)
+    Int_t          fMixSampleTracks;            // sampled mixing: track budget per trigger event (0: no budget)
+    UInt_t         fMixSeed;                    // sampled mixing: seed of the random stream
 
     // event selection types
     UInt_t         fEmcTriggerEventType;        // Physics selection of event used for signal
@@ -256,7 +274,12 @@ class StMyAnalysisMaker3 : public StJetFrameworkPicoBase {
 
     // event pool
     TClonesArray          *CloneAndReduceTrackList();
+    Int_t                  UpdatePoolWithReducedTracks(StEventPool *pool);
     StEventPoolManager    *fPoolMgr;//!  // event pool Manager object
+    std::vector<Float_t>   fMixTrackPt;//!     // reduced tracks of current event for pool update
+    std::vector<Float_t>   fMixTrackEta;//!
+    std::vector<Float_t>   fMixTrackPhi;//!
+    std::vector<Char_t>    fMixTrackCharge;//!
 
   private:
     Int_t                  fRunNumber;
@@ -361,6 +384,9 @@ class StMyAnalysisMaker3 : public StJetFrameworkPicoBase {
     // THn Sparse's jet sparse
     THnSparse             *fhnJH;//!           // jet hadron events matrix
     THnSparse             *fhnMixedEvents;//!  // mixed events matrix
+    StJetHadronMixer      *fMixer;//!          // mixed-event kernel filling fhnMixedEvents
+    TRandom3              *fMixRandom;//!      // random stream of sampled mixing
+    std::vector<Int_t>     fMixEvents;//!      // pool events mixed with the current event
     THnSparse             *fhnCorr;//!         // sparse to get # jet triggers
 
     // maker names
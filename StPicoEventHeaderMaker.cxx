@@ -0,0 +1,235 @@
+// ################################################################
+// Author:  Joel Mazer for the STAR Collaboration
+// Affiliation: Rutgers University
+//
+// shared per-event header
+//      - vertex, B field, run/fill/event ID's and coincidence rates
+//      - centrality correction (StRefMultCorr) done once per event
+//      - event weight and trigger mask
+//      - common event selection for all downstream makers
+//
+// ################################################################
+// $Id$
+
+#include "StPicoEventHeaderMaker.h"
+
+// STAR includes
+#include "StRoot/StPicoDstMaker/StPicoDst.h"
+#include "StRoot/StPicoDstMaker/StPicoDstMaker.h"
+#include "StRoot/StPicoEvent/StPicoEvent.h"
+
+// centrality includes
+#include "StRoot/StRefMultCorr/StRefMultCorr.h"
+#include "StRoot/StRefMultCorr/CentralityMaker.h"
+
+// jet-framework includes
+#include "StJetFrameworkPicoBase.h"
+#include "StPicoTriggerDecoder.h"
+
+ClassImp(StPicoEventHeaderMaker)
+
+//________________________________________________________________________
+StPicoEventHeaderMaker::StPicoEventHeaderMaker(const char *name) :
+  StMaker(name),
+  fDebugLevel(0),
+  fRunFlag(0),       // see StJetFrameworkPicoBase::fRunFlagEnum
+  fCentralityDef(4), // see StJetFrameworkPicoBase::fCentralityDefEnum
+  doUseBBCCoincidenceRate(kTRUE),
+  fEventZVtxMinCut(-40.0),
+  fEventZVtxMaxCut(40.0),
+  fRejectNoCentrality(kTRUE),
+  fTriggerToUse(0),        // kTriggerAny, see StJetFrameworkPicoBase::fTriggerEventTypeEnum
+  fMBEventType(2),         // kVPDMB5, see StJetFrameworkPicoBase::fMBFlagEnum
+  fEmcTriggerEventType(0), // see StJetFrameworkPicoBase::fEmcTriggerFlagEnum
+  fNEvents(0),
+  fNEventsSelected(0),
+  mPicoDstMaker(0x0),
+  mPicoDst(0x0),
+  mPicoEvent(0x0),
+  grefmultCorr(0x0)
+{
+  // Standard constructor.
+  ResetEventRecord();
+}
+
+//________________________________________________________________________
+StPicoEventHeaderMaker::~StPicoEventHeaderMaker()
+{
+  // Destructor
+}
+
+//________________________________________________________________________
+Int_t StPicoEventHeaderMaker::Init() {
+  // initialize centrality correction
+  // switch on Run Flag to look for firing trigger specifically requested for given run period
+  switch(fRunFlag) {
+    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
+        // this is the default for Run14
+        grefmultCorr = CentralityMaker::instance()->getgRefMultCorr();
+        break;
+
+    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
+        switch(fCentralityDef) {
+          case StJetFrameworkPicoBase::kgrefmult :
+              grefmultCorr = CentralityMaker::instance()->getgRefMultCorr();
+              break;
+          case StJetFrameworkPicoBase::kgrefmult_P16id :
+              grefmultCorr = CentralityMaker::instance()->getgRefMultCorr_P16id();
+              break;
+          case StJetFrameworkPicoBase::kgrefmult_VpdMBnoVtx :
+              grefmultCorr = CentralityMaker::instance()->getgRefMultCorr_VpdMBnoVtx();
+              break;
+          case StJetFrameworkPicoBase::kgrefmult_VpdMB30 :
+              grefmultCorr = CentralityMaker::instance()->getgRefMultCorr_VpdMB30();
+              break;
+          default:
+              grefmultCorr = CentralityMaker::instance()->getgRefMultCorr_P16id();
+        }
+        break;
+
+    default :
+        grefmultCorr = CentralityMaker::instance()->getgRefMultCorr();
+  }
+
+  return kStOK;
+}
+
+//________________________________________________________________________
+Int_t StPicoEventHeaderMaker::Finish() {
+  cout<<"StPicoEventHeaderMaker::Finish(): "<<fNEventsSelected<<" of "<<fNEvents<<" events selected"<<endl;
+
+  return kStOK;
+}
+
+//________________________________________________________________________
+void StPicoEventHeaderMaker::Clear(Option_t *opt) {
+  ResetEventRecord();
+}
+
+//________________________________________________________________________
+void StPicoEventHeaderMaker::ResetEventRecord() {
+  // an event without record is rejected
+  fEvent.fRunId = -1;
+  fEvent.fFillId = -1;
+  fEvent.fEventId = -1;
+  fEvent.fBField = 0.;
+  fEvent.fVertex = StThreeVectorF(0., 0., 0.);
+  fEvent.fZVtx = 0.;
+  fEvent.fBBCCoincidenceRate = 0.;
+  fEvent.fZDCCoincidenceRate = 0.;
+  fEvent.fGRefMult = 0;
+  fEvent.fRefMultCorr = 0.;
+  fEvent.fCent16 = -1;
+  fEvent.fCent9 = -1;
+  fEvent.fCentBin = -1;
+  fEvent.fCentBin9 = -1;
+  fEvent.fCentralityScaled = -5.0;
+  fEvent.fWeight = 1.0;
+  fEvent.fTriggerMask = 0;
+  fEvent.fRejection = kRejectNoEvent;
+}
+
+//________________________________________________________________________
+Int_t StPicoEventHeaderMaker::Make() {
+  ResetEventRecord();
+  fNEvents++;
+
+  // get PicoDstMaker
+  mPicoDstMaker = static_cast<StPicoDstMaker*>(GetMaker("picoDst"));
+  if(!mPicoDstMaker) {
+    LOG_WARN << " No PicoDstMaker! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // construct PicoDst object from maker
+  mPicoDst = static_cast<StPicoDst*>(mPicoDstMaker->picoDst());
+  if(!mPicoDst) {
+    LOG_WARN << " No PicoDst! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // create pointer to PicoEvent
+  mPicoEvent = static_cast<StPicoEvent*>(mPicoDst->event());
+  if(!mPicoEvent) {
+    LOG_WARN << " No PicoEvent! Skip! " << endm;
+    return kStWarn;
+  }
+  fEvent.fRejection = kRejectNone;
+
+  // event ID's, B (magnetic) field and vertex
+  fEvent.fRunId = mPicoEvent->runId();
+  fEvent.fFillId = mPicoEvent->fillId();
+  fEvent.fEventId = mPicoEvent->eventId();
+  fEvent.fBField = mPicoEvent->bField();
+  fEvent.fVertex = mPicoEvent->primaryVertex();
+  fEvent.fZVtx = fEvent.fVertex.z();
+  fEvent.fBBCCoincidenceRate = mPicoEvent->BBCx();
+  fEvent.fZDCCoincidenceRate = mPicoEvent->ZDCx();
+
+  // Z-vertex cut - per the Aj analysis (-40, 40)
+  if((fEvent.fZVtx < fEventZVtxMinCut) || (fEvent.fZVtx > fEventZVtxMaxCut)) fEvent.fRejection |= kRejectZVtx;
+
+  // ============================ CENTRALITY ============================== //
+  // done once per event here: init() and initEvent() are expensive
+  // 10 14 21 29 40 54 71 92 116 145 179 218 263 315 373 441  // RUN 14 AuAu binning
+  double coincidenceRate = (doUseBBCCoincidenceRate) ? fEvent.fBBCCoincidenceRate : fEvent.fZDCCoincidenceRate;
+  fEvent.fGRefMult = mPicoEvent->grefMult();
+  grefmultCorr->init(fEvent.fRunId);
+  grefmultCorr->initEvent(fEvent.fGRefMult, fEvent.fZVtx, coincidenceRate);
+  fEvent.fRefMultCorr = grefmultCorr->getRefMultCorr(fEvent.fGRefMult, fEvent.fZVtx, coincidenceRate, 2);
+  fEvent.fCent16 = grefmultCorr->getCentralityBin16();
+  fEvent.fCent9 = grefmultCorr->getCentralityBin9();
+  fEvent.fCentBin = GetCentBin(fEvent.fCent16, 16);
+  fEvent.fCentBin9 = GetCentBin(fEvent.fCent9, 9);
+  fEvent.fCentralityScaled = fEvent.fCentBin*5.0;
+  fEvent.fWeight = grefmultCorr->getWeight();
+
+  // lowest multiplicity events 80%+ centrality
+  if(fRejectNoCentrality && (fEvent.fCent16 == -1)) fEvent.fRejection |= kRejectCentrality;
+
+  // ============================ TRIGGER ================================= //
+  StPicoTriggerDecoder *mTrigger = StPicoTriggerDecoder::Instance();
+  fEvent.fTriggerMask = mTrigger->Decode(mPicoDst, fRunFlag);
+  if((fTriggerToUse == StJetFrameworkPicoBase::kTriggerMB) &&
+     !(fEvent.fTriggerMask & StPicoTriggerDecoder::GetMBBit(fRunFlag, fMBEventType))) fEvent.fRejection |= kRejectTrigger;
+  if((fTriggerToUse == StJetFrameworkPicoBase::kTriggerHT) &&
+     !(fEvent.fTriggerMask & StPicoTriggerDecoder::GetHTBit(fRunFlag, fEmcTriggerEventType))) fEvent.fRejection |= kRejectTrigger;
+
+  if(IsEventSelected()) fNEventsSelected++;
+
+  if(fDebugLevel > 0) {
+    cout<<"StPicoEventHeaderMaker: RunID = "<<fEvent.fRunId<<"  eventID = "<<fEvent.fEventId<<"  zVtx = "<<fEvent.fZVtx;
+    cout<<"  cent16 = "<<fEvent.fCent16<<"  refCorr2 = "<<fEvent.fRefMultCorr<<"  triggers = "<<fEvent.fTriggerMask;
+    cout<<"  rejection = "<<fEvent.fRejection<<endl;
+  }
+
+  return kStOK;
+}
+
+//________________________________________________________________________
+Int_t StPicoEventHeaderMaker::GetCentBin(Int_t cent, Int_t nBin) const
+{
+  // Get centrality bin: same as StJetFrameworkPicoBase::GetCentBin()
+  Int_t centbin = -1;
+
+  if(nBin == 16) { centbin = nBin - 1 - cent; }
+  if(nBin == 9)  { centbin = nBin - 1 - cent; }
+
+  return centbin;
+}
+
+//________________________________________________________________________
+const char* StPicoEventHeaderMaker::CompareSettings(Int_t runFlag, Int_t centDef, Bool_t useBBC, Double_t zmin, Double_t zmax,
+    UInt_t triggerToUse, UInt_t mbEventType, UInt_t emcTriggerEventType) const
+{
+  // Compare the settings of a downstream maker with the header: returns 0 if
+  // the header centrality and event selection can be used by the maker,
+  // otherwise the name of the first setting that differs
+  if((runFlag != fRunFlag) || (centDef != fCentralityDef) || (useBBC != doUseBBCCoincidenceRate)) return "centrality";
+  if((zmin != fEventZVtxMinCut) || (zmax != fEventZVtxMaxCut)) return "z-vertex range";
+  if(triggerToUse != fTriggerToUse) return "trigger";
+  if((triggerToUse == StJetFrameworkPicoBase::kTriggerMB) && (mbEventType != fMBEventType)) return "MB event type";
+  if((triggerToUse == StJetFrameworkPicoBase::kTriggerHT) && (emcTriggerEventType != fEmcTriggerEventType)) return "HT event type";
+
+  return 0;
+}
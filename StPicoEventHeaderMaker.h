@@ -0,0 +1,140 @@
+#ifndef STPICOEVENTHEADERMAKER_H
+#define STPICOEVENTHEADERMAKER_H
+
+// $Id$
+//
+// Per-event header shared by all makers.
+//
+// Runs once per event at the head of the chain (after the PicoDstMaker):
+// vertex, B field, run/fill/event ID's, coincidence rates, the corrected
+// multiplicity and centrality (StRefMultCorr init/initEvent done once),
+// the event weight and the trigger mask are kept in one event record.
+// The common event selection (z-vertex, 80-100% centrality, trigger) is
+// also done here once.
+//
+// Downstream makers look the header up with GetMaker() and read the
+// record, instead of repeating the centrality correction every event:
+//   if(!header->IsEventSelected()) return kStOk;      // rejected for whole chain
+//   const StPicoEventHeaderMaker::StEventRecord &evt = header->GetEventRecord();
+//   ... evt.fCent16, evt.fRefMultCorr, evt.fWeight ...
+// Analysis specific cuts (e.g. centrality bin selection) stay in the makers.
+// A maker only uses the header if its centrality and event selection
+// settings are the same (CompareSettings()), otherwise it does its own.
+
+#include "StMaker.h"
+#include "StThreeVectorF.hh"
+
+// STAR classes
+class StPicoDst;
+class StPicoDstMaker;
+class StPicoEvent;
+class StRefMultCorr;
+
+class StPicoEventHeaderMaker : public StMaker {
+ public:
+  // reason(s) an event was rejected
+  enum EEventRejection {
+    kRejectNone       = 0,
+    kRejectNoEvent    = 1<<0,   // no PicoDst / PicoEvent
+    kRejectZVtx       = 1<<1,   // outside z-vertex range
+    kRejectCentrality = 1<<2,   // no centrality bin: 80-100% (cent16 = -1)
+    kRejectTrigger    = 1<<3    // requested trigger did not fire
+  };
+
+  // event record: filled once per event by Make(), read only for other makers
+  struct StEventRecord {
+    Int_t                fRunId;           // run ID
+    Int_t                fFillId;          // fill ID
+    Int_t                fEventId;         // event ID
+    Double_t             fBField;          // B (magnetic) field
+    StThreeVectorF       fVertex;          // primary vertex
+    Double_t             fZVtx;            // z-vertex component
+    Double_t             fBBCCoincidenceRate; // BBC coincidence rate
+    Double_t             fZDCCoincidenceRate; // ZDC coincidence rate
+    Int_t                fGRefMult;        // grefMult
+    Double_t             fRefMultCorr;     // corrected grefMult
+    Int_t                fCent16;          // StRefMultCorr 16 bin centrality (-1 = 80-100%)
+    Int_t                fCent9;           // StRefMultCorr 9 bin centrality
+    Int_t                fCentBin;         // 16 bin centrality, 0 = 0-5% (see GetCentBin)
+    Int_t                fCentBin9;        // 9 bin centrality, 0 = 0-5%
+    Double_t             fCentralityScaled;// centrality in %: fCentBin*5
+    Double_t             fWeight;          // StRefMultCorr event weight
+    UInt_t               fTriggerMask;     // trigger bits, see StPicoTriggerDecoder
+    UInt_t               fRejection;       // rejection bits, see EEventRejection
+  };
+
+  StPicoEventHeaderMaker(const char *name = "EventHeader");
+  virtual ~StPicoEventHeaderMaker();
+
+  // class required functions
+  virtual Int_t Init();
+  virtual Int_t Make();
+  virtual void  Clear(Option_t *opt="");
+  virtual Int_t Finish();
+
+  // switches
+  virtual void            SetRunFlag(Int_t f)               { fRunFlag        = f; }
+  virtual void            SetCentralityDef(Int_t c)         { fCentralityDef  = c; }
+  virtual void            SetUseBBCCoincidenceRate(Bool_t b){ doUseBBCCoincidenceRate = b; }
+  virtual void            SetDebugLevel(Int_t l)            { fDebugLevel     = l; }
+
+  // event selection
+  virtual void            SetEventZVtxRange(Double_t zmi, Double_t zma) { fEventZVtxMinCut = zmi; fEventZVtxMaxCut = zma; }
+  virtual void            SetRejectNoCentrality(Bool_t r)   { fRejectNoCentrality = r; }
+  virtual void            SetTriggerToUse(UInt_t ttu)       { fTriggerToUse   = ttu; }
+  virtual void            SetMBEventType(UInt_t mbe)        { fMBEventType    = mbe; }
+  virtual void            SetEmcTriggerEventType(UInt_t te) { fEmcTriggerEventType = te; }
+
+  Int_t                   GetRunFlag() const                { return fRunFlag; }
+  Int_t                   GetCentralityDef() const          { return fCentralityDef; }
+  Bool_t                  GetUseBBCCoincidenceRate() const  { return doUseBBCCoincidenceRate; }
+  Double_t                GetEventZVtxMinCut() const        { return fEventZVtxMinCut; }
+  Double_t                GetEventZVtxMaxCut() const        { return fEventZVtxMaxCut; }
+  UInt_t                  GetTriggerToUse() const           { return fTriggerToUse; }
+  UInt_t                  GetMBEventType() const            { return fMBEventType; }
+  UInt_t                  GetEmcTriggerEventType() const    { return fEmcTriggerEventType; }
+  const char*             CompareSettings(Int_t runFlag, Int_t centDef, Bool_t useBBC, Double_t zmin, Double_t zmax,
+                            UInt_t triggerToUse, UInt_t mbEventType, UInt_t emcTriggerEventType) const;
+
+  // event
+  const StEventRecord&    GetEventRecord() const            { return fEvent; }
+  Bool_t                  IsEventSelected() const           { return (fEvent.fRejection == kRejectNone); }
+  UInt_t                  GetRejection() const              { return fEvent.fRejection; }
+
+ protected:
+  void                    ResetEventRecord();
+  Int_t                   GetCentBin(Int_t cent, Int_t nBin) const;
+
+  // switches
+  Int_t                   fDebugLevel;             // debug printout level
+  Int_t                   fRunFlag;                // Run Flag enumerator value
+  Int_t                   fCentralityDef;          // Centrality Definition enumerator value
+  Bool_t                  doUseBBCCoincidenceRate; // use BBC or ZDC Coincidence Rate, kFALSE = ZDC
+
+  // event selection
+  Double_t                fEventZVtxMinCut;        // min event z-vertex cut
+  Double_t                fEventZVtxMaxCut;        // max event z-vertex cut
+  Bool_t                  fRejectNoCentrality;     // reject events without centrality bin (80-100%)
+  UInt_t                  fTriggerToUse;           // trigger to select events on (kTriggerANY = none)
+  UInt_t                  fMBEventType;            // MB selection
+  UInt_t                  fEmcTriggerEventType;    // HT selection
+
+  // event
+  StEventRecord           fEvent;                  // current event record
+
+  // counters
+  Int_t                   fNEvents;                // events seen
+  Int_t                   fNEventsSelected;        // events passing selection
+
+ private:
+  StPicoDstMaker         *mPicoDstMaker;           // PicoDstMaker object
+  StPicoDst              *mPicoDst;                // PicoDst object
+  StPicoEvent            *mPicoEvent;              // PicoEvent object
+  StRefMultCorr          *grefmultCorr;            // centrality correction
+
+  StPicoEventHeaderMaker(const StPicoEventHeaderMaker&);            // not implemented
+  StPicoEventHeaderMaker &operator=(const StPicoEventHeaderMaker&); // not implemented
+
+  ClassDef(StPicoEventHeaderMaker, 1) // shared per-event header
+};
+#endif
@@ -51,6 +51,10 @@
 #include "StEmcUtil/geometry/StEmcGeom.h"
 //#include "StEmcUtil/others/emcDetectorName.h"
 #include "StEmcUtil/projection/StEmcPosition.h"
+#include "StEmcPositionCache.h"
+#include "StCorrectedTowerTable.h"
+#include "StJetMakerTask.h"
+#include "StPicoTriggerDecoder.h"
 #include "StEmcRawHit.h"
 #include "StEmcModule.h"
 #include "StEmcDetector.h"
@@ -93,6 +97,7 @@ StPicoTrackClusterQA::StPicoTrackClusterQA() :
   fAnalysisMakerName(""),
   fTracksName(""),
   fCaloName(""),
+  fJetMakerName(""),
   fTrackPtMinCut(0.2),
   fTrackPtMaxCut(20.0),
   fClusterPtMinCut(0.2),
@@ -127,6 +132,7 @@ StPicoTrackClusterQA::StPicoTrackClusterQA() :
   mTowerStatusMode(AcceptAllTowers),
   mTowerEnergyMin(0.2),
   mHadronicCorrFrac(1.0),
+  fTowerTable(0x0),
   mMuDstMaker(0x0),
   mMuDst(0x0),
   mMuInputEvent(0x0),
@@ -139,11 +145,6 @@ StPicoTrackClusterQA::StPicoTrackClusterQA() :
 {
   // Default constructor.
   for(int i=0; i<8; i++) { fEmcTriggerArr[i] = 0; }
-  for(int i=0; i<4801; i++) { 
-    fTowerToTriggerTypeHT1[i] = kFALSE;
-    fTowerToTriggerTypeHT2[i] = kFALSE;
-    fTowerToTriggerTypeHT3[i] = kFALSE; 
-  }
 }
 
 //________________________________________________________________________
@@ -165,6 +166,7 @@ StPicoTrackClusterQA::StPicoTrackClusterQA(const char *name, bool doHistos = kFA
   fAnalysisMakerName(name),
   fTracksName("Tracks"),
   fCaloName("Clusters"),
+  fJetMakerName(""),
   fTrackPtMinCut(0.2), //0.20
   fTrackPtMaxCut(20.0), 
   fClusterPtMinCut(0.2),
@@ -199,6 +201,7 @@ StPicoTrackClusterQA::StPicoTrackClusterQA(const char *name, bool doHistos = kFA
   mTowerStatusMode(AcceptAllTowers),
   mTowerEnergyMin(0.2),
   mHadronicCorrFrac(1.0),
+  fTowerTable(0x0),
   mMuDstMaker(0x0),
   mMuDst(0x0),
   mMuInputEvent(0x0),
@@ -214,11 +217,6 @@ StPicoTrackClusterQA::StPicoTrackClusterQA(const char *name, bool doHistos = kFA
   SetName(name);
 
   for(int i=0; i<8; i++) { fEmcTriggerArr[i] = 0; }
-  for(int i=0; i<4801; i++) { 
-    fTowerToTriggerTypeHT1[i] = kFALSE;
-    fTowerToTriggerTypeHT2[i] = kFALSE;
-    fTowerToTriggerTypeHT3[i] = kFALSE;
-  }
 }
 
 //________________________________________________________________________
@@ -227,6 +225,7 @@ StPicoTrackClusterQA::~StPicoTrackClusterQA()
   // free up histogram objects if they exist
 
   // Destructor
+  if(fTowerTable)       delete fTowerTable;
   if(fHistNTrackvsPt)   delete fHistNTrackvsPt;
   if(fHistNTrackvsPhi)  delete fHistNTrackvsPhi;
   if(fHistNTrackvsEta)  delete fHistNTrackvsEta;
@@ -673,8 +672,7 @@ void StPicoTrackClusterQA::RunQA()
   // get # of clusters and set variables
   unsigned int nclus = mPicoDst->numberOfBEmcPidTraits();
   StThreeVectorF  towPosition, clusPosition;
-  StEmcPosition *mPosition = new StEmcPosition();
-  StEmcPosition *mPosition2 = new StEmcPosition();
+  StEmcPositionCache *mPosition = StEmcPositionCache::Instance();
 
   // print EMCal cluster info
   if(fDebugLevel == 7) mPicoDst->printBEmcPidTraits();
@@ -698,8 +696,8 @@ void StPicoTrackClusterQA::RunQA()
     if(towID < 0) continue;
 
     // cluster and tower position - from vertex and ID
-    towPosition = mPosition->getPosFromVertex(mVertex, towID);
-    clusPosition = mPosition2->getPosFromVertex(mVertex, clusID);
+    towPosition = mPosition->GetPosFromVertex(mVertex, towID);
+    clusPosition = mPosition->GetPosFromVertex(mVertex, clusID);
 
     // index of associated track in the event
     int trackIndex = cluster->trackIndex();
@@ -954,7 +952,7 @@ Bool_t StPicoTrackClusterQA::AcceptTrack(StPicoTrack *trk, Float_t B, StThreeVec
 //________________________________________________________________________
 Bool_t StPicoTrackClusterQA::AcceptTower(StPicoBTowHit *tower) {
   // get EMCal position
-  StEmcPosition *mPosition = new StEmcPosition();
+  StEmcPositionCache *mPosition = StEmcPositionCache::Instance();
 
   // constants:
   double pi = 1.0*TMath::Pi();
@@ -966,7 +964,7 @@ Bool_t StPicoTrackClusterQA::AcceptTower(StPicoBTowHit *tower) {
   if(towerID < 0) return kFALSE;
 
   // cluster and tower position - from vertex and ID: shouldn't need additional eta correction
-  StThreeVectorF towerPosition = mPosition->getPosFromVertex(mVertex, towerID);
+  StThreeVectorF towerPosition = mPosition->GetPosFromVertex(mVertex, towerID);
   double phi = towerPosition.phi();
   if(phi < 0)    phi += 2.0*pi;
   if(phi > 2*pi) phi -= 2.0*pi;
@@ -1000,13 +998,8 @@ TH1* StPicoTrackClusterQA::FillEmcTriggersHist(TH1* h) {
   // set kAny true to use of 'all' triggers
   fEmcTriggerArr[StJetFrameworkPicoBase::kAny] = 1;  // always TRUE, so can select on all event (when needed/wanted) 
 
-  // tower - HT trigger types array
-  // zero these out - so they are refreshed for each event
-  for(int i = 0; i < 4801; i++) {
-    fTowerToTriggerTypeHT1[i] = kFALSE;
-    fTowerToTriggerTypeHT2[i] = kFALSE;
-    fTowerToTriggerTypeHT3[i] = kFALSE;
-  }
+  // tower - HT trigger types: decoded once per event by the shared trigger decoder
+  //   StPicoTriggerDecoder::Instance()->IsTowerHT1(towerID), etc
 
   // loop over valid EmcalTriggers
   for(int i = 0; i < nEmcTrigger; i++) {
@@ -1022,9 +1015,6 @@ TH1* StPicoTrackClusterQA::FillEmcTriggersHist(TH1* h) {
     bool isHT1 = emcTrig->isHT1();
     bool isHT2 = emcTrig->isHT2();
     bool isHT3 = emcTrig->isHT3();
-    if(isHT1) fTowerToTriggerTypeHT1[emcTrigID] = kTRUE;
-    if(isHT2) fTowerToTriggerTypeHT2[emcTrigID] = kTRUE;
-    if(isHT3) fTowerToTriggerTypeHT3[emcTrigID] = kTRUE;
 
 /*
     // print some EMCal Trigger info
@@ -1066,110 +1056,14 @@ TH1* StPicoTrackClusterQA::FillEmcTriggersHist(TH1* h) {
 //_____________________________________________________________________________
 // Trigger QA histogram, label bins 
 TH1* StPicoTrackClusterQA::FillEventTriggerQA(TH1* h) {
-  // check and fill a Event Selection QA histogram for different trigger selections after cuts
-
-  // Run14 AuAu 200 GeV
-  if(fRunFlag == StJetFrameworkPicoBase::Run14_AuAu200) {
-  // Run14 triggers:
-    int arrHT1[] = {450201, 450211, 460201};
-    int arrHT2[] = {450202, 450212, 460202, 460212};
-    int arrHT3[] = {450203, 450213, 460203};
-    int arrMB[] = {450014};
-    int arrMB30[] = {450010, 450020};
-    int arrCentral5[] = {450010, 450020};
-    int arrCentral[] = {460101, 460111};
-    int arrMB5[] = {450005, 450008, 450009, 450014, 450015, 450018, 450024, 450025, 450050, 450060};
-
-    int bin = 0;
-    if(DoComparison(arrHT1, sizeof(arrHT1)/sizeof(*arrHT1))) { bin = 2; h->Fill(bin); } // HT1
-    if(DoComparison(arrHT2, sizeof(arrHT2)/sizeof(*arrHT2))) { bin = 3; h->Fill(bin); } // HT2
-    if(DoComparison(arrHT3, sizeof(arrHT3)/sizeof(*arrHT3))) { bin = 4; h->Fill(bin); } // HT3 
-    if(DoComparison(arrMB, sizeof(arrMB)/sizeof(*arrMB))) { bin = 5; h->Fill(bin); } // MB 
-    //if() { bin = 6; h->Fill(bin); } 
-    if(DoComparison(arrCentral5, sizeof(arrCentral5)/sizeof(*arrCentral5))) { bin = 7; h->Fill(bin); }// Central-5
-    if(DoComparison(arrCentral, sizeof(arrCentral)/sizeof(*arrCentral))) { bin = 8; h->Fill(bin); } // Central & Central-mon
-    if(DoComparison(arrMB5, sizeof(arrMB5)/sizeof(*arrMB5))) { bin = 10; h->Fill(bin); }// VPDMB-5 
-    if(DoComparison(arrMB30, sizeof(arrMB30)/sizeof(*arrMB30))) { bin = 11; h->Fill(bin); } // VPDMB-30
-
-    // label bins of the analysis trigger selection summary
-    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
-    h->GetXaxis()->SetBinLabel(2, "BHT1*VPDMB-30");
-    h->GetXaxis()->SetBinLabel(3, "BHT2*VPDMB-30");
-    h->GetXaxis()->SetBinLabel(4, "BHT3");
-    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-nobsmd");
-    h->GetXaxis()->SetBinLabel(6, "");
-    h->GetXaxis()->SetBinLabel(7, "Central-5");
-    h->GetXaxis()->SetBinLabel(8, "Central or Central-mon");
-    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
-    h->GetXaxis()->SetBinLabel(11, "VPDMB-30");
-  }
-
-  // Run16 AuAu
-  if(fRunFlag == StJetFrameworkPicoBase::Run16_AuAu200) {
-    int bin = 0;
-
-    // hard-coded trigger Ids for run16
-    //int arrHT0[] = {520606, 520616, 520626, 520636, 520646, 520656};
-    int arrHT1[] = {520201, 520211, 520221, 520231, 520241, 520251, 520261, 520605, 520615, 520625, 520635, 520645, 520655, 550201, 560201, 560202, 530201, 540201};
-    int arrHT2[] = {530202, 540203};
-    int arrHT3[] = {520203, 530213};
-    int arrMB[] = {520021};
-    int arrMB5[] = {520001, 520002, 520003, 520011, 520012, 520013, 520021, 520022, 520023, 520031, 520033, 520041, 520042, 520043, 520051, 520822, 520832, 520842, 570702};
-    int arrMB10[] = {520007, 520017, 520027, 520037, 520201, 520211, 520221, 520231, 520241, 520251, 520261, 520601, 520611, 520621, 520631, 520641};
-    int arrCentral[] = {520101, 520111, 520121, 520131, 520141, 520103, 520113, 520123};
-
-    // fill for kAny
-    bin = 1; h->Fill(bin);
-
-    // check if event triggers meet certain criteria and fill histos
-    if(DoComparison(arrHT1, sizeof(arrHT1)/sizeof(*arrHT1))) { bin = 2; h->Fill(bin); } // HT1
-    if(DoComparison(arrHT2, sizeof(arrHT2)/sizeof(*arrHT2))) { bin = 3; h->Fill(bin); } // HT2
-    if(DoComparison(arrHT3, sizeof(arrHT3)/sizeof(*arrHT3))) { bin = 4; h->Fill(bin); } // HT3
-    if(DoComparison(arrMB, sizeof(arrMB)/sizeof(*arrMB))) { bin = 5; h->Fill(bin); }  // MB
-    //if(mytriggers[i] == 999999) { bin = 6; h->Fill(bin); }
-    if(DoComparison(arrCentral, sizeof(arrCentral)/sizeof(*arrCentral))) { bin = 7; h->Fill(bin); }// Central-5 & Central-novtx
-    //if(mytriggers[i] == 999999) { bin = 8; h->Fill(bin); } 
-    if(DoComparison(arrMB5, sizeof(arrMB5)/sizeof(*arrMB5))) { bin = 10; h->Fill(bin); } // VPDMB-5 
-    if(DoComparison(arrMB10, sizeof(arrMB10)/sizeof(*arrMB10))) { bin = 11; h->Fill(bin); }// VPDMB-10
-
-    // label bins of the analysis trigger selection summary
-    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
-    h->GetXaxis()->SetBinLabel(2, "BHT1");
-    h->GetXaxis()->SetBinLabel(3, "BHT2");
-    h->GetXaxis()->SetBinLabel(4, "BHT3");
-    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-p-sst");
-    h->GetXaxis()->SetBinLabel(6, "");
-    h->GetXaxis()->SetBinLabel(7, "Central");
-    h->GetXaxis()->SetBinLabel(8, "");
-    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
-    h->GetXaxis()->SetBinLabel(11, "VPDMB-10");
-  }
-
-  // set x-axis labels vertically
-  h->LabelsOption("v");
-  //h->LabelsDeflate("X");
+  // check and fill a Event Selection QA histogram for different trigger selections:
+  // trigger bits of the event, decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, fRunFlag);
+  StPicoTriggerDecoder::FillEventTriggerQA(h, mask, fRunFlag);
 
   return h;
 }
 
-// elems: sizeof(myarr)/sizeof(*myarr) prior to passing to function
-// upon passing the array collapses to a pointer and can not get size anymore
-//________________________________________________________________________
-Bool_t StPicoTrackClusterQA::DoComparison(int myarr[], int elems) {
-  //std::cout << "Length of array = " << (sizeof(myarr)/sizeof(*myarr)) << std::endl;
-  bool match = kFALSE;
-
-  // loop over specific physics selection array and compare to specific event trigger
-  for(int i=0; i<elems; i++) {
-    if(mPicoEvent->isTrigger(myarr[i])) match = kTRUE;
-    if(match) break;
-  }
-  //cout<<"elems: "<<elems<<"  match: "<<match<<endl;
-
-  return match;
-}
-
-
 //______________________________________________________________________
 THnSparse* StPicoTrackClusterQA::NewTHnSparseFTracks(const char* name, UInt_t entries) {
   // generate new THnSparseD, axes are defined in GetDimParamsD()
@@ -1477,60 +1371,55 @@ Int_t StPicoTrackClusterQA::MuFindSMDClusterHits(StEmcCollection* coll, Double_t
 }
 
 //________________________________________________________________________
-void StPicoTrackClusterQA::RunTowerTest()
+void StPicoTrackClusterQA::FillTowerTable()
 {
   // set / initialize some variables
-  double pi = 1.0*TMath::Pi();
   double pi0mass = Pico::mMass[0]; // GeV
-  StEmcPosition *mPosition = new StEmcPosition();
+  StEmcPositionCache *mPosition = StEmcPositionCache::Instance();
+
+  // local corrected tower table: start new event
+  if(!fTowerTable) fTowerTable = new StCorrectedTowerTable();
+  fTowerTable->Reset();
+
+  // loop over towers and add fired towers passing quality/acceptance cuts to table
+  int nTowers = mPicoDst->numberOfBTOWHits();
+  for(int itow = 0; itow < nTowers; itow++) {
+    StPicoBTowHit *tower = static_cast<StPicoBTowHit*>(mPicoDst->btowHit(itow));
+    if(!tower) { cout<<"No tower pointer... iTow = "<<itow<<endl; continue; }
+
+    // quality/acceptance cuts
+    if(!AcceptTower(tower)) { continue; }
 
-  // towerStatus array
-  float mTowerMatchTrkIndex[4801] = { 0 };
-  bool mTowerStatusArr[4801] = { 0 };
-  int matchedTowerTrackCounter = 0;
+    // tower ID
+    int towerID = tower->id();
+    if(towerID < 0) continue; // double check these aren't still in the event list
+
+    // tower was not fired
+    double towerE = tower->energy();
+    if(towerE <= 0) continue;
+
+    // cluster and tower position - from vertex and ID: shouldn't need additional eta correction
+    double towerEta, towerPhi, towerCoshEta;
+    if(!mPosition->GetEtaPhiFromVertex(mVertex, towerID, towerEta, towerPhi, towerCoshEta)) continue;
+    fTowerTable->AddTower(itow, towerID, towerE, towerEta, towerPhi, towerCoshEta);
+  }
 
-  // print
-  //int nTracks = mPicoDst->numberOfTracks();
-  //int nTrigs = mPicoDst->numberOfEmcTriggers();
-  //int nBTowHits = mPicoDst->numberOfBTOWHits();
+  // loop over ALL clusters in PicoDst: matched tracks passing quality cuts
   int nBEmcPidTraits = mPicoDst->numberOfBEmcPidTraits();
-//  cout<<"nTracks = "<<nTracks<<"  nTrigs = "<<nTrigs<<"  nBTowHits = "<<nBTowHits<<"  nBEmcPidTraits = "<<nBEmcPidTraits<<endl;
-  
-  // loop over ALL clusters in PicoDst
-  for(unsigned short iClus = 0; iClus < nBEmcPidTraits; iClus++){
+  for(int iClus = 0; iClus < nBEmcPidTraits; iClus++){
     StPicoBEmcPidTraits* cluster = static_cast<StPicoBEmcPidTraits*>(mPicoDst->bemcPidTraits(iClus));
     if(!cluster){ cout<<"Cluster pointer does not exist.. iClus = "<<iClus<<endl; continue; }
 
-    // cluster and tower ID
-    int clusID = cluster->bemcId();  // index in bemc point array
-    int towID = cluster->btowId();   // projected tower Id: 1 - 4800
-    int towID2 = cluster->btowId2(); // emc 2nd and 3rd closest tower local id  ( 2nd X 10 + 3rd), each id 0-8
-    int towID3 = cluster->btowId3(); // emc 2nd and 3rd closest tower local id  ( 2nd X 10 + 3rd), each id 0-8
+    // projected tower Id: 1 - 4800
+    int towID = cluster->btowId();
     if(towID < 0) continue;
 
-    // cluster and tower position - from vertex and ID
-    StThreeVectorF  towPosition;
-    towPosition = mPosition->getPosFromVertex(mVertex, towID);
-    double towPhi = towPosition.phi();
-    if(towPhi < 0)    towPhi += 2*pi;
-    if(towPhi > 2*pi) towPhi -= 2*pi;
-    //double towEta = towPosition.pseudoRapidity();
-    //double detectorRadius = mGeom->Radius();
-
     // matched track index
     int trackIndex = cluster->trackIndex();
     StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(trackIndex));
     if(!trk) { cout<<"No trk pointer...."<<endl; continue; }
-    //if(!AcceptTrack(trk, Bfield, mVertex)) { cout<<"Track not accepted.."<<endl; continue; }
     if(!AcceptTrack(trk, Bfield, mVertex)) { continue; } 
 
-    // tower status set - towerID is matched to track passing quality cuts
-    mTowerMatchTrkIndex[towID] = trackIndex;
-    mTowerStatusArr[towID] = kTRUE;
-    matchedTowerTrackCounter++;
-
-/*  // probably don't need this chunk.. March 14, 2018
- *
     // get track variables to matched tower
     StThreeVectorF mTrkMom;
     if(doUsePrimTracks) { 
@@ -1540,88 +1429,51 @@ void StPicoTrackClusterQA::RunTowerTest()
       // get global track vector
       mTrkMom = trk->gMom(mVertex, Bfield); 
     }
-
-    // track properties
-    double pt = mTrkMom.perp();
-    double phi = mTrkMom.phi();
-    double eta = mTrkMom.pseudoRapidity();
     double p = mTrkMom.mag();
-*/
-
-    // print tower and track info
-//    cout<<"towers: towPhi = "<<towPhi<<"  towEta = "<<towEta<<"  etaCorr = "<<etaCorr;  //<<endl;
-//    cout<<"tracks:  pt = "<<pt<<"  p = "<<p<<"  phi = "<<phi<<"  eta = "<<eta<<endl;
+    double E = 1.0*TMath::Sqrt(p*p + pi0mass*pi0mass);
 
+    // tower is matched to track passing quality cuts
+    fTowerTable->AddMatchedTrack(towID, trackIndex, E);
   }
 
-  // print statment on matches
-  //cout<<"Matched Tracks passing cuts (with tower): "<<matchedTowerTrackCounter<<"  nBTowHits = ";
-  //cout<<mPicoDst->numberOfBTOWHits()<<"  unFiltered Tracks = "<<mPicoDst->numberOfTracks()<<"  Filtered Tracks = "<<fGoodTrackCounter<<endl;
-
-  // loop over towers
-  int nTowers = mPicoDst->numberOfBTOWHits();
-  for(int itow = 0; itow < nTowers; itow++) {
-    StPicoBTowHit *tower = static_cast<StPicoBTowHit*>(mPicoDst->btowHit(itow));
-    if(!tower) { cout<<"No tower pointer... iTow = "<<itow<<endl; continue; }
-
-    // quality/acceptance cuts
-    if(!AcceptTower(tower)) { continue; }
-
-    // tower ID
-    int towerID = tower->id();
-    if(towerID < 0) continue; // double check these aren't still in the event list
-
-    // cluster and tower position - from vertex and ID: shouldn't need additional eta correction
-    StThreeVectorF towerPosition = mPosition->getPosFromVertex(mVertex, towerID);
-    double towerPhi = towerPosition.phi();
-    if(towerPhi < 0)    towerPhi += 2*pi;
-    if(towerPhi > 2*pi) towerPhi -= 2*pi;
-    double towerEta = towerPosition.pseudoRapidity();
-    //int towerADC = tower->adc();
-    //double towerEunCorr = tower->energy();
-    double towerE = tower->energy();
-
-    // tower matched to firing trigger - TODO
-    //if(fTowerToTriggerTypeHT1[emcTrigID])
-    //if(fTowerToTriggerTypeHT2[emcTrigID])
-    //if(fTowerToTriggerTypeHT3[emcTrigID])
-
-    // perform tower cuts
-    // if tower was not matched to an accepted track, use it for jet by itself if > 0.2 GeV
-    if(mTowerStatusArr[towerID]) {
-      //if(mTowerMatchTrkIndex[towerID] > 0) 
-      StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track( mTowerMatchTrkIndex[towerID] ));
-      if(!trk) { cout<<"No trk pointer...."<<endl; continue; } 
-      if(!AcceptTrack(trk, Bfield, mVertex)) { cout<<"track matched back doesn't pass cuts"<<endl; continue; }  // TODO double check this
-
-      // get track variables to matched tower
-      StThreeVectorF mTrkMom;
-      if(doUsePrimTracks) { 
-        // get primary track vector
-        mTrkMom = trk->pMom(); 
-      } else { 
-        // get global track vector
-        mTrkMom = trk->gMom(mVertex, Bfield); 
-      }
+  // apply hadronic correction (last matched track, as before)
+  fTowerTable->ApplyHadronicCorrection(mHadronicCorrFrac);
+}
 
-      //double pt = mTrkMom.perp();
-      //double phi = mTrkMom.phi();
-      //double eta = mTrkMom.pseudoRapidity();
-      double p = mTrkMom.mag();
-      double E = 1.0*TMath::Sqrt(p*p + pi0mass*pi0mass);
+//________________________________________________________________________
+void StPicoTrackClusterQA::RunTowerTest()
+{
+  // corrected tower table of the jet maker: hadronic correction done once per event there
+  const StCorrectedTowerTable *table = 0x0;
+  if(!fJetMakerName.IsNull()) {
+    StJetMakerTask *JetMaker = static_cast<StJetMakerTask*>(GetMaker(fJetMakerName));
+    if(JetMaker) table = JetMaker->GetTowerTable();
+    else LOG_WARN << Form(" No %s! Build local tower table ", fJetMakerName.Data()) << endm;
+  }
 
-      // apply hadronic correction
-      towerE = towerE - (mHadronicCorrFrac * E);
-    } 
-    // else - no match so treat towers on their own
+  // no jet maker (or charged jets only): build local table
+  bool localTable = (table == 0x0);
+  if(localTable) {
+    FillTowerTable();
+    table = fTowerTable;
+  }
 
+  // loop over fired towers
+  for(int row = 0; row < table->GetNumberOfTowers(); row++) {
     // cut on transvere tower energy - corrected or not
-    double towerEt = towerE / (1.0*TMath::CosH(towerEta));
-    if(towerEt < 0) towerEt = 0.0;
+    double towerEt = table->GetEt(row);
     if(towerEt < mTowerEnergyMin) continue;
 
-    // print
-//    cout<<"itow: "<<itow<<"  towerID = "<<towerID<<"  towerPhi = "<<towerPhi<<"  towerEta = "<<towerEta<<"  towerADC = "<<towerADC<<"  towerE = "<<towerE<<"  towerEunCorr = "<<towerEunCorr<<"  mIndex = "<<mTowerMatchTrkIndex[towerID]<<endl;
+    double towerE = table->GetE(row);
+    double towerPhi = table->GetPhi(row);
+    double towerEta = table->GetEta(row);
+
+    // jet maker table has all fired towers: apply the tower cuts of AcceptTower()
+    if(!localTable) {
+      if(table->TestStatusBit(row, StCorrectedTowerTable::kBad) || table->TestStatusBit(row, StCorrectedTowerTable::kDead)) continue;
+      if((towerEta < fTowerEtaMinCut) || (towerEta > fTowerEtaMaxCut)) continue;
+      if((towerPhi < fTowerPhiMinCut) || (towerPhi > fTowerPhiMaxCut)) continue;
+    }
 
     // fill QA histos for towers
     fHistNTowervsE->Fill(towerE);
@@ -1632,7 +1484,6 @@ void StPicoTrackClusterQA::RunTowerTest()
 
   } // tower loop
 
-  //} // cluster loop
 } // cluster / tower QA
 
 //________________________________________________________________________
@@ -1643,7 +1494,7 @@ void StPicoTrackClusterQA::RunFiredTriggerQA()
   int nEmcTrigger = mPicoDst->numberOfEmcTriggers();
 
   // initialize Emc position objects
-  StEmcPosition *mPosition = new StEmcPosition();
+  StEmcPositionCache *mPosition = StEmcPositionCache::Instance();
 
   // loop over valid EmcalTriggers
   for(int i = 0; i < nEmcTrigger; i++) {
@@ -1684,8 +1535,7 @@ void StPicoTrackClusterQA::RunFiredTriggerQA()
     if(towerID < 0) { cout<<"tower ID < 0, tower ID = "<<towerID<<endl; continue; } // double check these aren't still in the event list
 
     // cluster and tower position - from vertex and ID: shouldn't need additional eta correction
-    StThreeVectorF towerPosition = mPosition->getPosFromVertex(mVertex, towerID);
-    //double towerPhi = towerPosition.phi();
+    StThreeVectorF towerPosition = mPosition->GetPosFromVertex(mVertex, towerID);
     double towerEta = towerPosition.pseudoRapidity();
     double towerE = tower->energy();
     double towerEt = towerE / (1.0*TMath::CosH(towerEta));
@@ -1729,109 +1579,22 @@ void StPicoTrackClusterQA::RunFiredTriggerQA()
 
 //_________________________________________________________________________
 Bool_t StPicoTrackClusterQA::CheckForMB(int RunFlag, int type) {
-  // Run14 triggers:
-  int arrMB_Run14[] = {450014};
-  int arrMB30_Run14[] = {450010, 450020};
-  int arrMB5_Run14[] = {450005, 450008, 450009, 450014, 450015, 450018, 450024, 450025, 450050, 450060};
-  // additional 30: 4, 5, 450201, 450202, 450211, 450212
-
-  // Run16 triggers:
-  int arrMB_Run16[] = {520021};
-  int arrMB5_Run16[] = {520001, 520002, 520003, 520011, 520012, 520013, 520021, 520022, 520023, 520031, 520033, 520041, 520042, 520043, 520051, 520822, 520832, 520842, 570702};
-  int arrMB10_Run16[] = {520007, 520017, 520027, 520037, 520201, 520211, 520221, 520231, 520241, 520251, 520261, 520601, 520611, 520621, 520631, 520641};
-
-  // run flag selection to check for MB firing
-  switch(RunFlag) {
-    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
-        switch(type) {
-          case StJetFrameworkPicoBase::kRun14main :
-              if((DoComparison(arrMB_Run14, sizeof(arrMB_Run14)/sizeof(*arrMB_Run14)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kVPDMB5 :
-              if((DoComparison(arrMB5_Run14, sizeof(arrMB5_Run14)/sizeof(*arrMB5_Run14)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kVPDMB30 :
-              if((DoComparison(arrMB30_Run14, sizeof(arrMB30_Run14)/sizeof(*arrMB30_Run14)))) { return kTRUE; }
-              break;
-          default :
-              if((DoComparison(arrMB_Run14, sizeof(arrMB_Run14)/sizeof(*arrMB_Run14)))) { return kTRUE; }
-        }
-        break; // added May20
-
-    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
-        switch(type) {
-          case StJetFrameworkPicoBase::kRun16main :
-              if((DoComparison(arrMB_Run16, sizeof(arrMB_Run16)/sizeof(*arrMB_Run16)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kVPDMB5 :
-              if((DoComparison(arrMB5_Run16, sizeof(arrMB5_Run16)/sizeof(*arrMB5_Run16)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kVPDMB10 :
-              if((DoComparison(arrMB10_Run16, sizeof(arrMB10_Run16)/sizeof(*arrMB10_Run16)))) { return kTRUE; }
-              break;
-          default :
-              if((DoComparison(arrMB_Run16, sizeof(arrMB_Run16)/sizeof(*arrMB_Run16)))) { return kTRUE; }
-        }
-        break; // added May20
+  // trigger bits are decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, RunFlag);
 
-  } // RunFlag switch
-
-  // return status
-  return kFALSE;
+  // MB selection of run flag
+  return ((mask & StPicoTriggerDecoder::GetMBBit(RunFlag, type)) != 0);
 } // MB function
 
 //
 // check to see if the event was EMC triggered for High Towers
 //____________________________________________________________________________
 Bool_t StPicoTrackClusterQA::CheckForHT(int RunFlag, int type) {
+  // trigger bits are decoded once per event by the shared trigger decoder
+  UInt_t mask = StPicoTriggerDecoder::Instance()->Decode(mPicoDst, RunFlag);
 
-  // Run14 triggers:
-  int arrHT1_Run14[] = {450201, 450211, 460201};
-  int arrHT2_Run14[] = {450202, 450212, 460202, 460212};
-  int arrHT3_Run14[] = {450203, 450213, 460203};
-
-  // Run16 triggers:
-  int arrHT1_Run16[] = {520201, 520211, 520221, 520231, 520241, 520251, 520261, 520605, 520615, 520625, 520635, 520645, 520655, 550201, 560201, 560202, 530201, 540201};
-  int arrHT2_Run16[] = {530202, 540203};
-  int arrHT3_Run16[] = {520203, 530213};
-
-  // run flag selection to check for MB firing
-  switch(RunFlag) {
-    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
-        switch(type) {
-          case StJetFrameworkPicoBase::kIsHT1 :
-              if((DoComparison(arrHT1_Run14, sizeof(arrHT1_Run14)/sizeof(*arrHT1_Run14)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kIsHT2 :
-              if((DoComparison(arrHT2_Run14, sizeof(arrHT2_Run14)/sizeof(*arrHT2_Run14)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kIsHT3 :
-              if((DoComparison(arrHT3_Run14, sizeof(arrHT3_Run14)/sizeof(*arrHT3_Run14)))) { return kTRUE; }
-              break;
-          default :  // default to HT2
-              if((DoComparison(arrHT2_Run14, sizeof(arrHT2_Run14)/sizeof(*arrHT2_Run14)))) { return kTRUE; }
-        }
-        break; // added May20
-
-    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
-        switch(type) {
-          case StJetFrameworkPicoBase::kIsHT1 :
-              if((DoComparison(arrHT1_Run16, sizeof(arrHT1_Run16)/sizeof(*arrHT1_Run16)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kIsHT2 :
-              if((DoComparison(arrHT2_Run16, sizeof(arrHT2_Run16)/sizeof(*arrHT2_Run16)))) { return kTRUE; }
-              break;
-          case StJetFrameworkPicoBase::kIsHT3 :
-              if((DoComparison(arrHT3_Run16, sizeof(arrHT3_Run16)/sizeof(*arrHT3_Run16)))) { return kTRUE; }
-              break;
-          default :  // Run16 only has HT1's
-              if((DoComparison(arrHT1_Run16, sizeof(arrHT1_Run16)/sizeof(*arrHT1_Run16)))) { return kTRUE; }
-        }
-        break; // added May20
-
-  } // RunFlag switch
-
-  return kFALSE;
+  // HT selection of run flag
+  return ((mask & StPicoTriggerDecoder::GetHTBit(RunFlag, type)) != 0);
 }
 
 //____________________________________________________________________________________________
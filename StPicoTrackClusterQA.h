@@ -41,6 +41,7 @@ class StBemcTables; //v3.14
 class StEmcCluster;
 class StEmcCollection;
 class StEmcPosition;
+class StCorrectedTowerTable;
 
 // centrality class
 class StRefMultCorr;
@@ -143,6 +144,8 @@ class StPicoTrackClusterQA : public StMaker {
   // common setters
   void                 SetClusName(const char *n)       { fCaloName      = n;  }
   void                 SetTracksName(const char *n)     { fTracksName    = n;  }
+  // jet maker providing the corrected tower table (hadronic correction), if not set the table is built here
+  void                 SetJetMakerName(const char *jn)  { fJetMakerName  = jn; }
   void                 SetTrackEfficiency(Double_t t)   { fTrackEfficiency  = t     ; }
 
   Double_t             GetTrackEfficiency()             { return fTrackEfficiency   ; }
@@ -162,6 +165,7 @@ class StPicoTrackClusterQA : public StMaker {
  protected:
   void                   RunQA();
   void                   RunTowerTest();
+  void                   FillTowerTable();                                               // fill local corrected tower table (no jet maker)
   void                   RunFiredTriggerQA();  
   Bool_t                 AcceptTrack(StPicoTrack *trk, Float_t B, StThreeVectorF Vert);  // track accept cuts function
   Bool_t                 AcceptTower(StPicoBTowHit *tower);                              // tower accept cuts function
@@ -169,7 +173,6 @@ class StPicoTrackClusterQA : public StMaker {
   Bool_t                 SelectAnalysisCentralityBin(Int_t centbin, Int_t fCentralitySelectionCut); // centrality bin to cut on for analysis
   TH1*                   FillEmcTriggersHist(TH1* h);                          // EmcTrigger counter histo
   TH1*                   FillEventTriggerQA(TH1* h);                           // filled event trigger QA plots
-  Bool_t                 DoComparison(int myarr[], int elems);
   Bool_t                 CheckForMB(int RunFlag, int type);
   Bool_t                 CheckForHT(int RunFlag, int type);
 
@@ -195,6 +198,7 @@ class StPicoTrackClusterQA : public StMaker {
   TString                fAnalysisMakerName;      // name of this analysis maker
   TString                fTracksName;             // name of track collection
   TString                fCaloName;               // name of calo cluster collection
+  TString                fJetMakerName;           // name of jet maker providing the corrected tower table
 
   Double_t               fTrackPtMinCut;          // min track pt cut
   Double_t               fTrackPtMaxCut;          // max track pt cut
@@ -231,9 +235,6 @@ class StPicoTrackClusterQA : public StMaker {
   UInt_t          fEmcTriggerEventType;        // Physics selection of event used for signal
   UInt_t          fMBEventType;                // Physics selection of event used for MB
   Int_t           fEmcTriggerArr[8];           // EMCal triggers array: used to select signal and do QA
-  Bool_t          fTowerToTriggerTypeHT1[4801];// Tower with corresponding HT1 trigger type array
-  Bool_t          fTowerToTriggerTypeHT2[4801];// Tower with corresponding HT2 trigger type array
-  Bool_t          fTowerToTriggerTypeHT3[4801];// Tower with corresponding HT3 trigger type array
 
   // Emc objects
   StEmcGeom             *mGeom;
@@ -244,6 +245,7 @@ class StPicoTrackClusterQA : public StMaker {
   towerMode              mTowerStatusMode;
   Double_t               mTowerEnergyMin;
   Float_t                mHadronicCorrFrac;
+  StCorrectedTowerTable *fTowerTable;             //!local per-event corrected tower table (no jet maker set)
 
  private:
   Bool_t MuProcessBEMC();
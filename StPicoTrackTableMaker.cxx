@@ -0,0 +1,246 @@
+// ################################################################
+// Author:  Joel Mazer for the STAR Collaboration
+// Affiliation: Rutgers University
+//
+// event-scoped accepted-track table
+//      - global (or primary) track momentum computed once per event
+//      - structure-of-arrays: px, py, pz, pt, eta, phi, charge, dca
+//      - cut-pass bitmask per registered cut profile
+//      - accepted track index list per cut profile
+//
+// ################################################################
+// $Id$
+
+#include "StPicoTrackTableMaker.h"
+
+// ROOT includes
+#include "TMath.h"
+
+// STAR includes
+#include "StThreeVectorF.hh"
+#include "StRoot/StPicoDstMaker/StPicoDst.h"
+#include "StRoot/StPicoDstMaker/StPicoDstMaker.h"
+#include "StRoot/StPicoEvent/StPicoEvent.h"
+#include "StRoot/StPicoEvent/StPicoTrack.h"
+
+ClassImp(StPicoTrackTableMaker)
+
+//________________________________________________________________________
+StPicoTrackTableMaker::StPicoTrackTableMaker(const char *name) :
+  StMaker(name),
+  doUsePrimTracks(kFALSE),
+  fDebugLevel(0),
+  fCutProfiles(),
+  fNTracks(0),
+  fRunId(-1),
+  fEventId(-1),
+  mPicoDstMaker(0x0),
+  mPicoDst(0x0),
+  mPicoEvent(0x0)
+{
+  // Standard constructor.
+}
+
+//________________________________________________________________________
+StPicoTrackTableMaker::~StPicoTrackTableMaker()
+{
+  // Destructor
+}
+
+//________________________________________________________________________
+Int_t StPicoTrackTableMaker::Init() {
+  // reserve some space for central Au+Au events
+  const Int_t nReserve = 2000;
+  fPx.reserve(nReserve);  fPy.reserve(nReserve);  fPz.reserve(nReserve);
+  fP.reserve(nReserve);   fPt.reserve(nReserve);
+  fEta.reserve(nReserve); fPhi.reserve(nReserve);
+  fCharge.reserve(nReserve); fDca.reserve(nReserve);
+  fNHitsFit.reserve(nReserve); fNHitsRatio.reserve(nReserve);
+  fValid.reserve(nReserve); fCutMask.reserve(nReserve);
+
+  return kStOK;
+}
+
+//________________________________________________________________________
+Int_t StPicoTrackTableMaker::Finish() {
+  cout<<"StPicoTrackTableMaker::Finish(): "<<fCutProfiles.size()<<" cut profiles registered"<<endl;
+  for(UInt_t ip = 0; ip < fCutProfiles.size(); ip++) {
+    cout<<"  profile "<<ip<<": "<<fCutProfiles[ip].fName<<endl;
+  }
+
+  return kStOK;
+}
+
+//________________________________________________________________________
+void StPicoTrackTableMaker::Clear(Option_t *opt) {
+  // keep vector capacity between events
+  fNTracks = 0;
+  fRunId = -1;
+  fEventId = -1;
+  for(UInt_t ip = 0; ip < fAccepted.size(); ip++) fAccepted[ip].clear();
+}
+
+//________________________________________________________________________
+Int_t StPicoTrackTableMaker::AddCutProfile(const char *name, Double_t ptMin, Double_t ptMax,
+    Double_t etaMin, Double_t etaMax, Double_t phiMin, Double_t phiMax,
+    Double_t dcaMax, Int_t nHitsFitMin, Double_t nHitsRatioMin)
+{
+  // share profile with identical cuts
+  for(UInt_t ip = 0; ip < fCutProfiles.size(); ip++) {
+    const StTrackCutProfile &c = fCutProfiles[ip];
+    if((c.fPtMin == ptMin) && (c.fPtMax == ptMax) &&
+       (c.fEtaMin == etaMin) && (c.fEtaMax == etaMax) &&
+       (c.fPhiMin == phiMin) && (c.fPhiMax == phiMax) &&
+       (c.fDcaMax == dcaMax) && (c.fNHitsFitMin == nHitsFitMin) &&
+       (c.fNHitsRatioMin == nHitsRatioMin)) {
+      fCutProfiles[ip].fName += Form(",%s", name);
+      return ip;
+    }
+  }
+
+  if((Int_t)fCutProfiles.size() >= kMaxCutProfiles) {
+    LOG_WARN << Form(" StPicoTrackTableMaker: no cut profiles left for %s! ", name) << endm;
+    return -1;
+  }
+
+  // new profile
+  StTrackCutProfile c;
+  c.fName = name;
+  c.fPtMin = ptMin;   c.fPtMax = ptMax;
+  c.fEtaMin = etaMin; c.fEtaMax = etaMax;
+  c.fPhiMin = phiMin; c.fPhiMax = phiMax;
+  c.fDcaMax = dcaMax;
+  c.fNHitsFitMin = nHitsFitMin;
+  c.fNHitsRatioMin = nHitsRatioMin;
+  fCutProfiles.push_back(c);
+  fAccepted.resize(fCutProfiles.size());
+
+  // profile registered in the middle of an event (from a downstream Make()): evaluate it now
+  Int_t ip = (Int_t)fCutProfiles.size() - 1;
+  if(fNTracks > 0) EvaluateCutProfile(ip);
+
+  return ip;
+}
+
+//________________________________________________________________________
+Int_t StPicoTrackTableMaker::Make() {
+  // get PicoDstMaker
+  mPicoDstMaker = static_cast<StPicoDstMaker*>(GetMaker("picoDst"));
+  if(!mPicoDstMaker) {
+    LOG_WARN << " No PicoDstMaker! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // construct PicoDst object from maker
+  mPicoDst = static_cast<StPicoDst*>(mPicoDstMaker->picoDst());
+  if(!mPicoDst) {
+    LOG_WARN << " No PicoDst! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // create pointer to PicoEvent
+  mPicoEvent = static_cast<StPicoEvent*>(mPicoDst->event());
+  if(!mPicoEvent) {
+    LOG_WARN << " No PicoEvent! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // event B (magnetic) field and vertex
+  double Bfield = mPicoEvent->bField();
+  StThreeVectorF mVertex = mPicoEvent->primaryVertex();
+  fRunId = mPicoEvent->runId();
+  fEventId = mPicoEvent->eventId();
+
+  // resize table - capacity is kept between events
+  const double pi = 1.0*TMath::Pi();
+  fNTracks = mPicoDst->numberOfTracks();
+  fPx.resize(fNTracks);  fPy.resize(fNTracks);  fPz.resize(fNTracks);
+  fP.resize(fNTracks);   fPt.resize(fNTracks);
+  fEta.resize(fNTracks); fPhi.resize(fNTracks);
+  fCharge.resize(fNTracks); fDca.resize(fNTracks);
+  fNHitsFit.resize(fNTracks); fNHitsRatio.resize(fNTracks);
+  fValid.resize(fNTracks); fCutMask.resize(fNTracks);
+
+  // fill track kinematics: the helix momentum is computed once here
+  for(int i = 0; i < fNTracks; i++) {
+    fValid[i] = kFALSE;
+    fCutMask[i] = 0;
+    fPx[i] = 0.; fPy[i] = 0.; fPz[i] = 0.; fP[i] = 0.;
+    fPt[i] = 0.; fEta[i] = 0.; fPhi[i] = 0.;
+    fCharge[i] = 0; fDca[i] = 0.; fNHitsFit[i] = 0; fNHitsRatio[i] = 0.;
+
+    StPicoTrack* trk = static_cast<StPicoTrack*>(mPicoDst->track(i));
+    if(!trk) continue;
+
+    // get momentum vector of track - global or primary track
+    StThreeVectorF mTrkMom;
+    if(doUsePrimTracks) {
+      if(!(trk->isPrimary())) continue; // check if primary
+      // get primary track vector
+      mTrkMom = trk->pMom();
+    } else {
+      // get global track vector
+      mTrkMom = trk->gMom(mVertex, Bfield);
+    }
+
+    // track variables
+    double pt = mTrkMom.perp();
+    double phi = mTrkMom.phi();
+    if(phi < 0)    phi += 2*pi;
+    if(phi > 2*pi) phi -= 2*pi;
+    int nHitsFit = trk->nHitsFit();
+    int nHitsMax = trk->nHitsMax();
+
+    fPx[i] = mTrkMom.x();
+    fPy[i] = mTrkMom.y();
+    fPz[i] = mTrkMom.z();
+    fP[i] = mTrkMom.mag();
+    fPt[i] = pt;
+    fEta[i] = (pt > 0) ? mTrkMom.pseudoRapidity() : 0.;
+    fPhi[i] = phi;
+    fCharge[i] = trk->charge();
+    fDca[i] = (trk->dcaPoint() - mVertex).mag();
+    fNHitsFit[i] = nHitsFit;
+    fNHitsRatio[i] = (nHitsMax > 0) ? 1.0*nHitsFit/nHitsMax : 0.;
+    fValid[i] = kTRUE;
+  }
+
+  // fill cut-pass bits for all registered profiles
+  for(UInt_t ip = 0; ip < fCutProfiles.size(); ip++) EvaluateCutProfile(ip);
+
+  if(fDebugLevel > 0) {
+    cout<<"StPicoTrackTableMaker: nTracks = "<<fNTracks;
+    for(UInt_t ip = 0; ip < fAccepted.size(); ip++) cout<<"  accepted["<<ip<<"] = "<<fAccepted[ip].size();
+    cout<<endl;
+  }
+
+  return kStOK;
+}
+
+//________________________________________________________________________
+void StPicoTrackTableMaker::EvaluateCutProfile(Int_t ip) {
+  // same cuts (and same order) as AcceptTrack() / AcceptJetTrack()
+  const StTrackCutProfile &c = fCutProfiles[ip];
+  const UInt_t bit = (1u << ip);
+  std::vector<Int_t> &accepted = fAccepted[ip];
+  accepted.clear();
+
+  for(int i = 0; i < fNTracks; i++) {
+    fCutMask[i] &= ~bit;
+    if(!fValid[i]) continue;
+
+    // pt, eta, phi cuts
+    if(fPt[i] < c.fPtMin) continue;
+    if(fPt[i] > c.fPtMax) continue;
+    if((fEta[i] < c.fEtaMin) || (fEta[i] > c.fEtaMax)) continue;
+    if((fPhi[i] < c.fPhiMin) || (fPhi[i] > c.fPhiMax)) continue;
+
+    // additional quality cuts for tracks
+    if(fDca[i] > c.fDcaMax) continue;
+    if(fNHitsFit[i] < c.fNHitsFitMin) continue;
+    if(fNHitsRatio[i] < c.fNHitsRatioMin) continue;
+
+    fCutMask[i] |= bit;
+    accepted.push_back(i);
+  }
+}
@@ -0,0 +1,130 @@
+#ifndef STPICOTRACKTABLEMAKER_H
+#define STPICOTRACKTABLEMAKER_H
+
+// $Id$
+//
+// Event-scoped table of track kinematics shared by all makers.
+//
+// Runs once per event at the head of the chain (after the PicoDstMaker):
+// the (global or primary) momentum of every PicoDst track is computed once
+// and kept as structure-of-arrays (index = PicoDst track index), together
+// with a cut-pass bitmask: one bit per registered cut profile.
+//
+// Downstream makers register their track cuts once with AddCutProfile()
+// and look the table up with GetMaker(), instead of repeating
+// AcceptTrack() + gMom(mVertex, Bfield) for every track.
+
+#include "StMaker.h"
+#include "TString.h"
+
+#include <vector>
+
+// STAR classes
+class StPicoDst;
+class StPicoDstMaker;
+class StPicoEvent;
+
+class StPicoTrackTableMaker : public StMaker {
+ public:
+  // maximum number of cut profiles (bits of mask)
+  enum { kMaxCutProfiles = 32 };
+
+  // set of track cuts: all makers using the same cuts share one profile
+  struct StTrackCutProfile {
+    TString            fName;            // profile name (maker registering it)
+    Double_t           fPtMin;           // min track pt
+    Double_t           fPtMax;           // max track pt
+    Double_t           fEtaMin;          // min track eta
+    Double_t           fEtaMax;          // max track eta
+    Double_t           fPhiMin;          // min track phi (0, 2pi)
+    Double_t           fPhiMax;          // max track phi (0, 2pi)
+    Double_t           fDcaMax;          // max track dca
+    Int_t              fNHitsFitMin;     // min nHitsFit
+    Double_t           fNHitsRatioMin;   // min nHitsFit / nHitsMax
+  };
+
+  StPicoTrackTableMaker(const char *name = "TrackTable");
+  virtual ~StPicoTrackTableMaker();
+
+  // class required functions
+  virtual Int_t Init();
+  virtual Int_t Make();
+  virtual void  Clear(Option_t *opt="");
+  virtual Int_t Finish();
+
+  // switches
+  virtual void            SetUsePrimaryTracks(Bool_t P)    { doUsePrimTracks = P; }
+  virtual void            SetDebugLevel(Int_t l)           { fDebugLevel     = l; }
+  Bool_t                  GetUsePrimaryTracks() const      { return doUsePrimTracks; }
+
+  // register a set of track cuts: returns profile (bit) index, or -1 if none left
+  // an identical, already registered set of cuts returns the existing index
+  Int_t                   AddCutProfile(const char *name, Double_t ptMin, Double_t ptMax,
+                            Double_t etaMin, Double_t etaMax, Double_t phiMin, Double_t phiMax,
+                            Double_t dcaMax, Int_t nHitsFitMin, Double_t nHitsRatioMin);
+  Int_t                   GetNumberOfCutProfiles() const   { return (Int_t)fCutProfiles.size(); }
+  UInt_t                  GetCutProfileMask(Int_t ip) const { return (ip < 0) ? 0 : (1u << ip); }
+
+  // event
+  Int_t                   GetNumberOfTracks() const        { return fNTracks; }
+  Int_t                   GetRunId() const                 { return fRunId; }
+  Int_t                   GetEventId() const               { return fEventId; }
+
+  // per-track access (index = PicoDst track index)
+  Bool_t                  PassCuts(Int_t i, Int_t ip) const { return (fCutMask[i] >> ip) & 1u; }
+  UInt_t                  GetCutMask(Int_t i) const        { return fCutMask[i]; }
+  Float_t                 GetPx(Int_t i) const             { return fPx[i]; }
+  Float_t                 GetPy(Int_t i) const             { return fPy[i]; }
+  Float_t                 GetPz(Int_t i) const             { return fPz[i]; }
+  Float_t                 GetP(Int_t i) const              { return fP[i]; }
+  Float_t                 GetPt(Int_t i) const             { return fPt[i]; }
+  Float_t                 GetEta(Int_t i) const            { return fEta[i]; }
+  Float_t                 GetPhi(Int_t i) const            { return fPhi[i]; }  // (0, 2pi)
+  Short_t                 GetCharge(Int_t i) const         { return fCharge[i]; }
+  Float_t                 GetDca(Int_t i) const            { return fDca[i]; }
+
+  // indices of tracks passing a cut profile (ordered by PicoDst track index)
+  const std::vector<Int_t>& GetAcceptedTracks(Int_t ip) const { return fAccepted[ip]; }
+
+ protected:
+  void                    EvaluateCutProfile(Int_t ip);    // fill bit ip and accepted list for current event
+
+  // switches
+  Bool_t                  doUsePrimTracks;         // primary track switch
+  Int_t                   fDebugLevel;             // debug printout level
+
+  // cut profiles
+  std::vector<StTrackCutProfile> fCutProfiles;     //!registered cut profiles
+
+  // event
+  Int_t                   fNTracks;                // number of PicoDst tracks in table
+  Int_t                   fRunId;                  // run ID of current table
+  Int_t                   fEventId;                // event ID of current table
+
+  // structure-of-arrays track table (index = PicoDst track index)
+  std::vector<Float_t>    fPx;                     //!track px
+  std::vector<Float_t>    fPy;                     //!track py
+  std::vector<Float_t>    fPz;                     //!track pz
+  std::vector<Float_t>    fP;                      //!track momentum
+  std::vector<Float_t>    fPt;                     //!track pt
+  std::vector<Float_t>    fEta;                    //!track eta
+  std::vector<Float_t>    fPhi;                    //!track phi (0, 2pi)
+  std::vector<Short_t>    fCharge;                 //!track charge
+  std::vector<Float_t>    fDca;                    //!track dca to primary vertex
+  std::vector<Short_t>    fNHitsFit;               //!track nHitsFit
+  std::vector<Float_t>    fNHitsRatio;             //!track nHitsFit / nHitsMax
+  std::vector<Bool_t>     fValid;                  //!track exists (and is primary in primary mode)
+  std::vector<UInt_t>     fCutMask;                //!cut-pass bitmask, bit = cut profile
+  std::vector<std::vector<Int_t> > fAccepted;      //!accepted track indices per cut profile
+
+ private:
+  StPicoDstMaker         *mPicoDstMaker;           // PicoDstMaker object
+  StPicoDst              *mPicoDst;                // PicoDst object
+  StPicoEvent            *mPicoEvent;              // PicoEvent object
+
+  StPicoTrackTableMaker(const StPicoTrackTableMaker&);            // not implemented
+  StPicoTrackTableMaker &operator=(const StPicoTrackTableMaker&); // not implemented
+
+  ClassDef(StPicoTrackTableMaker, 1) // event-scoped track table
+};
+#endif
@@ -0,0 +1,335 @@
+// ################################################################
+// Author:  Joel Mazer for the STAR Collaboration
+// Affiliation: Rutgers University
+//
+// run-scoped trigger decoder
+//      - MB / HT trigger ID's of run flag compiled once into a sorted table
+//      - one trigger bitmask per event, shared by all makers
+//      - fired EMC triggers and per-tower HT bits filled once per event
+//      - replaces CheckForMB() / CheckForHT() / DoComparison() scans,
+//        also for the event trigger QA histogram (FillEventTriggerQA)
+//
+// ################################################################
+// $Id$
+
+#include "StPicoTriggerDecoder.h"
+
+// STAR includes
+#include "StRoot/StPicoDstMaker/StPicoDst.h"
+#include "StRoot/StPicoEvent/StPicoEvent.h"
+#include "StRoot/StPicoEvent/StPicoEmcTrigger.h"
+
+// ROOT includes
+#include "TH1.h"
+#include "TAxis.h"
+
+// jet-framework includes
+#include "StJetFrameworkPicoBase.h"
+
+#include <algorithm>
+
+StPicoTriggerDecoder *StPicoTriggerDecoder::fgInstance = 0x0;
+
+ClassImp(StPicoTriggerDecoder)
+
+//________________________________________________________________________
+StPicoTriggerDecoder::StPicoTriggerDecoder() :
+  fTriggerTable(),
+  fTableRunFlag(-1),
+  fRunFlag(-1),
+  fRunId(-1),
+  fEventId(-1),
+  fTriggerMask(0),
+  fFiredTowers()
+{
+  // Constructor: use StPicoTriggerDecoder::Instance()
+  for(Int_t i = 0; i <= kNTowers; i++) fTowerTrigger[i] = 0;
+  fFiredTowers.reserve(100);
+}
+
+//________________________________________________________________________
+StPicoTriggerDecoder::~StPicoTriggerDecoder()
+{
+  // Destructor
+}
+
+//________________________________________________________________________
+StPicoTriggerDecoder* StPicoTriggerDecoder::Instance()
+{
+  // get shared instance
+  if(!fgInstance) fgInstance = new StPicoTriggerDecoder();
+
+  return fgInstance;
+}
+
+//________________________________________________________________________
+void StPicoTriggerDecoder::AddTriggers(const Int_t *ids, Int_t n, UInt_t bit)
+{
+  // add trigger ID's with bit: a trigger ID can belong to several trigger types
+  for(Int_t i = 0; i < n; i++) fTriggerTable.push_back(std::make_pair(ids[i], bit));
+}
+
+//________________________________________________________________________
+void StPicoTriggerDecoder::BuildTriggerTable(Int_t runFlag)
+{
+  // Run14 triggers:
+  const Int_t arrMB_Run14[] = {450014};
+  const Int_t arrMB30_Run14[] = {450010, 450020};
+  const Int_t arrMB5_Run14[] = {450005, 450008, 450009, 450014, 450015, 450018, 450024, 450025, 450050, 450060};
+  // additional 30: 4, 5, 450201, 450202, 450211, 450212
+  // 1: VPDMB-5   Run:            15075055 - 15076099
+  // 1: VPDMB-5-p-nobsmd-hlt Run: 15081020 - 15090048
+  // 4: VPDMB-5-p-nobsmd-hlt Run: 15090049 - 15167007
+  const Int_t arrHT1_Run14[] = {450201, 450211, 460201};
+  const Int_t arrHT2_Run14[] = {450202, 450212, 460202, 460212};
+  const Int_t arrHT3_Run14[] = {450203, 450213, 460203};
+  const Int_t arrCentral5_Run14[] = {450010, 450020};
+  const Int_t arrCentral_Run14[] = {460101, 460111};
+
+  // Run16 triggers:
+  const Int_t arrMB_Run16[] = {520021};
+  const Int_t arrMB5_Run16[] = {520001, 520002, 520003, 520011, 520012, 520013, 520021, 520022, 520023, 520031, 520033, 520041, 520042, 520043, 520051, 520822, 520832, 520842, 570702};
+  const Int_t arrMB10_Run16[] = {520007, 520017, 520027, 520037, 520201, 520211, 520221, 520231, 520241, 520251, 520261, 520601, 520611, 520621, 520631, 520641};
+  const Int_t arrHT1_Run16[] = {520201, 520211, 520221, 520231, 520241, 520251, 520261, 520605, 520615, 520625, 520635, 520645, 520655, 550201, 560201, 560202, 530201, 540201};
+  const Int_t arrHT2_Run16[] = {530202, 540203};
+  const Int_t arrHT3_Run16[] = {520203, 530213};
+  const Int_t arrCentral_Run16[] = {520101, 520111, 520121, 520131, 520141, 520103, 520113, 520123};
+
+  fTriggerTable.clear();
+  fTableRunFlag = runFlag;
+
+  switch(runFlag) {
+    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
+        AddTriggers(arrMB_Run14, sizeof(arrMB_Run14)/sizeof(*arrMB_Run14), kMB);
+        AddTriggers(arrMB5_Run14, sizeof(arrMB5_Run14)/sizeof(*arrMB5_Run14), kMB5);
+        AddTriggers(arrMB30_Run14, sizeof(arrMB30_Run14)/sizeof(*arrMB30_Run14), kMB30);
+        AddTriggers(arrHT1_Run14, sizeof(arrHT1_Run14)/sizeof(*arrHT1_Run14), kHT1);
+        AddTriggers(arrHT2_Run14, sizeof(arrHT2_Run14)/sizeof(*arrHT2_Run14), kHT2);
+        AddTriggers(arrHT3_Run14, sizeof(arrHT3_Run14)/sizeof(*arrHT3_Run14), kHT3);
+        AddTriggers(arrCentral5_Run14, sizeof(arrCentral5_Run14)/sizeof(*arrCentral5_Run14), kCentral5);
+        AddTriggers(arrCentral_Run14, sizeof(arrCentral_Run14)/sizeof(*arrCentral_Run14), kCentral);
+        break;
+
+    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
+        AddTriggers(arrMB_Run16, sizeof(arrMB_Run16)/sizeof(*arrMB_Run16), kMB);
+        AddTriggers(arrMB5_Run16, sizeof(arrMB5_Run16)/sizeof(*arrMB5_Run16), kMB5);
+        AddTriggers(arrMB10_Run16, sizeof(arrMB10_Run16)/sizeof(*arrMB10_Run16), kMB10);
+        AddTriggers(arrHT1_Run16, sizeof(arrHT1_Run16)/sizeof(*arrHT1_Run16), kHT1);
+        AddTriggers(arrHT2_Run16, sizeof(arrHT2_Run16)/sizeof(*arrHT2_Run16), kHT2);
+        AddTriggers(arrHT3_Run16, sizeof(arrHT3_Run16)/sizeof(*arrHT3_Run16), kHT3);
+        AddTriggers(arrCentral_Run16, sizeof(arrCentral_Run16)/sizeof(*arrCentral_Run16), kCentral);
+        break;
+
+    default : // no trigger ID's defined: only fired EMC triggers are decoded
+        break;
+  } // RunFlag switch
+
+  // sort by trigger ID and merge bits of duplicate ID's (e.g. 450014: MB and VPDMB-5)
+  std::sort(fTriggerTable.begin(), fTriggerTable.end());
+  UInt_t nUnique = 0;
+  for(UInt_t i = 0; i < fTriggerTable.size(); i++) {
+    if((nUnique > 0) && (fTriggerTable[nUnique-1].first == fTriggerTable[i].first)) {
+      fTriggerTable[nUnique-1].second |= fTriggerTable[i].second;
+    } else {
+      fTriggerTable[nUnique++] = fTriggerTable[i];
+    }
+  }
+  fTriggerTable.resize(nUnique);
+}
+
+//________________________________________________________________________
+UInt_t StPicoTriggerDecoder::LookupTrigger(Int_t triggerID) const
+{
+  // trigger bits of trigger ID: binary search of sorted table
+  std::vector<std::pair<Int_t, UInt_t> >::const_iterator it =
+    std::lower_bound(fTriggerTable.begin(), fTriggerTable.end(), std::make_pair(triggerID, 0u));
+  if((it != fTriggerTable.end()) && (it->first == triggerID)) return it->second;
+
+  return 0;
+}
+
+//________________________________________________________________________
+UInt_t StPicoTriggerDecoder::Decode(StPicoDst *picoDst, Int_t runFlag)
+{
+  // decode trigger bits of current event
+  if(!picoDst) return 0;
+  StPicoEvent *picoEvent = static_cast<StPicoEvent*>(picoDst->event());
+  if(!picoEvent) return 0;
+
+  // already decoded by a previous maker in the chain
+  Int_t runId = picoEvent->runId();
+  Int_t eventId = picoEvent->eventId();
+  if((runId == fRunId) && (eventId == fEventId) && (runFlag == fRunFlag)) return fTriggerMask;
+
+  // trigger ID table: compiled once per run flag
+  if(runFlag != fTableRunFlag) BuildTriggerTable(runFlag);
+
+  fRunFlag = runFlag;
+  fRunId = runId;
+  fEventId = eventId;
+  fTriggerMask = 0;
+
+  // fired trigger ID's of event
+  std::vector<unsigned int> triggerIds = picoEvent->triggerIds();
+  for(UInt_t i = 0; i < triggerIds.size(); i++) {
+    fTriggerMask |= LookupTrigger((Int_t)triggerIds[i]);
+  }
+
+  // only reset towers fired in previous event
+  for(UInt_t i = 0; i < fFiredTowers.size(); i++) fTowerTrigger[fFiredTowers[i]] = 0;
+  fFiredTowers.clear();
+
+  // loop over valid EmcalTriggers
+  int nEmcTrigger = picoDst->numberOfEmcTriggers();
+  for(int i = 0; i < nEmcTrigger; i++) {
+    StPicoEmcTrigger *emcTrig = static_cast<StPicoEmcTrigger*>(picoDst->emcTrigger(i));
+    if(!emcTrig) continue;
+
+    if(emcTrig->isHT0()) fTriggerMask |= kEmcHT0;
+    if(emcTrig->isHT1()) fTriggerMask |= kEmcHT1;
+    if(emcTrig->isHT2()) fTriggerMask |= kEmcHT2;
+    if(emcTrig->isHT3()) fTriggerMask |= kEmcHT3;
+    if(emcTrig->isJP0()) fTriggerMask |= kEmcJP0;
+    if(emcTrig->isJP1()) fTriggerMask |= kEmcJP1;
+    if(emcTrig->isJP2()) fTriggerMask |= kEmcJP2;
+
+    // tower - HT trigger types
+    int emcTrigID = emcTrig->id();
+    if((emcTrigID < 1) || (emcTrigID > kNTowers)) continue;
+    UChar_t bits = 0;
+    if(emcTrig->isHT1()) bits |= kTowerHT1;
+    if(emcTrig->isHT2()) bits |= kTowerHT2;
+    if(emcTrig->isHT3()) bits |= kTowerHT3;
+    if(!bits) continue;
+    if(!fTowerTrigger[emcTrigID]) fFiredTowers.push_back(emcTrigID);
+    fTowerTrigger[emcTrigID] |= bits;
+  }
+
+  return fTriggerMask;
+}
+
+//________________________________________________________________________
+UInt_t StPicoTriggerDecoder::GetMBBit(Int_t runFlag, Int_t type)
+{
+  // same selection as the former CheckForMB(): unknown type -> main MB trigger of run
+  switch(runFlag) {
+    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
+        switch(type) {
+          case StJetFrameworkPicoBase::kRun14main : return kMB;
+          case StJetFrameworkPicoBase::kVPDMB5 :    return kMB5;
+          case StJetFrameworkPicoBase::kVPDMB30 :   return kMB30;
+          default :                                 return kMB;
+        }
+
+    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
+        switch(type) {
+          case StJetFrameworkPicoBase::kRun16main : return kMB;
+          case StJetFrameworkPicoBase::kVPDMB5 :    return kMB5;
+          case StJetFrameworkPicoBase::kVPDMB10 :   return kMB10;
+          default :                                 return kMB;
+        }
+  } // RunFlag switch
+
+  return 0;
+}
+
+//________________________________________________________________________
+UInt_t StPicoTriggerDecoder::GetHTBit(Int_t runFlag, Int_t type)
+{
+  // same selection as the former CheckForHT()
+  switch(runFlag) {
+    case StJetFrameworkPicoBase::Run14_AuAu200 : // Run14 AuAu
+        switch(type) {
+          case StJetFrameworkPicoBase::kIsHT1 : return kHT1;
+          case StJetFrameworkPicoBase::kIsHT2 : return kHT2;
+          case StJetFrameworkPicoBase::kIsHT3 : return kHT3;
+          default :                             return kHT2;  // default to HT2
+        }
+
+    case StJetFrameworkPicoBase::Run16_AuAu200 : // Run16 AuAu
+        switch(type) {
+          case StJetFrameworkPicoBase::kIsHT1 : return kHT1;
+          case StJetFrameworkPicoBase::kIsHT2 : return kHT2;
+          case StJetFrameworkPicoBase::kIsHT3 : return kHT3;
+          default :                             return kHT1;  // Run16 only has HT1's
+        }
+  } // RunFlag switch
+
+  return 0;
+}
+
+//________________________________________________________________________
+UInt_t StPicoTriggerDecoder::GetEmcTriggerBit(Int_t type)
+{
+  // fired EMC trigger bit: 0 for kAny (no fired EMC trigger required)
+  switch(type) {
+    case StJetFrameworkPicoBase::kIsHT0 : return kEmcHT0;
+    case StJetFrameworkPicoBase::kIsHT1 : return kEmcHT1;
+    case StJetFrameworkPicoBase::kIsHT2 : return kEmcHT2;
+    case StJetFrameworkPicoBase::kIsHT3 : return kEmcHT3;
+    case StJetFrameworkPicoBase::kIsJP0 : return kEmcJP0;
+    case StJetFrameworkPicoBase::kIsJP1 : return kEmcJP1;
+    case StJetFrameworkPicoBase::kIsJP2 : return kEmcJP2;
+  }
+
+  return 0;
+}
+
+//________________________________________________________________________
+void StPicoTriggerDecoder::FillEventTriggerQA(TH1 *h, UInt_t mask, Int_t runFlag)
+{
+  // check and fill a Event Selection QA histogram for different trigger selections
+  // (mask from Decode() of the current event), label bins
+  if(!h) return;
+
+  // Run14 AuAu 200 GeV
+  if(runFlag == StJetFrameworkPicoBase::Run14_AuAu200) {
+    if(mask & kHT1)     h->Fill(2);  // HT1
+    if(mask & kHT2)     h->Fill(3);  // HT2
+    if(mask & kHT3)     h->Fill(4);  // HT3
+    if(mask & kMB)      h->Fill(5);  // MB
+    if(mask & kCentral5) h->Fill(7); // Central-5
+    if(mask & kCentral) h->Fill(8);  // Central & Central-mon
+    if(mask & kMB5)     h->Fill(10); // VPDMB-5
+    if(mask & kMB30)    h->Fill(11); // VPDMB-30
+
+    // label bins of the analysis trigger selection summary
+    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
+    h->GetXaxis()->SetBinLabel(2, "BHT1*VPDMB-30");
+    h->GetXaxis()->SetBinLabel(3, "BHT2*VPDMB-30");
+    h->GetXaxis()->SetBinLabel(4, "BHT3");
+    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-nobsmd");
+    h->GetXaxis()->SetBinLabel(6, "");
+    h->GetXaxis()->SetBinLabel(7, "Central-5");
+    h->GetXaxis()->SetBinLabel(8, "Central or Central-mon");
+    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
+    h->GetXaxis()->SetBinLabel(11, "VPDMB-30");
+  }
+
+  // Run16 AuAu
+  if(runFlag == StJetFrameworkPicoBase::Run16_AuAu200) {
+    h->Fill(1);                      // kAny
+    if(mask & kHT1)     h->Fill(2);  // HT1
+    if(mask & kHT2)     h->Fill(3);  // HT2
+    if(mask & kHT3)     h->Fill(4);  // HT3
+    if(mask & kMB)      h->Fill(5);  // MB
+    if(mask & kCentral) h->Fill(7);  // Central-5 & Central-novtx
+    if(mask & kMB5)     h->Fill(10); // VPDMB-5
+    if(mask & kMB10)    h->Fill(11); // VPDMB-10
+
+    // label bins of the analysis trigger selection summary
+    h->GetXaxis()->SetBinLabel(1, "un-identified trigger");
+    h->GetXaxis()->SetBinLabel(2, "BHT1");
+    h->GetXaxis()->SetBinLabel(3, "BHT2");
+    h->GetXaxis()->SetBinLabel(4, "BHT3");
+    h->GetXaxis()->SetBinLabel(5, "VPDMB-5-p-sst");
+    h->GetXaxis()->SetBinLabel(6, "");
+    h->GetXaxis()->SetBinLabel(7, "Central");
+    h->GetXaxis()->SetBinLabel(8, "");
+    h->GetXaxis()->SetBinLabel(10, "VPDMB-5");
+    h->GetXaxis()->SetBinLabel(11, "VPDMB-10");
+  }
+
+  // set x-axis labels vertically
+  h->LabelsOption("v");
+}
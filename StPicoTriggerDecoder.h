@@ -0,0 +1,121 @@
+#ifndef STPICOTRIGGERDECODER_H
+#define STPICOTRIGGERDECODER_H
+
+// $Id$
+//
+// Process-wide trigger decoder shared by all makers.
+//
+// The MB and HT trigger ID's of a run flag are compiled once into a sorted
+// table of (trigger ID, trigger bits). Each event is then decoded once into
+// a single trigger bitmask: the fired trigger ID's of the event are looked up
+// in the table (binary search), and the fired EMC triggers (StPicoEmcTrigger)
+// are added together with the per-tower HT trigger bits.
+//
+// All makers decoding the same event share the result: CheckForMB() and
+// CheckForHT() only test a bit, instead of rebuilding the trigger ID arrays
+// and scanning them with StPicoEvent::isTrigger() for every maker.
+//
+// usage (once per event, from Make()):
+//   StPicoTriggerDecoder *mTrigger = StPicoTriggerDecoder::Instance();
+//   UInt_t mask = mTrigger->Decode(mPicoDst, fRunFlag);      // cached per event
+//   if(mask & StPicoTriggerDecoder::GetMBBit(fRunFlag, fMBEventType)) ...
+//   if(mTrigger->IsTowerHT1(towerID)) ...
+
+#include "Rtypes.h"
+
+#include <utility>
+#include <vector>
+
+class StPicoDst;
+class TH1;
+
+class StPicoTriggerDecoder {
+ public:
+  // number of BEMC towers: ID's run from 1 - 4800
+  enum { kNTowers = 4800 };
+
+  // event trigger bits
+  enum ETriggerBit {
+    // from trigger ID's of run flag
+    kMB      = 1<<0,   // main MB trigger of run
+    kMB5     = 1<<1,   // VPDMB-5
+    kMB10    = 1<<2,   // VPDMB-10
+    kMB30    = 1<<3,   // VPDMB-30
+    kHT1     = 1<<4,   // BHT1
+    kHT2     = 1<<5,   // BHT2
+    kHT3     = 1<<6,   // BHT3
+    kCentral5= 1<<7,   // Central-5 (Run14)
+    kCentral = 1<<15,  // Central, Central-mon / Central-novtx
+    // from fired EMC triggers
+    kEmcHT0  = 1<<8,
+    kEmcHT1  = 1<<9,
+    kEmcHT2  = 1<<10,
+    kEmcHT3  = 1<<11,
+    kEmcJP0  = 1<<12,
+    kEmcJP1  = 1<<13,
+    kEmcJP2  = 1<<14
+  };
+
+  // per-tower fired HT trigger bits
+  enum ETowerTriggerBit {
+    kTowerHT1 = 1<<0,
+    kTowerHT2 = 1<<1,
+    kTowerHT3 = 1<<2
+  };
+
+  // access to the single shared instance
+  static StPicoTriggerDecoder* Instance();
+
+  // decode event: returns trigger bitmask, only decoded once per (run, event, run flag)
+  UInt_t                 Decode(StPicoDst *picoDst, Int_t runFlag);
+
+  // trigger bit of StJetFrameworkPicoBase MB type (fMBFlagEnum) and HT type (fEmcTriggerFlagEnum)
+  // for run flag: 0 if not defined for run flag
+  static UInt_t          GetMBBit(Int_t runFlag, Int_t type);
+  static UInt_t          GetHTBit(Int_t runFlag, Int_t type);
+  static UInt_t          GetEmcTriggerBit(Int_t type);      // fired EMC trigger type (fEmcTriggerFlagEnum)
+
+  // event trigger QA histogram (fHistEventSelectionQA of the makers) from the trigger bits of the event
+  static void            FillEventTriggerQA(TH1 *h, UInt_t mask, Int_t runFlag);
+
+  // current event
+  UInt_t                 GetTriggerMask() const          { return fTriggerMask; }
+  Bool_t                 HasTrigger(UInt_t bits) const    { return (fTriggerMask & bits) != 0; }
+  Bool_t                 HasEmcTrigger(Int_t type) const  { UInt_t bit = GetEmcTriggerBit(type); return (!bit) || HasTrigger(bit); }
+  Int_t                  GetRunFlag() const               { return fRunFlag; }
+  Int_t                  GetNumberOfFiredTowers() const   { return (Int_t)fFiredTowers.size(); }
+  Int_t                  GetFiredTowerID(Int_t i) const   { return fFiredTowers[i]; }
+  UChar_t                GetTowerTriggerBits(Int_t towerID) const { return ((towerID > 0) && (towerID <= kNTowers)) ? fTowerTrigger[towerID] : 0; }
+  Bool_t                 IsTowerHT1(Int_t towerID) const  { return (GetTowerTriggerBits(towerID) & kTowerHT1) != 0; }
+  Bool_t                 IsTowerHT2(Int_t towerID) const  { return (GetTowerTriggerBits(towerID) & kTowerHT2) != 0; }
+  Bool_t                 IsTowerHT3(Int_t towerID) const  { return (GetTowerTriggerBits(towerID) & kTowerHT3) != 0; }
+
+ protected:
+  StPicoTriggerDecoder();
+  virtual ~StPicoTriggerDecoder();
+
+  void                   BuildTriggerTable(Int_t runFlag);  // compile trigger ID's of run flag
+  void                   AddTriggers(const Int_t *ids, Int_t n, UInt_t bit);
+  UInt_t                 LookupTrigger(Int_t triggerID) const;
+
+  // trigger table of run flag: sorted by trigger ID
+  std::vector<std::pair<Int_t, UInt_t> > fTriggerTable; // (trigger ID, trigger bits)
+  Int_t                  fTableRunFlag;                 // run flag of trigger table, -1 = none
+
+  // current event
+  Int_t                  fRunFlag;                      // run flag of decoded event
+  Int_t                  fRunId;                        // run ID of decoded event
+  Int_t                  fEventId;                      // event ID of decoded event
+  UInt_t                 fTriggerMask;                  // trigger bits of decoded event
+  UChar_t                fTowerTrigger[kNTowers+1];     // fired HT trigger bits (index = towerID)
+  std::vector<Int_t>     fFiredTowers;                  // towers with fired HT triggers
+
+  static StPicoTriggerDecoder *fgInstance;              //!shared instance
+
+ private:
+  StPicoTriggerDecoder(const StPicoTriggerDecoder&);            // not implemented
+  StPicoTriggerDecoder &operator=(const StPicoTriggerDecoder&); // not implemented
+
+  ClassDef(StPicoTriggerDecoder, 0) // run-scoped trigger decoder
+};
+#endif
@@ -1,5 +1,7 @@
 // $Id$
 // Calculation of rho from a collection of jets.
+// rho, the in-event sigma and rho_m are found in one pass over the jets
+// (selection based median / quantile, leading jets excluded by partial selection).
 // If scale function is given the scaled rho will be exported
 // with the name as "fOutRhoName".Apppend("_Scaled").
 //
@@ -12,6 +14,9 @@
 #include "TH2.h"
 #include "TH2F.h"
 
+#include <algorithm>
+#include <functional>
+
 class TH2;
 class TH2F;
 
@@ -19,6 +24,7 @@ class TH2F;
 #include "StJet.h"
 #include "StRhoParameter.h"
 #include "StJetMakerTask.h"
+#include "StPicoEventHeaderMaker.h"
 
 // STAR includes
 #include "StRoot/StPicoDstMaker/StPicoDst.h"
@@ -81,6 +87,13 @@ Int_t StRho::Init()
   fJets = new TClonesArray("StJet");
   //fJets->SetName(fJetsName);      
 
+  // reusable buffers: sized for a central event, grown when needed
+  fJetPtBuf.resize(1000);
+  fJetAreaBuf.resize(1000);
+  fRhoBuf.resize(1000);
+  fRhoMBuf.resize(1000);
+  fSelBuf.reserve(1000);
+
   return kStOk;
 }
 
@@ -148,6 +161,12 @@ Int_t StRho::Make()
 {
   // Run the analysis - for each event
 
+  // initialize Rho, sigma, rho_m and scaled Rho: rejected events do not keep the previous event's values
+  fOutRho->SetVal(0);
+  fOutRhoSigma->SetVal(0);
+  fOutRhoM->SetVal(0);
+  if(fOutRhoScaled) fOutRhoScaled->SetVal(0);
+
   // get PicoDstMaker
   mPicoDstMaker = static_cast<StPicoDstMaker*>(GetMaker("picoDst"));
   if(!mPicoDstMaker) {
@@ -169,13 +188,18 @@ Int_t StRho::Make()
     return kStWarn;
   }
 
+  // shared event header (if set): event rejected for the whole chain
+  if(!InitEventHeader()) return kStWarn;
+  if(fEventHeader && !fEventHeader->IsEventSelected()) return kStOk;
+
   // get vertex 3 vector and declare variables
   StThreeVectorF mVertex = mPicoEvent->primaryVertex();
   double zVtx = mVertex.z();
 
   // z-vertex cut
   // per the Aj analysis (-40, 40) for reference
-  if((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut)) return kStOk;
+  // (done once per event by the shared event header when set)
+  if(!fEventHeader && ((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut))) return kStOk;
 
   // get JetMaker
   JetMaker = static_cast<StJetMakerTask*>(GetMaker(fJetMakerName));
@@ -192,17 +216,10 @@ Int_t StRho::Make()
   }
   if(!fJets) return kStWarn;
 
-  // get run # for centrality correction
-  Int_t RunId = mPicoEvent->runId();
-  Float_t fBBCCoincidenceRate = mPicoEvent->BBCx();
-
-  // Centrality correction calculation
-  // 10 14 21 29 40 54 71 92 116 145 179 218 263 315 373 441  // RUN 14 AuAu binning
-  int grefMult = mPicoEvent->grefMult();
-  grefmultCorr->init(RunId);
-  grefmultCorr->initEvent(grefMult, zVtx, fBBCCoincidenceRate);
-  Double_t refCorr2 = grefmultCorr->getRefMultCorr(grefMult, zVtx, fBBCCoincidenceRate, 2); 
-  Int_t cent16 = grefmultCorr->getCentralityBin16();
+  // Centrality correction calculation: from shared event header when set
+  Int_t cent16, cent9;
+  Double_t refCorr2, eventWeight;
+  GetEventCentrality(zVtx, cent16, cent9, refCorr2, eventWeight);
   Int_t centbin = GetCentBin(cent16, 16);
   if(cent16 == -1) return kStOk; // maybe kStOk; - this is for lowest multiplicity events 80%+ centrality, cut on them
 
@@ -215,61 +232,20 @@ Int_t StRho::Make()
 
   // ============================ end of CENTRALITY ============================== //
 
-  // initialize Rho and scaled Rho
-  fOutRho->SetVal(0);
-  if(fOutRhoScaled) fOutRhoScaled->SetVal(0);
-
-  // get number of jets, initialize arrays
-  const Int_t Njets   = fJets->GetEntries();
-  Int_t maxJetIds[]   = {-1, -1};
-  Float_t maxJetPts[] = { 0,  0};
-
-  // exclude leading jets
-  if(fNExclLeadJets > 0) {
-    // loop over jets
-    for(Int_t ij = 0; ij < Njets; ++ij) {
-      StJet *jet = static_cast<StJet*>(fJets->At(ij));
-      if(!jet) { continue; } 
-
-      // NEED TO CHECK DEFAULTS // FIXME
-      //if (!AcceptJet(jet)) continue;
-      // get some jet parameters
-      double jetPt = jet->Pt();
-      // some threshold cuts for tests
-      if(jetPt < 0) continue;
-
-      // get ID and pt of the leading and sub-leading jet   
-      if(jetPt > maxJetPts[0]) {
-	maxJetPts[1] = maxJetPts[0];
-	maxJetIds[1] = maxJetIds[0];
-	maxJetPts[0] = jetPt;
-	maxJetIds[0] = ij;
-      } else if (jetPt > maxJetPts[1]) {
-	maxJetPts[1] = jetPt;
-	maxJetIds[1] = ij;
-      }
-    }
-
-    // only set to remove leading jet 
-    if(fNExclLeadJets < 2) {
-      maxJetIds[1] = -1;
-      maxJetPts[1] = 0;
-    }
+  // one pass over the jets: pt, pt/area and (mt - pt)/area into the reusable buffers
+  const Int_t Njets = fJets->GetEntries();
+  if((Int_t)fJetPtBuf.size() < Njets) {
+    fJetPtBuf.resize(Njets);
+    fJetAreaBuf.resize(Njets);
+    fRhoBuf.resize(Njets);
+    fRhoMBuf.resize(Njets);
   }
 
-  static Double_t rhovec[999];
   Int_t NjetAcc = 0;
-
-  // push all jets within selected acceptance into stack
   for(Int_t iJets = 0; iJets < Njets; ++iJets) {
-
-    // excluding lead jets
-    if(iJets == maxJetIds[0] || iJets == maxJetIds[1])
-      continue;
-
     // pointer to jet
     StJet *jet = static_cast<StJet*>(fJets->At(iJets));
-    if(!jet) { continue; } 
+    if(!jet) { continue; }
 
     // NEED TO CHECK FOR DEFAULTS - cuts are done at the jet finder level
     //if(!AcceptJet(jet)) continue; //FIXME
@@ -278,16 +254,62 @@ Int_t StRho::Make()
     double jetArea = jet->Area();
     // some threshold cuts for tests
     if(jetPt < 0) continue;
- 
-    rhovec[NjetAcc] = jetPt / jetArea;
+    if(jetArea <= 0) continue;
+
+    fJetPtBuf[NjetAcc]   = jetPt;
+    fJetAreaBuf[NjetAcc] = jetArea;
+    fRhoBuf[NjetAcc]     = jetPt / jetArea;
+    fRhoMBuf[NjetAcc]    = GetJetRhoM(jet);
     ++NjetAcc;
   }
 
-  // when we have accepted Jets - calculate and set rho
+  // exclude leading jets: partial selection of the fNExclLeadJets-th highest pt,
+  // then drop the jets above it (and as many at it as still needed)
+  Int_t nExcl = TMath::Min((Int_t)fNExclLeadJets, NjetAcc);
+  if(nExcl > 0) {
+    fSelBuf.assign(fJetPtBuf.begin(), fJetPtBuf.begin() + NjetAcc);
+    std::nth_element(fSelBuf.begin(), fSelBuf.begin() + nExcl - 1, fSelBuf.end(), std::greater<Double_t>());
+    const Double_t ptCut = fSelBuf[nExcl - 1];
+
+    Int_t nAbove = 0;
+    for(Int_t i = 0; i < NjetAcc; i++) { if(fJetPtBuf[i] > ptCut) nAbove++; }
+    Int_t nAtCut = nExcl - nAbove;
+
+    // compact kept jets to the front of the buffers
+    Int_t nKept = 0;
+    for(Int_t i = 0; i < NjetAcc; i++) {
+      if(fJetPtBuf[i] > ptCut) continue;
+      if(fJetPtBuf[i] == ptCut && nAtCut > 0) { nAtCut--; continue; }
+      fJetAreaBuf[nKept] = fJetAreaBuf[i];
+      fRhoBuf[nKept]     = fRhoBuf[i];
+      fRhoMBuf[nKept]    = fRhoMBuf[i];
+      nKept++;
+    }
+    NjetAcc = nKept;
+  }
+
+  // when we have accepted Jets - calculate and set rho, sigma and rho_m
   if(NjetAcc > 0) {
-    //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t meanArea = 0.;
+    for(Int_t i = 0; i < NjetAcc; i++) meanArea += fJetAreaBuf[i];
+    meanArea /= NjetAcc;
+
+    // median of pt/area, lower 1 sigma quantile from the part below the median
+    Double_t *rhoBuf = &fRhoBuf[0];
+    Double_t rho = SelectMedian(rhoBuf, NjetAcc);
+    Int_t iLow = TMath::Nint(0.5*(1.0 - 0.6827)*(NjetAcc - 1));
+    Int_t iMid = NjetAcc/2;
+    Double_t rhoLow = rho;
+    if(iLow < iMid) {
+      std::nth_element(rhoBuf, rhoBuf + iLow, rhoBuf + iMid);
+      rhoLow = rhoBuf[iLow];
+    }
+    Double_t sigma = (rho - rhoLow) * TMath::Sqrt(meanArea);
+    Double_t rhom = SelectMedian(&fRhoMBuf[0], NjetAcc);
+
     fOutRho->SetVal(rho);
+    fOutRhoSigma->SetVal(sigma);
+    fOutRhoM->SetVal(rhom);
 
     // fill histo
     fHistMultvsRho->Fill(multiplicity, rho);
@@ -300,7 +322,47 @@ Int_t StRho::Make()
     }
   }
 
-  StRhoBase::FillHistograms();
-
   return kStOk;
-} 
+}
+
+//________________________________________________________________________
+Double_t StRho::GetJetRhoM(const StJet *jet)
+{
+  // mass density of a jet: sum over the real (non-ghost) constituents of
+  // (mt - pt) = sqrt(pt^2 + m^2) - pt, divided by the jet area.
+  // The kt jets are clustered with BIpt2_scheme and are massless themselves,
+  // the constituents keep their mass (pion mass for tracks).
+  // Jets without constituent table (read back from file): jet mass
+  if(!jet || jet->Area() <= 0) return 0.;
+
+  const Int_t nconst = jet->GetNumberOfJetConstituents();
+  if(nconst == 0) {
+    Double_t jetPt = jet->Pt(), jetM = jet->M();
+    return (TMath::Sqrt(jetPt*jetPt + jetM*jetM) - jetPt) / jet->Area();
+  }
+
+  Double_t mtSum = 0.;
+  for(Int_t ic = 0; ic < nconst; ic++) {
+    const fastjet::PseudoJet &c = jet->JetConstituentAt(ic);
+    if(c.user_index() == -1) continue; // ghost
+    Double_t m2 = TMath::Max(c.m2(), 0.);
+    mtSum += TMath::Sqrt(c.pt2() + m2) - c.pt();
+  }
+
+  return mtSum / jet->Area();
+}
+
+//________________________________________________________________________
+Double_t StRho::SelectMedian(Double_t *v, Int_t n)
+{
+  // median by selection (linear time), same convention as TMath::Median:
+  // mean of the two central values for even n - reorders v
+  if(n <= 0) return 0.;
+
+  Int_t mid = n/2;
+  std::nth_element(v, v + mid, v + n);
+  Double_t med = v[mid];
+  if(n % 2 == 0) med = 0.5*(med + *std::max_element(v, v + mid));
+
+  return med;
+}
@@ -8,6 +8,7 @@
 
 // additional includes
 #include "StMaker.h"
+#include <vector>
 
 // ROOT classes
 class TH2;
@@ -16,6 +17,7 @@ class TClonesArray;
 
 // STAR classes
 class StMaker;
+class StJet;
 
 //class StRho : virtual public StMaker, virtual public StRhoBase { //FIXME
 class StRho : public StRhoBase {
@@ -37,11 +39,22 @@ class StRho : public StRhoBase {
 
   void    SetExcludeLeadJets(UInt_t n)    { fNExclLeadJets = n    ; }
 
+  static Double_t   GetJetRhoM(const StJet *jet);         // sum of (mt - pt) of the jet constituents / jet area
+
  protected:
+  static Double_t   SelectMedian(Double_t *v, Int_t n);   // median by selection, reorders v
+
   UInt_t            fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
 
   TClonesArray     *fJets;//!jet collection
 
+  // per-event buffers, grown to the largest jet multiplicity and reused
+  std::vector<Double_t> fJetPtBuf;                  //! jet pt
+  std::vector<Double_t> fJetAreaBuf;                //! jet area
+  std::vector<Double_t> fRhoBuf;                    //! jet pt/area
+  std::vector<Double_t> fRhoMBuf;                   //! jet (mt - pt)/area
+  std::vector<Double_t> fSelBuf;                    //! selection of leading jets
+
  private:
   TH2F             *fHistMultvsRho;//!
 
@@ -42,6 +42,8 @@ StRhoBase::StRhoBase() :
   StJetFrameworkPicoBase(),
   fOutRhoName(),
   fOutRhoScaledName(),
+  fOutRhoSigmaName(),
+  fOutRhoMName(),
   fCompareRhoName(),
   fCompareRhoScaledName(),
   fRhoFunction(0),
@@ -51,6 +53,8 @@ StRhoBase::StRhoBase() :
   fIsAuAu(kTRUE),
   fOutRho(0),
   fOutRhoScaled(0),
+  fOutRhoSigma(0),
+  fOutRhoM(0),
   fCompareRho(0),
   fCompareRhoScaled(0),
   fHistJetPtvsCent(0),
@@ -91,6 +95,8 @@ StRhoBase::StRhoBase(const char *name, Bool_t histo, const char *outName, const
   StJetFrameworkPicoBase(name),
   fOutRhoName(),
   fOutRhoScaledName(),
+  fOutRhoSigmaName(),
+  fOutRhoMName(),
   fCompareRhoName(),
   fCompareRhoScaledName(),
   fRhoFunction(0),
@@ -100,6 +106,8 @@ StRhoBase::StRhoBase(const char *name, Bool_t histo, const char *outName, const
   fIsAuAu(kTRUE),
   fOutRho(0),
   fOutRhoScaled(0),
+  fOutRhoSigma(0),
+  fOutRhoM(0),
   fCompareRho(0),
   fCompareRhoScaled(0),
   fHistJetPtvsCent(0),
@@ -186,6 +194,8 @@ Int_t StRhoBase::Init()
   // Init the analysis.
   if(!fOutRho) { fOutRho = new StRhoParameter(fOutRhoName, 0);  }
   if(fScaleFunction && !fOutRhoScaled) { fOutRhoScaled = new StRhoParameter(fOutRhoScaledName, 0); }
+  if(!fOutRhoSigma) { fOutRhoSigma = new StRhoParameter(fOutRhoSigmaName, 0); }
+  if(!fOutRhoM) { fOutRhoM = new StRhoParameter(fOutRhoMName, 0); }
 
 /*
   if(!fCompareRhoName.IsNull() && !fCompareRho) {
@@ -48,7 +48,9 @@ class StRhoBase : public StJetFrameworkPicoBase {
   void                   SetEventZVtxRange(Double_t zmi, Double_t zma)         { fEventZVtxMinCut = zmi; fEventZVtxMaxCut = zma;     }
 
   void                   SetOutRhoName(const char *name)                       { fOutRhoName           = name    ;
-                                                                                 fOutRhoScaledName     = Form("%s_Scaled",name);     }
+                                                                                 fOutRhoScaledName     = Form("%s_Scaled",name);
+                                                                                 fOutRhoSigmaName      = Form("%s_Sigma",name);
+                                                                                 fOutRhoMName          = Form("%s_M",name);          }
   void                   SetCompareRhoName(const char *name)                   { fCompareRhoName       = name    ;                   }
   void                   SetCompareRhoScaledName(const char *name)             { fCompareRhoScaledName = name    ;                   }
   void                   SetScaleFunction(TF1* sf)                             { fScaleFunction        = sf      ;                   }
@@ -63,6 +65,8 @@ class StRhoBase : public StJetFrameworkPicoBase {
 
   StRhoParameter* GetRho()                        { return fOutRho; }
   StRhoParameter* GetRhoScaled()                  { return fOutRhoScaled; }
+  StRhoParameter* GetRhoSigma()                   { return fOutRhoSigma; }   // in-event fluctuation of rho (per unit area)
+  StRhoParameter* GetRhoM()                       { return fOutRhoM; }       // mass density rho_m
 //  double GetRhoVal() {return GetRho()->GetVal(); }
 //  Double_t        GetRhoVal()            const    {if (fRho) return fRho->GetVal(); else return 0;}
 
@@ -74,6 +78,8 @@ class StRhoBase : public StJetFrameworkPicoBase {
 
   TString                fOutRhoName;                    // name of output rho object
   TString                fOutRhoScaledName;              // name of output scaled rho object
+  TString                fOutRhoSigmaName;               // name of output sigma rho object
+  TString                fOutRhoMName;                   // name of output rho_m object
   TString                fCompareRhoName;                // name of rho object to compare
   TString                fCompareRhoScaledName;          // name of scaled rho object to compare
   TF1                   *fRhoFunction;                   // pre-computed rho as a function of centrality
@@ -84,6 +90,8 @@ class StRhoBase : public StJetFrameworkPicoBase {
   
   StRhoParameter        *fOutRho;                        //!output rho object
   StRhoParameter        *fOutRhoScaled;                  //!output scaled rho object
+  StRhoParameter        *fOutRhoSigma;                   //!output sigma rho object
+  StRhoParameter        *fOutRhoM;                       //!output rho_m object
   StRhoParameter        *fCompareRho;                    //!rho object to compare
   StRhoParameter        *fCompareRhoScaled;              //!scaled rho object to compare
 
@@ -0,0 +1,416 @@
+// $Id$
+// Calculation of rho, sigma and rho_m from a grid-median estimator
+// on the accepted particles (no background jet clustering).
+// Tracks are taken through the shared track table when set, towers from
+// the corrected tower table of the jet maker.
+//
+
+#include "StRhoGridMedian.h"
+
+// ROOT includes
+#include <TClonesArray.h>
+#include <TMath.h>
+#include <TVector2.h>
+#include <TFile.h>
+#include "TH2F.h"
+
+#include <algorithm>
+#include <functional>
+
+// JetFramework includes
+#include "StJet.h"
+#include "StRhoParameter.h"
+#include "StJetMakerTask.h"
+#include "StCorrectedTowerTable.h"
+#include "StPicoEventHeaderMaker.h"
+#include "StPicoConstants.h"
+
+// STAR includes
+#include "StRoot/StPicoDstMaker/StPicoDst.h"
+#include "StRoot/StPicoDstMaker/StPicoDstMaker.h"
+#include "StRoot/StPicoEvent/StPicoEvent.h"
+#include "StRoot/StPicoEvent/StPicoTrack.h"
+
+ClassImp(StRhoGridMedian)
+
+//________________________________________________________________________
+StRhoGridMedian::StRhoGridMedian() :
+  StRhoBase(""),
+  fGridYMax(1.0),
+  fGridSpacing(0.55),
+  fUseTowers(kFALSE),
+  fNExclLeadJets(0),
+  fExcludeJetRadius(0.4),
+  fNCellsEta(0),
+  fNCellsPhi(0),
+  fCellDeta(0.),
+  fCellDphi(0.),
+  fCellArea(0.),
+  fNCellsUsed(0),
+  fCellPt(),
+  fCellMt(),
+  fCellExcluded(),
+  fCellRho(),
+  fCellRhoM(),
+  fHistMultvsRho(0x0),
+  fHistRhovsRhoSigma(0x0),
+  fHistRhovsRhoM(0x0)
+{
+  mOutName = "";
+  fJetMakerName = "";
+  fRhoMakerName = "";
+}
+
+//________________________________________________________________________
+StRhoGridMedian::StRhoGridMedian(const char *name, Bool_t histo, const char *outName, const char *jetMakerName) :
+  StRhoBase(name, histo, outName, jetMakerName),
+  fGridYMax(1.0),
+  fGridSpacing(0.55),
+  fUseTowers(kFALSE),
+  fNExclLeadJets(0),
+  fExcludeJetRadius(0.4),
+  fNCellsEta(0),
+  fNCellsPhi(0),
+  fCellDeta(0.),
+  fCellDphi(0.),
+  fCellArea(0.),
+  fNCellsUsed(0),
+  fCellPt(),
+  fCellMt(),
+  fCellExcluded(),
+  fCellRho(),
+  fCellRhoM(),
+  fHistMultvsRho(0x0),
+  fHistRhovsRhoSigma(0x0),
+  fHistRhovsRhoM(0x0)
+{
+  // Constructor.
+  mOutName = outName;
+  fJetMakerName = jetMakerName;
+  fRhoMakerName = name;
+
+  if (!name) return;
+  SetName(name);
+}
+
+//________________________________________________________________________
+StRhoGridMedian::~StRhoGridMedian()
+{ /*  */
+  // destructor
+  if(fHistMultvsRho)     delete fHistMultvsRho;
+  if(fHistRhovsRhoSigma) delete fHistRhovsRhoSigma;
+  if(fHistRhovsRhoM)     delete fHistRhovsRhoM;
+}
+
+//________________________________________________________________________
+Int_t StRhoGridMedian::Init()
+{
+  // base class creates the output rho objects and centrality correction
+  StRhoBase::Init();
+
+  // no background jets: the jet histograms of StRhoBase are not filled
+  delete fJets;
+  fJets = 0x0;
+
+  DeclareHistograms();
+
+  // grid is fixed for the run
+  SetupGrid();
+
+  return kStOk;
+}
+
+//________________________________________________________________________
+Int_t StRhoGridMedian::Finish() {
+  //  Write histos to file and close it.
+  if(mOutName!="") {
+    TFile *fout = new TFile(mOutName.Data(), "UPDATE");
+    fout->cd();
+    fout->mkdir(fRhoMakerName);
+    fout->cd(fRhoMakerName);
+    WriteHistograms();
+    fout->cd();
+    fout->Write();
+    fout->Close();
+  }
+
+  return kStOK;
+}
+
+//________________________________________________________________________
+void StRhoGridMedian::DeclareHistograms() {
+    // declare histograms
+    delete fHistMultvsRho;
+    delete fHistRhovsRhoSigma;
+    delete fHistRhovsRhoM;
+
+    fHistMultvsRho = new TH2F("fHistMultvsRho", "fHistMultvsRho", 160, 0., 800., 100, 0., 100.);
+    fHistMultvsRho->GetXaxis()->SetTitle("Charged track multiplicity");
+    fHistMultvsRho->GetYaxis()->SetTitle("#rho (GeV/c)/A");
+
+    fHistRhovsRhoSigma = new TH2F("fHistRhovsRhoSigma", "fHistRhovsRhoSigma", 100, 0., 100., 100, 0., 50.);
+    fHistRhovsRhoSigma->GetXaxis()->SetTitle("#rho (GeV/c)/A");
+    fHistRhovsRhoSigma->GetYaxis()->SetTitle("#sigma_{#rho} (GeV/c)/#sqrt{A}");
+
+    fHistRhovsRhoM = new TH2F("fHistRhovsRhoM", "fHistRhovsRhoM", 100, 0., 100., 100, 0., 10.);
+    fHistRhovsRhoM->GetXaxis()->SetTitle("#rho (GeV/c)/A");
+    fHistRhovsRhoM->GetYaxis()->SetTitle("#rho_{m} (GeV/c^{2})/A");
+}
+
+//________________________________________________________________________
+void StRhoGridMedian::WriteHistograms() {
+  // write histograms
+  fHistMultvsRho->Write();
+  fHistRhovsRhoSigma->Write();
+  fHistRhovsRhoM->Write();
+}
+
+//________________________________________________________________________
+void StRhoGridMedian::Clear(Option_t *opt) {
+  fNCellsUsed = 0;
+}
+
+//________________________________________________________________________
+void StRhoGridMedian::SetupGrid()
+{
+  // cells of (about) fGridSpacing in eta and phi, covering the acceptance exactly
+  fNCellsEta = TMath::Max(1, TMath::Nint(2.0*fGridYMax / fGridSpacing));
+  fNCellsPhi = TMath::Max(1, TMath::Nint(TMath::TwoPi() / fGridSpacing));
+  fCellDeta  = 2.0*fGridYMax / fNCellsEta;
+  fCellDphi  = TMath::TwoPi() / fNCellsPhi;
+  fCellArea  = fCellDeta * fCellDphi;
+
+  const Int_t nCells = fNCellsEta * fNCellsPhi;
+  fCellPt.assign(nCells, 0.);
+  fCellMt.assign(nCells, 0.);
+  fCellExcluded.assign(nCells, kFALSE);
+  fCellRho.reserve(nCells);
+  fCellRhoM.reserve(nCells);
+
+  if(fDebugLevel > 0) {
+    cout<<"StRhoGridMedian: "<<fNCellsEta<<" x "<<fNCellsPhi<<" cells of area "<<fCellArea<<" in |eta| < "<<fGridYMax<<endl;
+  }
+}
+
+//________________________________________________________________________
+Int_t StRhoGridMedian::GetCell(Double_t eta, Double_t phi) const
+{
+  // cell index for (eta, phi), -1 if outside the grid
+  if(TMath::Abs(eta) >= fGridYMax) return -1;
+
+  Int_t ieta = (Int_t)((eta + fGridYMax) / fCellDeta);
+  if(ieta >= fNCellsEta) ieta = fNCellsEta - 1;
+
+  if(phi < 0.0) phi += TMath::TwoPi();
+  if(phi >= TMath::TwoPi()) phi -= TMath::TwoPi();
+  Int_t iphi = (Int_t)(phi / fCellDphi);
+  if(iphi >= fNCellsPhi) iphi = fNCellsPhi - 1;
+
+  return ieta*fNCellsPhi + iphi;
+}
+
+//________________________________________________________________________
+void StRhoGridMedian::AddToCell(Double_t pt, Double_t eta, Double_t phi, Double_t mass)
+{
+  Int_t icell = GetCell(eta, phi);
+  if(icell < 0) return;
+
+  fCellPt[icell] += pt;
+  if(mass > 0.) fCellMt[icell] += TMath::Sqrt(pt*pt + mass*mass) - pt;
+}
+
+//________________________________________________________________________
+void StRhoGridMedian::ExcludeLeadingJets(TClonesArray *jets)
+{
+  // flag cells with center within fExcludeJetRadius of the leading jets
+  if(!jets || fNExclLeadJets == 0) return;
+
+  // leading jets: partial sort of (pt, index)
+  const Int_t Njets = jets->GetEntries();
+  std::vector<std::pair<Double_t, Int_t> > jetPts;
+  jetPts.reserve(Njets);
+  for(Int_t ij = 0; ij < Njets; ++ij) {
+    StJet *jet = static_cast<StJet*>(jets->At(ij));
+    if(!jet) continue;
+    if(jet->Pt() < 0) continue;
+    jetPts.push_back(std::make_pair(jet->Pt(), ij));
+  }
+  const UInt_t nExcl = TMath::Min((UInt_t)jetPts.size(), fNExclLeadJets);
+  std::partial_sort(jetPts.begin(), jetPts.begin() + nExcl, jetPts.end(), std::greater<std::pair<Double_t, Int_t> >());
+
+  const Double_t R2 = fExcludeJetRadius*fExcludeJetRadius;
+  for(UInt_t i = 0; i < nExcl; i++) {
+    StJet *jet = static_cast<StJet*>(jets->At(jetPts[i].second));
+    for(Int_t ieta = 0; ieta < fNCellsEta; ieta++) {
+      Double_t deta = (-fGridYMax + (ieta + 0.5)*fCellDeta) - jet->Eta();
+      if(deta*deta >= R2) continue;
+
+      for(Int_t iphi = 0; iphi < fNCellsPhi; iphi++) {
+        Double_t dphi = TVector2::Phi_mpi_pi((iphi + 0.5)*fCellDphi - jet->Phi());
+        if(deta*deta + dphi*dphi < R2) fCellExcluded[ieta*fNCellsPhi + iphi] = kTRUE;
+      }
+    }
+  }
+}
+
+//________________________________________________________________________
+Double_t StRhoGridMedian::GetQuantile(const std::vector<Double_t> &sorted, Double_t p)
+{
+  // quantile p of sorted values, linear interpolation between neighbours
+  const Int_t n = sorted.size();
+  if(n == 0) return 0.;
+  if(n == 1) return sorted[0];
+
+  Double_t pos = p * (n - 1);
+  Int_t lo = (Int_t)pos;
+  if(lo >= n - 1) return sorted[n - 1];
+  Double_t frac = pos - lo;
+
+  return (1.0 - frac)*sorted[lo] + frac*sorted[lo + 1];
+}
+
+//________________________________________________________________________
+Int_t StRhoGridMedian::Make()
+{
+  // Run the analysis - for each event
+
+  // get PicoDstMaker
+  mPicoDstMaker = static_cast<StPicoDstMaker*>(GetMaker("picoDst"));
+  if(!mPicoDstMaker) {
+    LOG_WARN << " No PicoDstMaker! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // construct PicoDst object from maker
+  mPicoDst = static_cast<StPicoDst*>(mPicoDstMaker->picoDst());
+  if(!mPicoDst) {
+    LOG_WARN << " No PicoDst! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // create pointer to PicoEvent
+  mPicoEvent = static_cast<StPicoEvent*>(mPicoDst->event());
+  if(!mPicoEvent) {
+    LOG_WARN << " No PicoEvent! Skip! " << endm;
+    return kStWarn;
+  }
+
+  // shared event header (if set): event rejected for the whole chain
+  if(!InitEventHeader()) return kStWarn;
+  if(fEventHeader && !fEventHeader->IsEventSelected()) return kStOk;
+
+  // get event B (magnetic) field and vertex 3-vector, used for track momentum
+  Bfield = mPicoEvent->bField();
+  mVertex = mPicoEvent->primaryVertex();
+  double zVtx = mVertex.z();
+
+  // get shared track table (if set) and register track cuts
+  if(!InitTrackTable()) return kStWarn;
+
+  // z-vertex cut
+  // per the Aj analysis (-40, 40) for reference
+  // (done once per event by the shared event header when set)
+  if(!fEventHeader && ((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut))) return kStOk;
+
+  // get JetMaker: only needed for towers and jet exclusion regions
+  TClonesArray *jets = 0x0;
+  const StCorrectedTowerTable *towers = 0x0;
+  if(fUseTowers || fNExclLeadJets > 0) {
+    JetMaker = static_cast<StJetMakerTask*>(GetMaker(fJetMakerName));
+    const char *fJetMakerNameCh = fJetMakerName;
+    if(!JetMaker) {
+      LOG_WARN << Form(" No %s! Skip! ", fJetMakerNameCh) << endm;
+      return kStWarn;
+    }
+
+    jets = JetMaker->GetJets();
+    if(fNExclLeadJets > 0 && !jets) return kStWarn;
+    if(fUseTowers) towers = JetMaker->GetTowerTable();
+  }
+
+  // Centrality correction calculation: from shared event header when set
+  Int_t cent16, cent9;
+  Double_t refCorr2, eventWeight;
+  GetEventCentrality(zVtx, cent16, cent9, refCorr2, eventWeight);
+  Int_t centbin = GetCentBin(cent16, 16);
+  if(cent16 == -1) return kStOk; // this is for lowest multiplicity events 80%+ centrality, cut on them
+
+  // cut on centrality for analysis before doing anything
+  if(fRequireCentSelection) { if(!SelectAnalysisCentralityBin(centbin, fCentralitySelectionCut)) return kStOk; }
+
+  // get event multiplicity
+  const int multiplicity = refCorr2;
+
+  // ============================ end of CENTRALITY ============================== //
+
+  // initialize outputs
+  fOutRho->SetVal(0);
+  fOutRhoSigma->SetVal(0);
+  fOutRhoM->SetVal(0);
+  if(fOutRhoScaled) fOutRhoScaled->SetVal(0);
+
+  // reset grid
+  std::fill(fCellPt.begin(), fCellPt.end(), 0.);
+  std::fill(fCellMt.begin(), fCellMt.end(), 0.);
+  std::fill(fCellExcluded.begin(), fCellExcluded.end(), kFALSE);
+
+  // accepted tracks: pion mass
+  const Double_t pi0mass = Pico::mMass[0]; // GeV
+  const Int_t ntracks = mPicoDst->numberOfTracks();
+  StThreeVectorF mTrkMom;
+  for(Int_t iTracks = 0; iTracks < ntracks; iTracks++) {
+    if(!GetAcceptedTrack(iTracks, mTrkMom)) continue;
+    AddToCell(mTrkMom.perp(), mTrkMom.pseudoRapidity(), mTrkMom.phi(), pi0mass);
+  }
+
+  // accepted towers: massless
+  if(towers) {
+    for(Int_t irow = 0; irow < towers->GetNumberOfTowers(); irow++) {
+      if(!towers->TestStatusBit(irow, StCorrectedTowerTable::kAccepted)) continue;
+      AddToCell(towers->GetEt(irow), towers->GetEta(irow), towers->GetPhi(irow), 0.);
+    }
+  }
+
+  // jet exclusion regions
+  ExcludeLeadingJets(jets);
+
+  // densities of used cells (empty cells included)
+  fCellRho.clear();
+  fCellRhoM.clear();
+  for(UInt_t icell = 0; icell < fCellPt.size(); icell++) {
+    if(fCellExcluded[icell]) continue;
+    fCellRho.push_back(fCellPt[icell] / fCellArea);
+    fCellRhoM.push_back(fCellMt[icell] / fCellArea);
+  }
+  fNCellsUsed = fCellRho.size();
+  if(fNCellsUsed == 0) return kStOk;
+
+  // median and lower 1 sigma quantile
+  std::sort(fCellRho.begin(), fCellRho.end());
+  std::sort(fCellRhoM.begin(), fCellRhoM.end());
+  Double_t rho = GetQuantile(fCellRho, 0.5);
+  Double_t rhoLow = GetQuantile(fCellRho, 0.5*(1.0 - 0.6827));
+  Double_t sigma = (rho - rhoLow) * TMath::Sqrt(fCellArea);
+  Double_t rhom = GetQuantile(fCellRhoM, 0.5);
+
+  fOutRho->SetVal(rho);
+  fOutRhoSigma->SetVal(sigma);
+  fOutRhoM->SetVal(rhom);
+
+  // if we want scaled Rho from charged -> ch+ne
+  if(fOutRhoScaled) {
+    Double_t rhoScaled = rho * 1.0;
+    fOutRhoScaled->SetVal(rhoScaled);
+  }
+
+  // fill histos
+  fHistMultvsRho->Fill(multiplicity, rho);
+  fHistRhovsRhoSigma->Fill(rho, sigma);
+  fHistRhovsRhoM->Fill(rho, rhom);
+
+  // in-event sigma from the grid estimate for the StRhoBase histograms
+  fInEventSigmaRho = sigma;
+  StRhoBase::FillHistograms();
+
+  return kStOk;
+}
@@ -0,0 +1,94 @@
+#ifndef STRHOGRIDMEDIAN_H
+#define STRHOGRIDMEDIAN_H
+
+// $Id$
+//
+// Rho from a grid-median estimator on the accepted particles.
+//
+// The eta-phi acceptance |eta| < fGridYMax is split into cells of about
+// fGridSpacing x fGridSpacing. Accepted tracks (and optionally the accepted
+// towers of the jet maker's corrected tower table) are summed per cell and
+//   rho    = median over cells of (pt sum / cell area)
+//   sigma  = (median - 15.87% quantile) * sqrt(cell area)
+//   rho_m  = median over cells of (sum(mt - pt) / cell area)
+// are published as StRhoParameter's (GetRho(), GetRhoSigma(), GetRhoM()),
+// so no kt background jet clustering is needed.
+//
+// Cells within fExcludeJetRadius of the fNExclLeadJets leading jets of the
+// jet maker can be excluded from the median.
+
+#include "StRhoBase.h"
+
+// additional includes
+#include "StMaker.h"
+#include <vector>
+
+// ROOT classes
+class TH2F;
+class TClonesArray;
+
+class StRhoGridMedian : public StRhoBase {
+
+ public:
+  StRhoGridMedian();
+  StRhoGridMedian(const char *name, Bool_t histo=kFALSE, const char* outName="", const char* jetMakerName="");
+  virtual ~StRhoGridMedian();
+
+  virtual Int_t Init();
+  virtual Int_t Make();
+  virtual void Clear(Option_t *opt="");
+  virtual Int_t Finish();
+
+  // booking of histograms (optional)
+  void    DeclareHistograms();
+  void    WriteHistograms();
+
+  // grid
+  void    SetGridYMax(Double_t y)            { fGridYMax         = y    ; }
+  void    SetGridSpacing(Double_t s)         { fGridSpacing      = s    ; }
+  void    SetUseTowers(Bool_t t)             { fUseTowers        = t    ; }
+
+  // jet exclusion regions
+  void    SetExcludeLeadJets(UInt_t n)       { fNExclLeadJets    = n    ; }
+  void    SetExcludeJetRadius(Double_t r)    { fExcludeJetRadius = r    ; }
+
+  Int_t   GetNumberOfCells() const           { return fNCellsEta*fNCellsPhi; }
+  Int_t   GetNumberOfUsedCells() const       { return fNCellsUsed; }
+
+ protected:
+  void              SetupGrid();
+  Int_t             GetCell(Double_t eta, Double_t phi) const;
+  void              AddToCell(Double_t pt, Double_t eta, Double_t phi, Double_t mass);
+  void              ExcludeLeadingJets(TClonesArray *jets);
+  static Double_t   GetQuantile(const std::vector<Double_t> &sorted, Double_t p);
+
+  Double_t          fGridYMax;                      // grid extends over |eta| < fGridYMax
+  Double_t          fGridSpacing;                   // requested cell size in eta and phi
+  Bool_t            fUseTowers;                     // add accepted towers of jet maker tower table
+  UInt_t            fNExclLeadJets;                 // number of leading jets to be excluded from the median calculation
+  Double_t          fExcludeJetRadius;              // cells with center within this distance of an excluded jet are not used
+
+  Int_t             fNCellsEta;                     // number of cells in eta
+  Int_t             fNCellsPhi;                     // number of cells in phi
+  Double_t          fCellDeta;                      // cell size in eta
+  Double_t          fCellDphi;                      // cell size in phi
+  Double_t          fCellArea;                      // cell area
+  Int_t             fNCellsUsed;                    //! cells used for the median in current event
+
+  std::vector<Double_t> fCellPt;                    //! pt sum per cell
+  std::vector<Double_t> fCellMt;                    //! (mt - pt) sum per cell
+  std::vector<Bool_t>   fCellExcluded;              //! cell in jet exclusion region
+  std::vector<Double_t> fCellRho;                   //! pt density of used cells
+  std::vector<Double_t> fCellRhoM;                  //! mass density of used cells
+
+ private:
+  TH2F             *fHistMultvsRho;//!
+  TH2F             *fHistRhovsRhoSigma;//!
+  TH2F             *fHistRhovsRhoM;//!
+
+  StRhoGridMedian(const StRhoGridMedian&);             // not implemented
+  StRhoGridMedian& operator=(const StRhoGridMedian&);  // not implemented
+
+  ClassDef(StRhoGridMedian, 1); // grid-median Rho task
+};
+#endif
@@ -21,6 +21,7 @@
 #include "StJet.h"
 #include "StRhoParameter.h"
 #include "StJetMakerTask.h"
+#include "StPicoEventHeaderMaker.h"
 #include "StJetFrameworkPicoBase.h"
 
 // STAR centrality includes
@@ -35,6 +36,8 @@ StRhoSparse::StRhoSparse() :
   fNExclLeadJets(0),
   fCreateHisto(0),
   fRhoCMS(0),
+  fSignalTrackBits(),
+  fSignalTowerBits(),
   fHistOccCorrvsCent(0),
   fHistOccCorrvsMult(0),
   fHistMultvsUnCorrRho(0),
@@ -52,6 +55,8 @@ StRhoSparse::StRhoSparse(const char *name, Bool_t histo, const char *outName, co
   fNExclLeadJets(0),
   fCreateHisto(histo),
   fRhoCMS(0),
+  fSignalTrackBits(),
+  fSignalTowerBits(),
   fHistOccCorrvsCent(0),
   fHistOccCorrvsMult(0),
   fHistMultvsUnCorrRho(0),
@@ -153,6 +158,50 @@ Bool_t StRhoSparse::IsJetOverlapping(StJet* jet1, StJet* jet2) {
   return kFALSE;
 }
 
+//________________________________________________________________________
+Int_t StRhoSparse::FillSignalJetBits(TClonesArray *sigJets)
+{
+  // set one bit per track and tower constituent of the signal jets:
+  // overlap check of a jet is then one bit test per constituent
+  fSignalTrackBits.ResetAllBits();
+  fSignalTowerBits.ResetAllBits();
+  if(!sigJets) return 0;
+
+  Int_t nSignal = 0;
+  const Int_t NjetsSig = sigJets->GetEntries();
+  for(Int_t j = 0; j < NjetsSig; j++) {
+    StJet* signalJet = static_cast<StJet*>(sigJets->At(j));
+    if(!signalJet) continue;
+    if(!IsJetSignal(signalJet)) continue;
+
+    for(Int_t i = 0; i < signalJet->GetNumberOfTracks(); ++i) {
+      Int_t itrk = signalJet->TrackAt(i);
+      if(itrk >= 0) fSignalTrackBits.SetBitNumber(itrk);
+    }
+    for(Int_t i = 0; i < signalJet->GetNumberOfClusters(); ++i) {
+      Int_t itow = signalJet->TowerAt(i);
+      if(itow >= 0) fSignalTowerBits.SetBitNumber(itow);
+    }
+    nSignal++;
+  }
+
+  return nSignal;
+}
+
+//________________________________________________________________________
+Bool_t StRhoSparse::IsJetOverlappingSignal(StJet* jet) const
+{
+  for(Int_t i = 0; i < jet->GetNumberOfTracks(); ++i) {
+    Int_t itrk = jet->TrackAt(i);
+    if(itrk >= 0 && fSignalTrackBits.TestBitNumber(itrk)) return kTRUE;
+  }
+  for(Int_t i = 0; i < jet->GetNumberOfClusters(); ++i) {
+    Int_t itow = jet->TowerAt(i);
+    if(itow >= 0 && fSignalTowerBits.TestBitNumber(itow)) return kTRUE;
+  }
+  return kFALSE;
+}
+
 //________________________________________________________________________
 Bool_t StRhoSparse::IsJetSignal(StJet* jet)
 {
@@ -194,13 +243,18 @@ Int_t StRhoSparse::Make()
     return kStWarn;
   }
 
+  // shared event header (if set): event rejected for the whole chain
+  if(!InitEventHeader()) return kStWarn;
+  if(fEventHeader && !fEventHeader->IsEventSelected()) return kStOk;
+
   // get vertex 3 vector and declare variables
   StThreeVectorF mVertex = mPicoEvent->primaryVertex();
   double zVtx = mVertex.z();
 
   // z-vertex cut
   // per the Aj analysis (-40,40) for reference
-  if((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut)) return kStOk;
+  // (done once per event by the shared event header when set)
+  if(!fEventHeader && ((zVtx < fEventZVtxMinCut) || (zVtx > fEventZVtxMaxCut))) return kStOk;
 
   // get JetMaker of background jets ("JetMakerBG")
   JetMakerBG = static_cast<StJetMakerTask*>(GetMaker(fJetBGMakerName));
@@ -222,18 +276,10 @@ Int_t StRhoSparse::Make()
   const Int_t Njets = fBGJets->GetEntries();
   const Int_t NjetsSig = fJets->GetEntries();
 
-  // get run # for centrality correction
-  Int_t RunId = mPicoEvent->runId();
-  Float_t fBBCCoincidenceRate = mPicoEvent->BBCx();
-  //Float_t fZDCCoincidenceRate = mPicoEvent->ZDCx();
-
-  // Centrality correction calculation
-  // 10 14 21 29 40 54 71 92 116 145 179 218 263 315 373 441  // RUN 14 AuAu binning
-  int grefMult = mPicoEvent->grefMult();
-  grefmultCorr->init(RunId);
-  grefmultCorr->initEvent(grefMult, zVtx, fBBCCoincidenceRate);
-  Double_t refCorr2 = grefmultCorr->getRefMultCorr(grefMult, zVtx, fBBCCoincidenceRate, 2);
-  Int_t cent16 = grefmultCorr->getCentralityBin16();
+  // Centrality correction calculation: from shared event header when set
+  Int_t cent16, cent9;
+  Double_t refCorr2, eventWeight;
+  GetEventCentrality(zVtx, cent16, cent9, refCorr2, eventWeight);
   Int_t centbin = GetCentBin(cent16, 16);
   if(cent16 == -1) return kStOk; // maybe kStOk; - this is for lowest multiplicity events 80%+ centrality, cut on them
   Double_t fCent = centbin * 5.0;
@@ -254,6 +300,9 @@ Int_t StRhoSparse::Make()
   else cbin = -99;
   // ============================ end of CENTRALITY ============================== //
 
+  // constituents of signal jets, for the overlap check of the background jets
+  Int_t NjetsSigAcc = FillSignalJetBits(fJets);
+
   // initialize leading jet arrays
   Int_t maxJetIds[]   = {-1, -1};
   Float_t maxJetPts[] = { 0,  0};
@@ -304,22 +353,7 @@ Int_t StRhoSparse::Make()
     //if (!AcceptJet(jet)) continue;
 
     // Search for overlap with signal jets
-    Bool_t isOverlapping = kFALSE;
-    if(fJets) {
-      for(Int_t j = 0; j < NjetsSig; j++) {
-        // get signal jets
-        StJet* signalJet = static_cast<StJet*>(fJets->At(j)); // GetAcceptJet(j)
-        if(!signalJet) continue;
-        if(!IsJetSignal(signalJet)) continue;
-	  
-        if(IsJetOverlapping(signalJet, jet)) {
-          isOverlapping = kTRUE;
-          break;
-        }
-      }
-    }
-
-    if(isOverlapping) continue;
+    if(NjetsSigAcc > 0 && IsJetOverlappingSignal(jet)) continue;
 
     if(jet->Pt()>0.1){
       rhovec[NjetAcc] = jet->Pt() / jet->Area();
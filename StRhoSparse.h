@@ -3,8 +3,10 @@
 
 // $Id$
 class TH2F;
+class TClonesArray;
 
 #include "StRhoBase.h"
+#include <TBits.h>
 
 class StRhoSparse : public StRhoBase {
 
@@ -28,6 +30,8 @@ class StRhoSparse : public StRhoBase {
   void             SetRhoCMS(Bool_t cms)           { fRhoCMS = cms ; }
   Bool_t           IsJetOverlapping(StJet* jet1, StJet* jet2);
   Bool_t           IsJetSignal(StJet* jet1);
+  Int_t            FillSignalJetBits(TClonesArray *sigJets);   // once per event: constituents of all signal jets
+  Bool_t           IsJetOverlappingSignal(StJet* jet) const;   // overlap with any signal jet, needs FillSignalJetBits()
 
   // set names of makers for global use
   virtual void     SetOutputFileName(const char *on)         { mOutName = on; }
@@ -40,6 +44,9 @@ class StRhoSparse : public StRhoBase {
   Bool_t           fCreateHisto;                   // switch to create histograms
   Bool_t           fRhoCMS;                        // flag to run CMS method
 
+  TBits            fSignalTrackBits;               //! track constituent indices of signal jets
+  TBits            fSignalTowerBits;               //! tower constituent indices of signal jets
+
  private:
   TH2F            *fHistOccCorrvsCent;//!      occupancy correction vs. centrality
   TH2F            *fHistOccCorrvsMult;//!      occupancy correction vs. multiplicity